@@ -5,6 +5,7 @@
 #include "UObject/UObjectGlobals.h"
 #include "UObject/Package.h"
 #include "Utility/Log/ConvaiLogger.h"
+#include "ConvaiDefinitions.h"
 #include "HAL/FileManager.h"
 #include "Modules/ModuleManager.h"
 #include "Interfaces/IPluginManager.h"
@@ -20,6 +21,9 @@ void Convai::StartupModule()
 	ConvaiSettings = NewObject<UConvaiSettings>(GetTransientPackage(), "ConvaiSettings", RF_Standalone);
 	ConvaiSettings->AddToRoot();
 
+	// Build the lipsync curve name tables now rather than on the first decoded packet
+	FConvaiPackedFrames::GetCurveNames(EConvaiCurveSet::Visemes);
+
 	// Register settings
 	if (ISettingsModule *SettingsModule = FModuleManager::GetModulePtr<ISettingsModule>("Settings"))
 	{
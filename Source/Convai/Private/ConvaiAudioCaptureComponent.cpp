@@ -11,10 +11,13 @@ DEFINE_LOG_CATEGORY(ConvaiAudioLog);
 namespace Audio
 {
 	FConvaiAudioCaptureSynth::FConvaiAudioCaptureSynth()
-		: NumSamplesEnqueued(0)
+		: NumOverflowSamples(0)
+		, DiscardUntilPosition(0)
 		, bInitialized(false)
 		, bIsCapturing(false)
 	{
+		// Allocate 2 seconds of stereo audio at 48k SR up front so the capture callback never allocates
+		AudioCaptureData.Init(2 * 2 * 48000);
 	}
 
 	FConvaiAudioCaptureSynth::~FConvaiAudioCaptureSynth()
@@ -74,14 +77,13 @@ namespace Audio
 	{
 		int32 NumSamples = NumChannels * NumFrames;
 
-		FScopeLock Lock(&CaptureCriticalSection);
-
-		if (bIsCapturing)
+		if (bIsCapturing && NumSamples > 0)
 		{
-			// Append the audio memory to the capture data buffer
-			int32 Index = AudioCaptureData.AddUninitialized(NumSamples);
-			float* AudioCaptureDataPtr = AudioCaptureData.GetData();
-			FMemory::Memcpy(&AudioCaptureDataPtr[Index], AudioData, NumSamples * sizeof(float));
+			// Append whole callbacks only so frames stay channel-aligned, count what doesn't fit
+			if (!AudioCaptureData.Push(AudioData, static_cast<uint32>(NumSamples)))
+			{
+				NumOverflowSamples.fetch_add(NumSamples, std::memory_order_relaxed);
+			}
 		}
 	}
 
@@ -102,9 +104,6 @@ namespace Audio
 			};
 #endif
 
-			// Prepare the audio buffer memory for 2 seconds of stereo audio at 48k SR to reduce chance for allocation in callbacks
-			AudioCaptureData.Reserve(2 * 2 * 48000);
-
 			FAudioCaptureDeviceParams Params = FAudioCaptureDeviceParams();
 
 			// Start the stream here to avoid hitching the audio render thread. 
@@ -141,9 +140,6 @@ namespace Audio
 			};
 #endif
 
-			// Prepare the audio buffer memory for 2 seconds of stereo audio at 48k SR to reduce chance for allocation in callbacks
-			AudioCaptureData.Reserve(2 * 2 * 48000);
-
 			FAudioCaptureDeviceParams Params = FAudioCaptureDeviceParams();
 			Params.DeviceIndex = DeviceIndex;
 			// Start the stream here to avoid hitching the audio render thread. 
@@ -173,9 +169,9 @@ namespace Audio
 
 	bool FConvaiAudioCaptureSynth::StartCapturing()
 	{
-		FScopeLock Lock(&CaptureCriticalSection);
-
-		AudioCaptureData.Reset();
+		// The read cursor belongs to the consumer, have it drop whatever is left from the previous capture.
+		// The device callback does not write while bIsCapturing is false, so the write cursor is stable here.
+		DiscardUntilPosition.store(AudioCaptureData.GetWritePosition(), std::memory_order_release);
 
 		check(AudioCapture.IsStreamOpen());
 
@@ -187,7 +183,6 @@ namespace Audio
 	{
 		check(AudioCapture.IsStreamOpen());
 		check(AudioCapture.IsCapturing());
-		FScopeLock Lock(&CaptureCriticalSection);
 		bIsCapturing = false;
 	}
 
@@ -209,8 +204,14 @@ namespace Audio
 
 	int32 FConvaiAudioCaptureSynth::GetNumSamplesEnqueued()
 	{
-		FScopeLock Lock(&CaptureCriticalSection);
-		return AudioCaptureData.Num();
+		const uint64 Start = FMath::Max(AudioCaptureData.GetReadPosition(), DiscardUntilPosition.load(std::memory_order_acquire));
+		const uint64 End = AudioCaptureData.GetWritePosition();
+		return End > Start ? static_cast<int32>(End - Start) : 0;
+	}
+
+	uint64 FConvaiAudioCaptureSynth::GetNumOverflowSamples() const
+	{
+		return NumOverflowSamples.load(std::memory_order_relaxed);
 	}
 
 	FAudioCapture* FConvaiAudioCaptureSynth::GetAudioCapture()
@@ -218,24 +219,41 @@ namespace Audio
 		return &AudioCapture;
 	}
 
+	void FConvaiAudioCaptureSynth::ApplyPendingDiscard()
+	{
+		const uint64 DiscardUntil = DiscardUntilPosition.load(std::memory_order_acquire);
+		const uint64 ReadPosition = AudioCaptureData.GetReadPosition();
+		if (DiscardUntil > ReadPosition)
+		{
+			AudioCaptureData.Discard(static_cast<uint32>(DiscardUntil - ReadPosition));
+		}
+	}
+
 	bool FConvaiAudioCaptureSynth::GetAudioData(TArray<float>& OutAudioData)
 	{
-		FScopeLock Lock(&CaptureCriticalSection);
+		ApplyPendingDiscard();
 
 		int32 CaptureDataSamples = AudioCaptureData.Num();
 		if (CaptureDataSamples > 0)
 		{
 			// Append the capture audio to the output buffer
 			int32 OutIndex = OutAudioData.AddUninitialized(CaptureDataSamples);
-			float* OutDataPtr = OutAudioData.GetData();
-			FMemory::Memcpy(&OutDataPtr[OutIndex], AudioCaptureData.GetData(), CaptureDataSamples * sizeof(float));
-
-			// Reset the capture data buffer since we copied the audio out
-			AudioCaptureData.Reset();
+			AudioCaptureData.Pop(OutAudioData.GetData() + OutIndex, CaptureDataSamples);
 			return true;
 		}
 		return false;
 	}
+
+	int32 FConvaiAudioCaptureSynth::ReadAudioData(float* OutAudio, int32 MaxSamples)
+	{
+		if (!OutAudio || MaxSamples <= 0)
+		{
+			return 0;
+		}
+
+		ApplyPendingDiscard();
+		return static_cast<int32>(AudioCaptureData.Pop(OutAudio, static_cast<uint32>(MaxSamples)));
+	}
 };
 
 UConvaiAudioCaptureComponent::UConvaiAudioCaptureComponent(const FObjectInitializer& ObjectInitializer)
@@ -244,11 +262,9 @@ UConvaiAudioCaptureComponent::UConvaiAudioCaptureComponent(const FObjectInitiali
 	bSuccessfullyInitialized = false;
 	bIsCapturing = false;
 	CapturedAudioDataSamples = 0;
-	ReadSampleIndex = 0;
 	bIsDestroying = false;
 	bIsNotReadyForForFinishDestroy = false;
 	bIsStreamOpen = false;
-	CaptureAudioData.Reserve(2 * 48000 * 5);
 	SelectedDeviceIndex = -1;
 }
 
@@ -375,11 +391,14 @@ Audio::FConvaiAudioCaptureSynth* UConvaiAudioCaptureComponent::GetCaptureSynth()
 	return &CaptureSynth;
 }
 
+int64 UConvaiAudioCaptureComponent::GetCaptureOverflowSamples() const
+{
+	return static_cast<int64>(CaptureSynth.GetNumOverflowSamples());
+}
+
 void UConvaiAudioCaptureComponent::OnBeginGenerate()
 {
 	CapturedAudioDataSamples = 0;
-	ReadSampleIndex = 0;
-	CaptureAudioData.Reset();
 
 	if (!bIsStreamOpen)
 	{
@@ -394,7 +413,6 @@ void UConvaiAudioCaptureComponent::OnBeginGenerate()
 		// Don't allow this component to be destroyed until the stream is closed again
 		bIsNotReadyForForFinishDestroy = true;
 		FramesSinceStarting = 0;
-		ReadSampleIndex = 0;
 	}
 
 }
@@ -424,45 +442,8 @@ int32 UConvaiAudioCaptureComponent::OnGenerateAudio(float* OutAudio, int32 NumSa
 
 	if (CapturedAudioDataSamples > 0 || CaptureSynth.GetNumSamplesEnqueued() > 1024)
 	{
-		// Check if we need to read more audio data from capture synth
-		if (ReadSampleIndex + NumSamples > CaptureAudioData.Num())
-		{
-			// but before we do, copy off the remainder of the capture audio data buffer if there's data in it
-			int32 SamplesLeft = FMath::Max(0, CaptureAudioData.Num() - ReadSampleIndex);
-			if (SamplesLeft > 0)
-			{
-				float* CaptureDataPtr = CaptureAudioData.GetData();
-				if (CaptureDataPtr)
-				{
-					FMemory::Memcpy(OutAudio, &CaptureDataPtr[ReadSampleIndex], SamplesLeft * sizeof(float));
-					// Track samples generated
-					OutputSamplesGenerated += SamplesLeft;
-				}
-			}
-
-			// Get another block of audio from the capture synth
-			CaptureAudioData.Reset();
-			CaptureSynth.GetAudioData(CaptureAudioData);
-
-			// Reset the read sample index since we got a new buffer of audio data
-			ReadSampleIndex = 0;
-		}
-
-		// note it's possible we didn't get any more audio in our last attempt to get it
-		if (CaptureAudioData.Num() > 0)
-		{
-			// Compute samples to copy
-			int32 NumSamplesToCopy = FMath::Min(NumSamples - OutputSamplesGenerated, CaptureAudioData.Num() - ReadSampleIndex);
-
-			float* CaptureDataPtr = CaptureAudioData.GetData();
-			if (CaptureDataPtr)
-			{
-				FMemory::Memcpy(&OutAudio[OutputSamplesGenerated], &CaptureDataPtr[ReadSampleIndex], NumSamplesToCopy * sizeof(float));
-				ReadSampleIndex += NumSamplesToCopy;
-				OutputSamplesGenerated += NumSamplesToCopy;
-			}
-		}
-
+		// Read straight from the capture ring into the output, it's possible we didn't get any more audio
+		OutputSamplesGenerated = CaptureSynth.ReadAudioData(OutAudio, NumSamples);
 		CapturedAudioDataSamples += OutputSamplesGenerated;
 	}
 	else
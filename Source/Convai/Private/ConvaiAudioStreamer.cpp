@@ -16,7 +16,6 @@ DEFINE_LOG_CATEGORY(ConvaiThreadSafeBuffersLog);
 
 UConvaiAudioStreamer::UConvaiAudioStreamer(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
-	, BytesSentToLipSync(0)
 	, bIsPlayingAudio(false)
 {
 	PrimaryComponentTick.bCanEverTick = true;
@@ -139,28 +138,28 @@ void UConvaiAudioStreamer::PlayVoiceData(uint8* VoiceData, uint32 VoiceDataSize,
     }
     else
     {
-        AsyncTask(ENamedThreads::GameThread, [WeakSelf, VoiceDataSize, SampleRate]()
+        EnqueueGameThreadTask([WeakSelf, VoiceDataSize, SampleRate]()
         {
             HandleAudioTimer(WeakSelf, VoiceDataSize, SampleRate);
         });
     }
-    
+
+    if (QueueVoiceData(VoiceData, VoiceDataSize, SampleRate, NumChannels))
+    {
+        MarkTalking();
+    }
+}
+
+bool UConvaiAudioStreamer::QueueVoiceData(uint8* VoiceData, uint32 VoiceDataSize, uint32 SampleRate, uint32 NumChannels)
+{
     if (!IsValid(SoundWaveProcedural))
-        return;
+        return false;
 
     // If configuring audio then queue the audio and return
     if (IsAudioConfiguring)
     {
         // Lock is already held, queue this audio for later processing
-        if (ContainsHeaderData)
-        {
-            // Skip header for the queue
-            PendingAudioBuffer.Append(VoiceData + 44, VoiceDataSize - 44);
-        }
-        else
-        {
-            PendingAudioBuffer.Append(VoiceData, VoiceDataSize);
-        }
+        PendingAudioBuffer.Append(VoiceData, VoiceDataSize);
         
         // Try the lock again before exiting - if it's available now, process the queue
         if (!IsAudioConfiguring)
@@ -170,7 +169,7 @@ void UConvaiAudioStreamer::PlayVoiceData(uint8* VoiceData, uint32 VoiceDataSize,
 			IsAudioConfiguring.AtomicSet(false);
         }
         
-        return;
+        return false;
     }
     
     // We have the lock, proceed with processing
@@ -215,7 +214,7 @@ void UConvaiAudioStreamer::PlayVoiceData(uint8* VoiceData, uint32 VoiceDataSize,
         }
         else
         {            
-            AsyncTask(ENamedThreads::GameThread, [WeakThis, AudioDataCopy, SampleRate, NumChannels]()
+            EnqueueGameThreadTask([WeakThis, AudioDataCopy, SampleRate, NumChannels]()
                 {
                     if (WeakThis.IsValid())
 						SetupAndPlayAudio(WeakThis, AudioDataCopy, SampleRate, NumChannels);
@@ -230,23 +229,20 @@ void UConvaiAudioStreamer::PlayVoiceData(uint8* VoiceData, uint32 VoiceDataSize,
                 });
         }
 
-        if (!IsTalking)
-        {
-            onAudioStarted();
-            IsTalking = true;
-        }
-        
-        return;
+        return true;
     }
     
     SoundWaveProcedural->QueueAudio(VoiceData, VoiceDataSize);
+    return true;
+}
 
+void UConvaiAudioStreamer::MarkTalking()
+{
     if (!IsTalking)
     {
         onAudioStarted();
         IsTalking = true;
     }
-
 }
 
 void UConvaiAudioStreamer::ForcePlayVoice(USoundWave* VoiceToPlay)
@@ -265,7 +261,6 @@ void UConvaiAudioStreamer::StopVoice()
     // Clear audio buffer
 	AudioRingBuffer.Reset();
     bIsPlayingAudio = false;
-    BytesSentToLipSync = 0;
 
     // If we're not talking and buffers are empty, nothing to do
     if (!IsTalking)
@@ -281,7 +276,7 @@ void UConvaiAudioStreamer::StopVoice()
     // Notify that audio has finished
     onAudioFinished();
 
-	AsyncTask(ENamedThreads::GameThread, [this]()
+	EnqueueGameThreadTask([this]()
 		{
 			ClearAudioFinishedTimer();
 		});
@@ -302,7 +297,7 @@ void UConvaiAudioStreamer::ResumeVoice()
 	if (!bIsPaused)
 		return;
 
-	AsyncTask(ENamedThreads::GameThread, [this]
+	EnqueueGameThreadTask([this]
 	{
 		GetWorld()->GetTimerManager().UnPauseTimer(AudioFinishedTimerHandle);
 	});
@@ -483,10 +478,26 @@ void UConvaiAudioStreamer::BeginPlay()
     
     // Initialize configuration parameters
 
-	// Minimum buffer duration in seconds
+	// Minimum buffer duration in seconds, the floor of the adaptive playout delay
 	MinBufferDuration = UConvaiSettingsUtils::GetParamValueAsFloat("MinBufferDuration", MinBufferDuration) ? MinBufferDuration : 0;
 	MinBufferDuration = MinBufferDuration < 0 ? 0 : MinBufferDuration;
 
+	// Maximum buffer duration in seconds, the ceiling the jitter estimate can grow the playout delay to
+	MaxBufferDuration = UConvaiSettingsUtils::GetParamValueAsFloat("MaxBufferDuration", MaxBufferDuration) ? MaxBufferDuration : 0.5f;
+	MaxBufferDuration = MaxBufferDuration < MinBufferDuration ? MinBufferDuration : MaxBufferDuration;
+
+	AudioJitter.Configure(MinBufferDuration, MaxBufferDuration);
+
+	// The core ticker keeps running while the game is paused or this component does not tick
+	if (!GameThreadTasksTickerHandle.IsValid())
+	{
+#if ENGINE_MAJOR_VERSION >= 5
+		GameThreadTasksTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UConvaiAudioStreamer::ProcessGameThreadTasks));
+#else
+		GameThreadTasksTickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UConvaiAudioStreamer::ProcessGameThreadTasks));
+#endif
+	}
+
 	// Initialize the audio component
 	bAutoActivate = true;
 	bAlwaysPlay = true;
@@ -505,88 +516,77 @@ void UConvaiAudioStreamer::BeginPlay()
 // Handle received audio data (called from transport thread - lightweight)
 void UConvaiAudioStreamer::HandleAudioReceived(uint8* AudioData, uint32 AudioDataSize, bool ContainsHeaderData, uint32 SampleRate, uint32 NumChannels)
 {
-    AudioRingBuffer.SetFormat(SampleRate, NumChannels);
-    AudioRingBuffer.Enqueue(AudioData, AudioDataSize);
+    HandleAudioBlockReceived(FConvaiAudioBlockPool::Get().Acquire(AudioData, AudioDataSize, SampleRate, NumChannels));
 }
 
-// Helper function to dequeue audio data if ready, returns number of bytes dequeued (0 if not ready)
-uint32 UConvaiAudioStreamer::TryDequeueAudioChunk(TArray<uint8>& OutAudioData, uint32& OutSampleRate, uint32& OutNumChannels, bool Force)
+// Handle a block already filled by the transport callback (called from transport thread - lightweight)
+void UConvaiAudioStreamer::HandleAudioBlockReceived(const FConvaiAudioBlockRef& AudioBlock)
 {
-    // Get audio format
-    AudioRingBuffer.GetFormat(OutSampleRate, OutNumChannels);
+    if (!AudioBlock.IsValid())
+    {
+        return;
+    }
 
-    if (OutSampleRate == 0 || OutNumChannels == 0)
+    AudioRingBuffer.SetFormat(AudioBlock->GetSampleRate(), AudioBlock->GetNumChannels());
+    AudioRingBuffer.EnqueueBlock(AudioBlock);
+
+    // Track how late each block arrives relative to the audio already received
+    AudioJitter.OnArrival(FPlatformTime::Seconds(), UConvaiUtils::CalculateAudioDuration(AudioBlock->Num(), AudioBlock->GetNumChannels(), AudioBlock->GetSampleRate(), 2));
+}
+
+// Helper function to check whether enough audio is buffered to start or continue playback
+bool UConvaiAudioStreamer::IsAudioReadyToPlay(uint32 SampleRate, uint32 NumChannels, bool Force)
+{
+    if (SampleRate == 0 || NumChannels == 0)
     {
-        return 0; // Format not set yet
+        return false; // Format not set yet
     }
 
     // Check if we have any data to process
     uint32 AvailableBytes = AudioRingBuffer.GetAvailableBytes();
     if (AvailableBytes == 0)
     {
-        return 0; // No data to process
+        return false; // No data to process
     }
 
-    // Check if we should wait for more buffering
-    if (!bIsPlayingAudio && MinBufferDuration > 0.0f)
+    // Check if we should wait for more buffering, the delay follows the measured arrival jitter
+    if (!bIsPlayingAudio && !Force)
     {
-        // Calculate how much audio duration we have buffered
-        double BufferedDuration = UConvaiUtils::CalculateAudioDuration(AvailableBytes, OutNumChannels, OutSampleRate, 2);
-
-        if (BufferedDuration < MinBufferDuration && !Force)
+        const double TargetDelay = AudioJitter.GetTargetDelay();
+        if (TargetDelay > 0.0)
         {
-            // Not enough data buffered yet, wait for more
-            return 0;
-        }
-    }
+            // Calculate how much audio duration we have buffered
+            double BufferedDuration = UConvaiUtils::CalculateAudioDuration(AvailableBytes, NumChannels, SampleRate, 2);
 
-    // Ensure buffer has capacity (only allocates once, keeps slack for reuse)
-    if (OutAudioData.Num() < (int32)MaxChunkSize)
-    {
-        OutAudioData.SetNumUninitialized(MaxChunkSize);
+            if (BufferedDuration < TargetDelay)
+            {
+                // Not enough data buffered yet, wait for more
+                return false;
+            }
+        }
     }
 
-    // Dequeue audio chunk - buffer stays at MaxChunkSize with slack, we return valid byte count
-    uint32 BytesRead = AudioRingBuffer.Dequeue(OutAudioData.GetData(), MaxChunkSize);
-
-    return BytesRead;
+    return true;
 }
 
-// Helper function to send new buffered audio to non-precomputed lipsync component
-void UConvaiAudioStreamer::SendNewAudioToLipSync(uint32 AvailableBytes, uint32 SampleRate, uint32 NumChannels)
+// Helper function to send audio the lipsync tap has not seen yet to non-precomputed lipsync component
+void UConvaiAudioStreamer::SendNewAudioToLipSync(uint32 SampleRate, uint32 NumChannels)
 {
-    // Calculate how much new data we have that hasn't been sent to lipsync yet
-    uint32 NewBytesForLipSync = (AvailableBytes > BytesSentToLipSync) ? (AvailableBytes - BytesSentToLipSync) : 0;
-
-    if (NewBytesForLipSync == 0)
+    if (!AudioRingBuffer.HasUntappedBlocks())
     {
         return;
     }
 
-    // Ensure peek buffer has capacity (only allocates once, keeps slack for reuse)
-    if (LipSyncPeekBuffer.Num() < (int32)AvailableBytes)
+    // Pause the lipsync component so it won't play on its own until playback starts
+    if (!bIsPlayingAudio)
     {
-        LipSyncPeekBuffer.SetNumUninitialized(AvailableBytes);
+        ConvaiLipSync->ConvaiPauseLipSync();
     }
 
-    // Peek at all buffered data
-    uint32 PeekedBytes = AudioRingBuffer.GetData(LipSyncPeekBuffer.GetData(), AvailableBytes);
-
-    if (PeekedBytes >= BytesSentToLipSync + NewBytesForLipSync)
+    // Each block is handed to the tap exactly once, whether or not it has been played yet
+    while (FConvaiAudioBlockRef Block = AudioRingBuffer.ReadTap())
     {
-        // Pause the lipsync component so it won't play on its own
-        ConvaiLipSync->ConvaiPauseLipSync();
-
-        // Send only the new portion (skip what we've already sent)
-        ConvaiLipSync->ConvaiInferFacialDataFromAudio(
-            LipSyncPeekBuffer.GetData() + BytesSentToLipSync,
-            NewBytesForLipSync,
-            SampleRate,
-            NumChannels
-        );
-
-        // Update tracking
-        BytesSentToLipSync += NewBytesForLipSync;
+        ConvaiLipSync->ConvaiInferFacialDataFromAudio(Block->GetData(), Block->Num(), SampleRate, NumChannels);
     }
 }
 
@@ -603,39 +603,64 @@ void UConvaiAudioStreamer::ProcessIncomingAudio(bool Force)
     }
 
     // Check if we have any data to process
-    uint32 AvailableBytes = AudioRingBuffer.GetAvailableBytes();
-    if (AvailableBytes == 0)
+    if (AudioRingBuffer.IsEmpty())
     {
         return;
     }
 
-	if (!bIsPlayingAudio && SupportsLipSync() && !ConvaiLipSync->RequiresPrecomputedFaceData())
+	if (SupportsLipSync() && !ConvaiLipSync->RequiresPrecomputedFaceData())
 	{
-		// Peek and send new audio
-		SendNewAudioToLipSync(AvailableBytes, SampleRate, NumChannels);
+		// Send audio that arrived since the last tick, before any of it is played
+		SendNewAudioToLipSync(SampleRate, NumChannels);
 	}
 
-
-    // Try to dequeue an audio chunk for playback
-    uint32 DequeuedBytes = TryDequeueAudioChunk(AudioChunkBuffer, SampleRate, NumChannels);
-    if (DequeuedBytes == 0)
+    if (!IsAudioReadyToPlay(SampleRate, NumChannels, Force))
     {
         return;
     }
 
-	if (bIsPlayingAudio && SupportsLipSync() && !ConvaiLipSync->RequiresPrecomputedFaceData())
-	{
-		// Send dequeued audio directly
-        ConvaiLipSync->ConvaiInferFacialDataFromAudio(AudioChunkBuffer.GetData(), DequeuedBytes, SampleRate, NumChannels);
-	}
+    // Playback already drained everything queued before this audio arrived
+    if (bIsPlayingAudio && AudioEndTime > 0.0 && FPlatformTime::Seconds() >= AudioEndTime)
+    {
+        NotifyPlaybackUnderrun();
+    }
 
-    // Play the audio chunk (use DequeuedBytes, not AudioChunkBuffer.Num() which has slack)
-    PlayVoiceData(AudioChunkBuffer.GetData(), DequeuedBytes, false, SampleRate, NumChannels);
+    // Take the ready blocks before stopping a fading voice, StopVoice resets the ring buffer
+    FConvaiAudioBlockRef Block;
+    while (AudioRingBuffer.DequeueBlock(Block))
+    {
+        ReadyAudioBlocks.Add(MoveTemp(Block));
+    }
+
+    if (IsVoiceCurrentlyFading())
+        StopVoice();
+    ResetVoiceFade();
+
+    // Hand every ready block straight to the procedural sound wave, the block is released once queued
+    uint32 QueuedBytes = 0;
+    bool bStartedTalking = false;
+    for (const FConvaiAudioBlockRef& ReadyBlock : ReadyAudioBlocks)
+    {
+        bStartedTalking |= QueueVoiceData(ReadyBlock->GetData(), ReadyBlock->Num(), SampleRate, NumChannels);
+        QueuedBytes += ReadyBlock->Num();
+    }
+    ReadyAudioBlocks.Reset();
+
+    // Extend the finished timer and talking state once for everything queued above
+    if (QueuedBytes > 0)
+    {
+        HandleAudioTimer(this, QueuedBytes, SampleRate);
+    }
+    if (bStartedTalking)
+    {
+        MarkTalking();
+    }
 
 	// Mark as playing and resume lipsync on first chunk
 	if (!bIsPlayingAudio)
 	{
 		bIsPlayingAudio = true;
+		AudioJitter.OnPlaybackStarted();
 
 		// Resume lipsync when starting to play
 		if (SupportsLipSync())
@@ -646,6 +671,70 @@ void UConvaiAudioStreamer::ProcessIncomingAudio(bool Force)
 	}
 }
 
+void UConvaiAudioStreamer::NotifyPlaybackUnderrun()
+{
+	AudioJitter.OnUnderrun();
+	CONVAI_LOG(ConvaiAudioStreamerLog, Verbose, TEXT("Audio underrun, playout delay now %f s (jitter %f s)"), AudioJitter.GetTargetDelay(), AudioJitter.GetJitter());
+}
+
+int32 UConvaiAudioStreamer::GetAudioUnderrunCount() const
+{
+	return static_cast<int32>(AudioJitter.GetUnderrunCount());
+}
+
+int32 UConvaiAudioStreamer::GetLateAudioPacketCount() const
+{
+	return static_cast<int32>(AudioJitter.GetLatePacketCount());
+}
+
+float UConvaiAudioStreamer::GetAudioPlayoutDelay() const
+{
+	return static_cast<float>(AudioJitter.GetLastTargetDelay());
+}
+
+void UConvaiAudioStreamer::EnqueueGameThreadTask(TUniqueFunction<void()>&& Task)
+{
+	// Tasks may still be queued when the component is torn down, never run one against a dead component
+	GameThreadTasks.Enqueue([WeakThis = TWeakObjectPtr<UConvaiAudioStreamer>(this), Task = MoveTemp(Task)]() mutable
+		{
+			if (WeakThis.IsValid())
+			{
+				Task();
+			}
+		});
+}
+
+void UConvaiAudioStreamer::RunOnGameThread(TUniqueFunction<void()>&& Task)
+{
+	if (IsInGameThread())
+	{
+		Task();
+	}
+	else
+	{
+		EnqueueGameThreadTask(MoveTemp(Task));
+	}
+}
+
+bool UConvaiAudioStreamer::ProcessGameThreadTasks(float DeltaTime)
+{
+	GameThreadTasks.ProcessAll();
+	return true;
+}
+
+void UConvaiAudioStreamer::RemoveGameThreadTasksTicker()
+{
+	if (GameThreadTasksTickerHandle.IsValid())
+	{
+#if ENGINE_MAJOR_VERSION >= 5
+		FTSTicker::GetCoreTicker().RemoveTicker(GameThreadTasksTickerHandle);
+#else
+		FTicker::GetCoreTicker().RemoveTicker(GameThreadTasksTickerHandle);
+#endif
+		GameThreadTasksTickerHandle.Reset();
+	}
+}
+
 // Force play any buffered audio
 void UConvaiAudioStreamer::ForcePlayBufferedAudio()
 {
@@ -677,8 +766,13 @@ void UConvaiAudioStreamer::ProcessIncomingLipSync()
                 ConvaiLipSync->ConvaiPauseLipSync();
             }
 
+            if (!ConvaiLipSync->SupportsPackedFaceData())
+            {
+                Sequence.ExpandPackedFrames();
+            }
+
             // Send the accumulated lipsync data
-            ConvaiLipSync->ConvaiApplyPrecomputedFacialAnimation(nullptr, 0, 0, 0, Sequence);
+            ConvaiLipSync->ConvaiApplyPrecomputedFacialAnimation(nullptr, 0, 0, 0, MoveTemp(Sequence));
         }
     }
 }
@@ -696,8 +790,18 @@ void UConvaiAudioStreamer::TickComponent(float DeltaTime, ELevelTick TickType, F
 	ProcessIncomingLipSync();
 }
 
+void UConvaiAudioStreamer::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	RemoveGameThreadTasksTicker();
+	GameThreadTasks.Empty();
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void UConvaiAudioStreamer::BeginDestroy()
 {
+	RemoveGameThreadTasksTicker();
+
 	Super::BeginDestroy();
 }
 
@@ -813,7 +917,7 @@ double UConvaiAudioStreamer::GetRemainingContentDuration()
 
 void UConvaiAudioStreamer::onAudioStarted()
 {
-	AsyncTask(ENamedThreads::GameThread, [this] {
+	EnqueueGameThreadTask([this] {
 		OnStartedTalkingDelegate.Broadcast();
 		});
 	
@@ -828,7 +932,7 @@ void UConvaiAudioStreamer::onAudioFinished()
     bIsPlayingAudio = false;
 
     // Broadcast that audio has finished
-    AsyncTask(ENamedThreads::GameThread, [this] {
+    EnqueueGameThreadTask([this] {
         OnFinishedTalkingDelegate.Broadcast();
     });
     IsTalking = false;
@@ -231,7 +231,7 @@ bool UConvaiChatbotComponent::StartFirstAction()
 			return true;
 		}
 
-		AsyncTask(ENamedThreads::GameThread, [this, ConvaiResultAction]
+		EnqueueGameThreadTask([this, ConvaiResultAction]
 		{
 			TriggerNamedBlueprintAction(ConvaiResultAction.Action, ConvaiResultAction);
 		});
@@ -349,13 +349,30 @@ void UConvaiChatbotComponent::StartRecordingVoice()
 
 USoundWave* UConvaiChatbotComponent::FinishRecordingVoice()
 {
+	TArray<uint8> RecordedAudio;
+	{
+		FScopeLock Lock(&RecordedAudioLock);
+
+		// Flatten the shared blocks once, releasing them back to the pool
+		int32 TotalBytes = 0;
+		for (const FConvaiAudioBlockRef& Block : RecordedAudioBlocks)
+		{
+			TotalBytes += Block->Num();
+		}
+		RecordedAudio.Reserve(TotalBytes);
+		for (const FConvaiAudioBlockRef& Block : RecordedAudioBlocks)
+		{
+			RecordedAudio.Append(Block->GetData(), Block->Num());
+		}
+		RecordedAudioBlocks.Empty();
+	}
+
 	CONVAI_LOG(ConvaiChatbotComponentLog, Log, TEXT("Finished Recording Audio - Total bytes: %d - Duration: %f"), RecordedAudio.Num(), UConvaiUtils::CalculateAudioDuration(RecordedAudio.Num(), 1,RecordedAudioSampleRate, 2));
 
 	if (!IsRecordingAudio)
 		return nullptr;
-	USoundWave* SoundWave = UConvaiUtils::PCMDataToSoundWav(RecordedAudio, 1, RecordedAudioSampleRate);
+	USoundWave* SoundWave = UConvaiUtils::PCMDataToSoundWav(MoveTemp(RecordedAudio), 1, RecordedAudioSampleRate);
 	IsRecordingAudio = false;
-	RecordedAudio.Empty();
 	return SoundWave;
 }
 
@@ -458,7 +475,7 @@ void UConvaiChatbotComponent::InterruptSpeech(float InVoiceFadeOutDuration)
 
 		StopVoiceWithFade(InVoiceFadeOutDuration);
 
-		AsyncTask(ENamedThreads::GameThread, [WeakThis = MakeWeakObjectPtr(this)]
+		EnqueueGameThreadTask([WeakThis = MakeWeakObjectPtr(this)]
 			{
 				if (!WeakThis.IsValid())
 				{
@@ -685,11 +702,12 @@ EC_LipSyncMode UConvaiChatbotComponent::GetLipSyncMode()
 // IConvaiConnectionInterface implementation
 void UConvaiChatbotComponent::OnConnectedToServer()
 {
-	
+	bVisionReferenceStale = true;
 }
 
 void UConvaiChatbotComponent::OnDisconnectedFromServer()
 {
+	bVisionReferenceStale = true;
 	StopVoice();
 	IsConnectionTalking = false;
 }
@@ -722,7 +740,7 @@ void UConvaiChatbotComponent::OnTranscriptionReceived(FString Transcription, boo
 	{
 		TWeakObjectPtr<UConvaiChatbotComponent> WeakThis(this);
 
-		AsyncTask(ENamedThreads::GameThread, [WeakThis, Transcription, IsTranscriptionReady, IsFinal]()
+		EnqueueGameThreadTask([WeakThis, Transcription, IsTranscriptionReady, IsFinal]()
 		{
 			if (WeakThis.IsValid())
 			{
@@ -759,7 +777,7 @@ void UConvaiChatbotComponent::OnInteractionIDReceived(FString ReceivedInteractio
 	}
 	else
 	{
-		AsyncTask(ENamedThreads::GameThread, [this, ReceivedInteractionID]
+		EnqueueGameThreadTask([this, ReceivedInteractionID]
 			{
 				// Send Interaction ID to blueprint event
 				OnInteractionIDReceivedEvent.Broadcast(this, nullptr, ReceivedInteractionID);
@@ -780,8 +798,8 @@ void UConvaiChatbotComponent::OnActionSequenceReceived(const TArray<FConvaiResul
 			StartFirstAction();
 	}
 
-	// Broadcast the actions
-	AsyncTask(ENamedThreads::GameThread, [this, ReceivedSequenceOfActions] {
+	// Broadcast the actions, packets are normally delivered on the game thread already
+	RunOnGameThread([this, ReceivedSequenceOfActions] {
 		OnActionReceivedEvent_V2.Broadcast(this, nullptr, ReceivedSequenceOfActions);
 		});
 }
@@ -806,14 +824,14 @@ void UConvaiChatbotComponent::OnEmotionReceived(FString ReceivedEmotionResponse,
 	}
 
 	// Broadcast the emotion state changed event
-	AsyncTask(ENamedThreads::GameThread, [this] {
+	RunOnGameThread([this] {
 		OnEmotionStateChangedEvent.Broadcast(this, nullptr);
 		});
 }
 
 void UConvaiChatbotComponent::OnNarrativeSectionReceived(FString BT_Code, FString BT_Constants, FString ReceivedNarrativeSectionID)
 {
-	AsyncTask(ENamedThreads::GameThread, [this, ReceivedNarrativeSectionID]
+	RunOnGameThread([this, ReceivedNarrativeSectionID]
 		{
 			OnNarrativeSectionReceivedEvent.Broadcast(this, ReceivedNarrativeSectionID);
 		});
@@ -860,13 +878,14 @@ void UConvaiChatbotComponent::OnAudioDataReceived(const int16_t* AudioData, size
 	
     if (TotalBytes > 0)
     {
-        // Directly call HandleAudioReceived
-        HandleAudioReceived((uint8*)AudioData, TotalBytes, false, SampleRate, NumChannels);
+        // The only copy of the network buffer, playback, lipsync and recording share this block
+        FConvaiAudioBlockRef AudioBlock = FConvaiAudioBlockPool::Get().Acquire((const uint8*)AudioData, TotalBytes, SampleRate, NumChannels);
+        HandleAudioBlockReceived(AudioBlock);
 
         if (IsRecordingAudio)
         {
-            // Directly append to RecordedAudio without intermediate copy
-            RecordedAudio.Append((uint8*)AudioData, TotalBytes);
+            FScopeLock Lock(&RecordedAudioLock);
+            RecordedAudioBlocks.Add(MoveTemp(AudioBlock));
             RecordedAudioSampleRate = SampleRate;
         }
     }
@@ -891,12 +910,18 @@ void UConvaiChatbotComponent::onAudioFinished()
 {
 	CONVAI_LOG(ConvaiChatbotComponentLog, Log, TEXT("onAudioFinished - IsConnectionTalking: %s"), IsConnectionTalking ? TEXT("true") : TEXT("false"));
 
+	// Playback drained while the connection is still sending, the playout delay was too short
+	if (IsConnectionTalking && bIsPlayingAudio)
+	{
+		NotifyPlaybackUnderrun();
+	}
+
 	// Reset the audio end time
 	AudioEndTime = 0.0;
 	bIsPlayingAudio = false;
 
 	// Broadcast that audio has finished
-	AsyncTask(ENamedThreads::GameThread, [this] {
+	EnqueueGameThreadTask([this] {
 		OnFinishedTalkingDelegate.Broadcast();
 	});
 	IsTalking = false;
@@ -926,7 +951,7 @@ void UConvaiChatbotComponent::OnFailure(FString Message)
 		*SessionID);
 
 	// Broadcast the failure
-	AsyncTask(ENamedThreads::GameThread, [this] {OnFailureEvent.Broadcast(); });
+	EnqueueGameThreadTask([this] {OnFailureEvent.Broadcast(); });
 
     // Log the failure
     CONVAI_LOG(ConvaiChatbotComponentLog, Error, TEXT("Connection failure: %s"), *Message);
@@ -940,6 +965,9 @@ void UConvaiChatbotComponent::StartSession()
         StopSession();
     }
     
+    // The new connection has not seen any vision frame yet
+    bVisionReferenceStale = true;
+
     // Create a new session proxy
     SessionProxyInstance = NewObject<UConvaiConnectionSessionProxy>(this);
     if (!IsValid(SessionProxyInstance))
@@ -979,13 +1007,40 @@ void UConvaiChatbotComponent::StopSession()
     }
 }
 
+bool UConvaiChatbotComponent::PrewarmConnection()
+{
+    if (IsValid(SessionProxyInstance))
+    {
+        // Already connected or connecting
+        return true;
+    }
+
+    UConvaiSubsystem* ConvaiSubsystem = UConvaiUtils::GetConvaiSubsystem(this);
+    if (!IsValid(ConvaiSubsystem))
+    {
+        CONVAI_LOG(ConvaiChatbotComponentLog, Warning, TEXT("PrewarmConnection: ConvaiSubsystem is not valid"));
+        return false;
+    }
+
+    return ConvaiSubsystem->PrewarmCharacterConnection(CharacterID, this);
+}
+
 void UConvaiChatbotComponent::SendImage(const float& DeltaTime)
 {
 	if (!ConvaiVision || ConvaiVision->GetState() != EVisionState::Capturing || !IsValid(SessionProxyInstance))
 	{
+		bVisionWasCapturing = false;
 		return;
 	}
 
+	// Whatever was sent before capturing (re)started is no reference for the next frame
+	if (!bVisionWasCapturing || bVisionReferenceStale)
+	{
+		bVisionWasCapturing = true;
+		bVisionReferenceStale = false;
+		VisionFrameChangeDetector.Reset();
+	}
+
 	// Keep our send cadence aligned to ConvaiVision's advertised FPS
 	const int32 VisionFps = ConvaiVision->GetMaxFPS();
 	if (VisionFps != CachedVisionFPS && VisionFps > 0)
@@ -1011,7 +1066,7 @@ void UConvaiChatbotComponent::SendImage(const float& DeltaTime)
 	if (TimeSinceLastVideoSend < 0.f) TimeSinceLastVideoSend = 0.f;
 
 	int32 Width = 0, Height = 0;
-	TArray<uint8> Data;
+	TArray<uint8>& Data = VisionFrameBuffer;
 	bool bCaptureSuccess = false;
 	if (!bCaptureSuccess)
 	{
@@ -1022,7 +1077,31 @@ void UConvaiChatbotComponent::SendImage(const float& DeltaTime)
 	static uint8 LogState = 0; 
 	if (bCaptureSuccess && Width > 0 && Height > 0 && Data.Num() > 0)
 	{
-		SessionProxyInstance->SendImage(Width, Height, Data);
+		// Skip frames that barely differ from the last one sent, a static camera then only sends keyframes
+		const bool bDetectChanges = VisionChangeThreshold > 0.f && Data.Num() >= Width * Height * 4;
+		const double Now = FPlatformTime::Seconds();
+		if (bDetectChanges)
+		{
+			const bool bKeyframeDue = VisionKeyframeInterval > 0.f && Now - LastVisionFrameSentTime >= VisionKeyframeInterval;
+			if (VisionFrameChangeDetector.Compare(Data.GetData(), Width, Height) < VisionChangeThreshold && !bKeyframeDue)
+			{
+				++VisionFramesSkipped;
+				return;
+			}
+		}
+
+		// The first frame of a connection only starts video publishing, it must not become the reference
+		if (!SessionProxyInstance->SendImage(Width, Height, Data))
+		{
+			return;
+		}
+
+		++VisionFramesSent;
+		if (bDetectChanges)
+		{
+			VisionFrameChangeDetector.Accept();
+			LastVisionFrameSentTime = Now;
+		}
 
 		if (LogState != 2) // only log once when switching to success
 		{
@@ -56,12 +56,14 @@ int32 UConvaiConnectionSessionProxy::SendAudio(const int16_t* AudioData, const s
     return -1;
 }
 
-void UConvaiConnectionSessionProxy::SendImage(const uint32 Width, const uint32 Height, TArray<uint8> Data) const
+bool UConvaiConnectionSessionProxy::SendImage(const uint32 Width, const uint32 Height, TArray<uint8>& Data) const
 {
     if (UConvaiSubsystem* ConvaiSubsystem = UConvaiUtils::GetConvaiSubsystem(this))
     {
-        ConvaiSubsystem->SendImage(this, Width, Height, Data);
+        return ConvaiSubsystem->SendImage(this, Width, Height, Data);
     }
+
+    return false;
 }
 
 void UConvaiConnectionSessionProxy::SendTextMessage(const FString& Message) const
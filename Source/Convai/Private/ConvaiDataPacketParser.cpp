@@ -0,0 +1,1069 @@
+// Copyright 2022 Convai Inc. All Rights Reserved.
+
+#include "ConvaiDataPacketParser.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Math/Float16.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Utility/Log/ConvaiLogger.h"
+
+DEFINE_LOG_CATEGORY(ConvaiDataPacketLog);
+
+namespace
+{
+	// Deeper payloads are rejected instead of recursing further
+	constexpr int32 MaxSkipDepth = 32;
+
+	template<int32 N>
+	FORCEINLINE bool MatchesLiteral(const char* Str, int32 Len, const char (&Literal)[N])
+	{
+		return Len == N - 1 && FMemory::Memcmp(Str, Literal, N - 1) == 0;
+	}
+
+	constexpr uint16 PackChars(char A, char B)
+	{
+		return static_cast<uint16>((static_cast<uint8>(A) << 8) | static_cast<uint8>(B));
+	}
+
+	/** A JSON string as it appears in the packet, escapes not yet decoded */
+	struct FRawString
+	{
+		const char* Data = nullptr;
+		int32 Len = 0;
+		bool bHasEscapes = false;
+	};
+
+	/** Forward-only cursor over a UTF-8 JSON document */
+	struct FJsonCursor
+	{
+		const char* P;
+		const char* End;
+
+		FJsonCursor(const char* InBegin, const char* InEnd)
+			: P(InBegin)
+			, End(InEnd)
+		{
+		}
+
+		FORCEINLINE void SkipWhitespace()
+		{
+			while (P < End && (*P == ' ' || *P == '\t' || *P == '\n' || *P == '\r'))
+			{
+				++P;
+			}
+		}
+
+		FORCEINLINE char Peek()
+		{
+			SkipWhitespace();
+			return P < End ? *P : '\0';
+		}
+
+		FORCEINLINE bool Consume(char C)
+		{
+			if (Peek() == C)
+			{
+				++P;
+				return true;
+			}
+			return false;
+		}
+
+		template<int32 N>
+		bool ConsumeLiteral(const char (&Literal)[N])
+		{
+			SkipWhitespace();
+			if (End - P >= N - 1 && FMemory::Memcmp(P, Literal, N - 1) == 0)
+			{
+				P += N - 1;
+				return true;
+			}
+			return false;
+		}
+
+		bool ReadString(FRawString& Out)
+		{
+			if (!Consume('"'))
+			{
+				return false;
+			}
+
+			Out.Data = P;
+			Out.bHasEscapes = false;
+			while (P < End)
+			{
+				const char C = *P;
+				if (C == '"')
+				{
+					Out.Len = static_cast<int32>(P - Out.Data);
+					++P;
+					return true;
+				}
+				if (C == '\\')
+				{
+					// Step over the escaped character, \u digits need no special casing here
+					Out.bHasEscapes = true;
+					++P;
+				}
+				++P;
+			}
+			return false;
+		}
+
+		bool ReadNumber(double& Out)
+		{
+			static constexpr double PowersOf10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+				1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+			constexpr int32 MaxSignificantDigits = 18;
+
+			SkipWhitespace();
+			const char* Start = P;
+
+			const bool bNegative = P < End && *P == '-';
+			if (bNegative)
+			{
+				++P;
+			}
+
+			// Accumulate up to 18 significant digits as an integer and scale once at the end
+			uint64 Mantissa = 0;
+			int32 NumSignificant = 0;
+			int32 Exponent = 0;
+			bool bAnyDigits = false;
+
+			for (; P < End && *P >= '0' && *P <= '9'; ++P)
+			{
+				bAnyDigits = true;
+				if (NumSignificant < MaxSignificantDigits)
+				{
+					Mantissa = Mantissa * 10 + (*P - '0');
+					NumSignificant += Mantissa != 0;
+				}
+				else
+				{
+					++Exponent;
+				}
+			}
+
+			if (P < End && *P == '.')
+			{
+				for (++P; P < End && *P >= '0' && *P <= '9'; ++P)
+				{
+					bAnyDigits = true;
+					if (NumSignificant < MaxSignificantDigits)
+					{
+						Mantissa = Mantissa * 10 + (*P - '0');
+						NumSignificant += Mantissa != 0;
+						--Exponent;
+					}
+				}
+			}
+
+			if (!bAnyDigits)
+			{
+				P = Start;
+				return false;
+			}
+
+			if (P < End && (*P == 'e' || *P == 'E'))
+			{
+				++P;
+				const bool bNegativeExponent = P < End && *P == '-';
+				if (P < End && (*P == '-' || *P == '+'))
+				{
+					++P;
+				}
+
+				int32 ExplicitExponent = 0;
+				for (; P < End && *P >= '0' && *P <= '9'; ++P)
+				{
+					ExplicitExponent = FMath::Min(ExplicitExponent * 10 + (*P - '0'), 1000);
+				}
+				Exponent += bNegativeExponent ? -ExplicitExponent : ExplicitExponent;
+			}
+
+			double Value = static_cast<double>(Mantissa);
+			if (Mantissa != 0)
+			{
+				for (; Exponent > 22; Exponent -= 22)
+				{
+					Value *= PowersOf10[22];
+				}
+				for (; Exponent < -22; Exponent += 22)
+				{
+					Value /= PowersOf10[22];
+				}
+				Value = Exponent >= 0 ? Value * PowersOf10[Exponent] : Value / PowersOf10[-Exponent];
+			}
+
+			Out = bNegative ? -Value : Value;
+			return true;
+		}
+
+		bool ReadBool(bool& Out)
+		{
+			if (ConsumeLiteral("true"))
+			{
+				Out = true;
+				return true;
+			}
+			if (ConsumeLiteral("false"))
+			{
+				Out = false;
+				return true;
+			}
+			return false;
+		}
+
+		bool SkipValue(int32 Depth = 0)
+		{
+			if (Depth > MaxSkipDepth)
+			{
+				return false;
+			}
+
+			switch (Peek())
+			{
+			case '"':
+			{
+				FRawString Ignored;
+				return ReadString(Ignored);
+			}
+			case '{':
+			{
+				++P;
+				if (Consume('}'))
+				{
+					return true;
+				}
+				do
+				{
+					FRawString Key;
+					if (!ReadString(Key) || !Consume(':') || !SkipValue(Depth + 1))
+					{
+						return false;
+					}
+				} while (Consume(','));
+				return Consume('}');
+			}
+			case '[':
+			{
+				++P;
+				if (Consume(']'))
+				{
+					return true;
+				}
+				do
+				{
+					if (!SkipValue(Depth + 1))
+					{
+						return false;
+					}
+				} while (Consume(','));
+				return Consume(']');
+			}
+			case 't':
+				return ConsumeLiteral("true");
+			case 'f':
+				return ConsumeLiteral("false");
+			case 'n':
+				return ConsumeLiteral("null");
+			default:
+			{
+				double Ignored;
+				return ReadNumber(Ignored);
+			}
+			}
+		}
+	};
+
+	/**
+	 * Walks the members of the object at the cursor. MemberFunc(Key) is called positioned on
+	 * each value and must consume it, returning false to abort.
+	 */
+	template<typename FuncType>
+	bool ForEachMember(FJsonCursor& Cursor, FuncType&& MemberFunc)
+	{
+		if (!Cursor.Consume('{'))
+		{
+			return false;
+		}
+		if (Cursor.Consume('}'))
+		{
+			return true;
+		}
+		do
+		{
+			FRawString Key;
+			if (!Cursor.ReadString(Key) || !Cursor.Consume(':') || !MemberFunc(Key))
+			{
+				return false;
+			}
+		} while (Cursor.Consume(','));
+		return Cursor.Consume('}');
+	}
+
+	bool ParseHex4(const char* Str, int32 Len, uint32& Out)
+	{
+		if (Len < 4)
+		{
+			return false;
+		}
+
+		Out = 0;
+		for (int32 Index = 0; Index < 4; ++Index)
+		{
+			const char C = Str[Index];
+			uint32 Digit;
+			if (C >= '0' && C <= '9')
+			{
+				Digit = C - '0';
+			}
+			else if (C >= 'a' && C <= 'f')
+			{
+				Digit = C - 'a' + 10;
+			}
+			else if (C >= 'A' && C <= 'F')
+			{
+				Digit = C - 'A' + 10;
+			}
+			else
+			{
+				return false;
+			}
+			Out = (Out << 4) | Digit;
+		}
+		return true;
+	}
+
+	template<typename AllocatorType>
+	void AppendUTF8(TArray<ANSICHAR, AllocatorType>& Out, uint32 CodePoint)
+	{
+		if (CodePoint < 0x80)
+		{
+			Out.Add(static_cast<ANSICHAR>(CodePoint));
+		}
+		else if (CodePoint < 0x800)
+		{
+			Out.Add(static_cast<ANSICHAR>(0xC0 | (CodePoint >> 6)));
+			Out.Add(static_cast<ANSICHAR>(0x80 | (CodePoint & 0x3F)));
+		}
+		else if (CodePoint < 0x10000)
+		{
+			Out.Add(static_cast<ANSICHAR>(0xE0 | (CodePoint >> 12)));
+			Out.Add(static_cast<ANSICHAR>(0x80 | ((CodePoint >> 6) & 0x3F)));
+			Out.Add(static_cast<ANSICHAR>(0x80 | (CodePoint & 0x3F)));
+		}
+		else
+		{
+			Out.Add(static_cast<ANSICHAR>(0xF0 | (CodePoint >> 18)));
+			Out.Add(static_cast<ANSICHAR>(0x80 | ((CodePoint >> 12) & 0x3F)));
+			Out.Add(static_cast<ANSICHAR>(0x80 | ((CodePoint >> 6) & 0x3F)));
+			Out.Add(static_cast<ANSICHAR>(0x80 | (CodePoint & 0x3F)));
+		}
+	}
+
+	void DecodeString(const FRawString& Raw, FString& Out)
+	{
+		Out.Reset();
+
+		if (!Raw.bHasEscapes)
+		{
+			// Common case: convert the bytes in place
+			const FUTF8ToTCHAR Converted(Raw.Data, Raw.Len);
+			Out.AppendChars(Converted.Get(), Converted.Length());
+			return;
+		}
+
+		// Unescape into UTF-8 first so multi-byte sequences and \u escapes convert in one go
+		TArray<ANSICHAR, TInlineAllocator<512>> Unescaped;
+		Unescaped.Reserve(Raw.Len);
+
+		for (int32 Index = 0; Index < Raw.Len; ++Index)
+		{
+			const char C = Raw.Data[Index];
+			if (C != '\\')
+			{
+				Unescaped.Add(C);
+				continue;
+			}
+
+			if (++Index >= Raw.Len)
+			{
+				break;
+			}
+
+			switch (Raw.Data[Index])
+			{
+			case 'b': Unescaped.Add('\b'); break;
+			case 'f': Unescaped.Add('\f'); break;
+			case 'n': Unescaped.Add('\n'); break;
+			case 'r': Unescaped.Add('\r'); break;
+			case 't': Unescaped.Add('\t'); break;
+			case 'u':
+			{
+				uint32 CodePoint;
+				if (!ParseHex4(Raw.Data + Index + 1, Raw.Len - Index - 1, CodePoint))
+				{
+					break;
+				}
+				Index += 4;
+
+				// Combine a UTF-16 surrogate pair
+				uint32 LowSurrogate;
+				if (CodePoint >= 0xD800 && CodePoint <= 0xDBFF
+					&& Index + 6 < Raw.Len && Raw.Data[Index + 1] == '\\' && Raw.Data[Index + 2] == 'u'
+					&& ParseHex4(Raw.Data + Index + 3, 4, LowSurrogate)
+					&& LowSurrogate >= 0xDC00 && LowSurrogate <= 0xDFFF)
+				{
+					CodePoint = 0x10000 + ((CodePoint - 0xD800) << 10) + (LowSurrogate - 0xDC00);
+					Index += 6;
+				}
+				AppendUTF8(Unescaped, CodePoint);
+				break;
+			}
+			default:
+				// \" \\ \/ and anything unexpected map to the character itself
+				Unescaped.Add(Raw.Data[Index]);
+				break;
+			}
+		}
+
+		const FUTF8ToTCHAR Converted(Unescaped.GetData(), Unescaped.Num());
+		Out.AppendChars(Converted.Get(), Converted.Length());
+	}
+
+	// Reads a string value into Out, skipping values of any other type
+	bool ReadStringField(FJsonCursor& Cursor, FString& Out)
+	{
+		if (Cursor.Peek() != '"')
+		{
+			return Cursor.SkipValue();
+		}
+
+		FRawString Raw;
+		if (!Cursor.ReadString(Raw))
+		{
+			return false;
+		}
+		DecodeString(Raw, Out);
+		return true;
+	}
+
+	bool ReadStringArrayField(FJsonCursor& Cursor, TArray<FString>& Out)
+	{
+		if (Cursor.Peek() != '[')
+		{
+			return Cursor.SkipValue();
+		}
+
+		Cursor.Consume('[');
+		if (Cursor.Consume(']'))
+		{
+			return true;
+		}
+		do
+		{
+			if (Cursor.Peek() == '"')
+			{
+				FRawString Raw;
+				if (!Cursor.ReadString(Raw))
+				{
+					return false;
+				}
+				DecodeString(Raw, Out.AddDefaulted_GetRef());
+			}
+			else if (!Cursor.SkipValue())
+			{
+				return false;
+			}
+		} while (Cursor.Consume(','));
+		return Cursor.Consume(']');
+	}
+
+	// Standard alphabet, padding optional, no whitespace
+	template<typename AllocatorType>
+	bool DecodeBase64(const char* Str, int32 Len, TArray<uint8, AllocatorType>& Out)
+	{
+		while (Len > 0 && Str[Len - 1] == '=')
+		{
+			--Len;
+		}
+		if (Len % 4 == 1)
+		{
+			return false;
+		}
+
+		Out.SetNumUninitialized(Len * 3 / 4);
+		uint8* Dest = Out.GetData();
+		uint32 Accumulator = 0;
+		int32 NumBits = 0;
+		for (int32 Index = 0; Index < Len; ++Index)
+		{
+			const char C = Str[Index];
+			uint32 Sextet;
+			if (C >= 'A' && C <= 'Z')
+			{
+				Sextet = C - 'A';
+			}
+			else if (C >= 'a' && C <= 'z')
+			{
+				Sextet = C - 'a' + 26;
+			}
+			else if (C >= '0' && C <= '9')
+			{
+				Sextet = C - '0' + 52;
+			}
+			else if (C == '+')
+			{
+				Sextet = 62;
+			}
+			else if (C == '/')
+			{
+				Sextet = 63;
+			}
+			else
+			{
+				return false;
+			}
+
+			Accumulator = (Accumulator << 6) | Sextet;
+			NumBits += 6;
+			if (NumBits >= 8)
+			{
+				NumBits -= 8;
+				*Dest++ = static_cast<uint8>(Accumulator >> NumBits);
+			}
+		}
+		return true;
+	}
+
+	bool ParseTranscriptionData(FJsonCursor& Cursor, FConvaiDataPacket& OutPacket)
+	{
+		return ForEachMember(Cursor, [&Cursor, &OutPacket](const FRawString& Key)
+		{
+			if (MatchesLiteral(Key.Data, Key.Len, "text"))
+			{
+				return ReadStringField(Cursor, OutPacket.Text);
+			}
+			if (MatchesLiteral(Key.Data, Key.Len, "timestamp"))
+			{
+				return ReadStringField(Cursor, OutPacket.Timestamp);
+			}
+			if (MatchesLiteral(Key.Data, Key.Len, "final"))
+			{
+				return Cursor.ReadBool(OutPacket.bFinal) || Cursor.SkipValue();
+			}
+			return Cursor.SkipValue();
+		});
+	}
+
+	bool ParseErrorData(FJsonCursor& Cursor, FConvaiDataPacket& OutPacket)
+	{
+		return ForEachMember(Cursor, [&Cursor, &OutPacket](const FRawString& Key)
+		{
+			if (MatchesLiteral(Key.Data, Key.Len, "error"))
+			{
+				return ReadStringField(Cursor, OutPacket.Text);
+			}
+			return Cursor.SkipValue();
+		});
+	}
+
+	bool ParseVisemes(FJsonCursor& Cursor, FConvaiDataPacket& OutPacket)
+	{
+		if (Cursor.Peek() != '{')
+		{
+			return Cursor.SkipValue();
+		}
+
+		OutPacket.bHasVisemes = true;
+		return ForEachMember(Cursor, [&Cursor, &OutPacket](const FRawString& Key)
+		{
+			const int32 VisemeIndex = FConvaiDataPacketParser::ToVisemeIndex(Key.Data, Key.Len);
+			double Value;
+			if (VisemeIndex != INDEX_NONE && Cursor.ReadNumber(Value))
+			{
+				OutPacket.Visemes[VisemeIndex] = FMath::Clamp(static_cast<float>(Value), 0.0f, 1.0f);
+				return true;
+			}
+			return Cursor.SkipValue();
+		});
+	}
+
+	bool ParseServerMessageData(FJsonCursor& Cursor, FConvaiDataPacket& OutPacket)
+	{
+		FRawString ServerTypeName;
+		bool bHasServerType = false;
+
+		// One pass over the payload, the fields present depend on the message type
+		const bool bValid = ForEachMember(Cursor, [&](const FRawString& Key)
+		{
+			switch (Key.Len)
+			{
+			case 4:
+				if (MatchesLiteral(Key.Data, Key.Len, "type") && Cursor.Peek() == '"')
+				{
+					bHasServerType = true;
+					return Cursor.ReadString(ServerTypeName);
+				}
+				break;
+			case 5:
+				if (MatchesLiteral(Key.Data, Key.Len, "scale"))
+				{
+					double Scale;
+					if (Cursor.ReadNumber(Scale))
+					{
+						OutPacket.EmotionScale = static_cast<int32>(Scale);
+						return true;
+					}
+				}
+				break;
+			case 6:
+				if (MatchesLiteral(Key.Data, Key.Len, "frames") && Cursor.Peek() == '"')
+				{
+					FRawString Frames;
+					if (!Cursor.ReadString(Frames))
+					{
+						return false;
+					}
+					OutPacket.bHasPackedFrames = !Frames.bHasEscapes && FConvaiDataPacketParser::DecodePackedFrames(Frames.Data, Frames.Len, OutPacket.PackedFrames);
+					return true;
+				}
+				break;
+			case 7:
+				if (MatchesLiteral(Key.Data, Key.Len, "emotion"))
+				{
+					return ReadStringField(Cursor, OutPacket.Emotion);
+				}
+				if (MatchesLiteral(Key.Data, Key.Len, "actions"))
+				{
+					return ReadStringArrayField(Cursor, OutPacket.Actions);
+				}
+				if (MatchesLiteral(Key.Data, Key.Len, "visemes"))
+				{
+					return ParseVisemes(Cursor, OutPacket);
+				}
+				if (MatchesLiteral(Key.Data, Key.Len, "bt_code"))
+				{
+					return ReadStringField(Cursor, OutPacket.BTCode);
+				}
+				break;
+			case 12:
+				if (MatchesLiteral(Key.Data, Key.Len, "bt_constants"))
+				{
+					return ReadStringField(Cursor, OutPacket.BTConstants);
+				}
+				break;
+			case 20:
+				if (MatchesLiteral(Key.Data, Key.Len, "narrative_section_id"))
+				{
+					return ReadStringField(Cursor, OutPacket.NarrativeSectionID);
+				}
+				break;
+			default:
+				break;
+			}
+			return Cursor.SkipValue();
+		});
+
+		if (bHasServerType)
+		{
+			OutPacket.ServerType = ServerTypeName.bHasEscapes
+				? EConvaiServerPacketType::Unknown
+				: FConvaiDataPacketParser::ToServerPacketType(ServerTypeName.Data, ServerTypeName.Len);
+
+			if (OutPacket.ServerType == EConvaiServerPacketType::Unknown)
+			{
+				DecodeString(ServerTypeName, OutPacket.UnknownTypeName);
+			}
+		}
+
+		return bValid;
+	}
+}
+
+bool FConvaiDataPacketParser::Parse(const char* Json, int32 Length, FConvaiDataPacket& OutPacket)
+{
+	if (!Json || Length <= 0)
+	{
+		return false;
+	}
+
+	// First pass over the root only records where "type" and "data" are, the key order is not guaranteed
+	FJsonCursor Cursor(Json, Json + Length);
+	FRawString TypeName;
+	bool bHasType = false;
+	const char* DataBegin = nullptr;
+	const char* DataEnd = nullptr;
+
+	const bool bValid = ForEachMember(Cursor, [&](const FRawString& Key)
+	{
+		if (MatchesLiteral(Key.Data, Key.Len, "type") && Cursor.Peek() == '"')
+		{
+			bHasType = true;
+			return Cursor.ReadString(TypeName);
+		}
+		if (MatchesLiteral(Key.Data, Key.Len, "data") && Cursor.Peek() == '{')
+		{
+			DataBegin = Cursor.P;
+			const bool bSkipped = Cursor.SkipValue();
+			DataEnd = Cursor.P;
+			return bSkipped;
+		}
+		return Cursor.SkipValue();
+	});
+
+	if (!bValid || !bHasType)
+	{
+		return false;
+	}
+
+	OutPacket.Type = TypeName.bHasEscapes ? EConvaiDataPacketType::Unknown : ToPacketType(TypeName.Data, TypeName.Len);
+	if (OutPacket.Type == EConvaiDataPacketType::Unknown)
+	{
+		DecodeString(TypeName, OutPacket.UnknownTypeName);
+	}
+
+	if (!DataBegin)
+	{
+		return true;
+	}
+
+	FJsonCursor DataCursor(DataBegin, DataEnd);
+	switch (OutPacket.Type)
+	{
+	case EConvaiDataPacketType::UserTranscription:
+	case EConvaiDataPacketType::BotTranscription:
+		return ParseTranscriptionData(DataCursor, OutPacket);
+	case EConvaiDataPacketType::ServerMessage:
+		return ParseServerMessageData(DataCursor, OutPacket);
+	case EConvaiDataPacketType::Error:
+		return ParseErrorData(DataCursor, OutPacket);
+	default:
+		// The remaining packet types carry no payload the handlers use
+		return true;
+	}
+}
+
+bool FConvaiDataPacketParser::Parse(const char* Json, FConvaiDataPacket& OutPacket)
+{
+	return Json && Parse(Json, static_cast<int32>(FCStringAnsi::Strlen(Json)), OutPacket);
+}
+
+EConvaiDataPacketType FConvaiDataPacketParser::PeekType(const char* Json, int32 Length)
+{
+	if (!Json || Length <= 0)
+	{
+		return EConvaiDataPacketType::Unknown;
+	}
+
+	FJsonCursor Cursor(Json, Json + Length);
+	FRawString Key;
+	FRawString TypeName;
+	if (Cursor.Consume('{') && Cursor.ReadString(Key) && MatchesLiteral(Key.Data, Key.Len, "type")
+		&& Cursor.Consume(':') && Cursor.Peek() == '"' && Cursor.ReadString(TypeName) && !TypeName.bHasEscapes)
+	{
+		return ToPacketType(TypeName.Data, TypeName.Len);
+	}
+	return EConvaiDataPacketType::Unknown;
+}
+
+EConvaiDataPacketType FConvaiDataPacketParser::ToPacketType(const char* Str, int32 Len)
+{
+	// The length and one distinguishing character leave a single candidate to compare
+	switch (Len)
+	{
+	case 5:
+		return MatchesLiteral(Str, Len, "error") ? EConvaiDataPacketType::Error : EConvaiDataPacketType::Unknown;
+	case 9:
+		return MatchesLiteral(Str, Len, "bot-ready") ? EConvaiDataPacketType::BotReady : EConvaiDataPacketType::Unknown;
+	case 12:
+		if (Str[4] == 'l')
+		{
+			return MatchesLiteral(Str, Len, "bot-llm-text") ? EConvaiDataPacketType::BotLLMText : EConvaiDataPacketType::Unknown;
+		}
+		return MatchesLiteral(Str, Len, "bot-tts-text") ? EConvaiDataPacketType::BotTTSText : EConvaiDataPacketType::Unknown;
+	case 13:
+		return MatchesLiteral(Str, Len, "user-llm-text") ? EConvaiDataPacketType::UserLLMText : EConvaiDataPacketType::Unknown;
+	case 14:
+		return MatchesLiteral(Str, Len, "server-message") ? EConvaiDataPacketType::ServerMessage : EConvaiDataPacketType::Unknown;
+	case 15:
+		switch (PackChars(Str[4], Str[10]))
+		{
+		case PackChars('l', 'a'):
+			return MatchesLiteral(Str, Len, "bot-llm-started") ? EConvaiDataPacketType::BotLLMStarted : EConvaiDataPacketType::Unknown;
+		case PackChars('l', 'o'):
+			return MatchesLiteral(Str, Len, "bot-llm-stopped") ? EConvaiDataPacketType::BotLLMStopped : EConvaiDataPacketType::Unknown;
+		case PackChars('t', 'a'):
+			return MatchesLiteral(Str, Len, "bot-tts-started") ? EConvaiDataPacketType::BotTTSStarted : EConvaiDataPacketType::Unknown;
+		case PackChars('t', 'o'):
+			return MatchesLiteral(Str, Len, "bot-tts-stopped") ? EConvaiDataPacketType::BotTTSStopped : EConvaiDataPacketType::Unknown;
+		default:
+			return EConvaiDataPacketType::Unknown;
+		}
+	case 17:
+		return MatchesLiteral(Str, Len, "bot-transcription") ? EConvaiDataPacketType::BotTranscription : EConvaiDataPacketType::Unknown;
+	case 18:
+		return MatchesLiteral(Str, Len, "user-transcription") ? EConvaiDataPacketType::UserTranscription : EConvaiDataPacketType::Unknown;
+	case 20:
+		if (Str[6] == 'a')
+		{
+			return MatchesLiteral(Str, Len, "bot-started-speaking") ? EConvaiDataPacketType::BotStartedSpeaking : EConvaiDataPacketType::Unknown;
+		}
+		return MatchesLiteral(Str, Len, "bot-stopped-speaking") ? EConvaiDataPacketType::BotStoppedSpeaking : EConvaiDataPacketType::Unknown;
+	case 21:
+		if (Str[7] == 'a')
+		{
+			return MatchesLiteral(Str, Len, "user-started-speaking") ? EConvaiDataPacketType::UserStartedSpeaking : EConvaiDataPacketType::Unknown;
+		}
+		return MatchesLiteral(Str, Len, "user-stopped-speaking") ? EConvaiDataPacketType::UserStoppedSpeaking : EConvaiDataPacketType::Unknown;
+	default:
+		return EConvaiDataPacketType::Unknown;
+	}
+}
+
+EConvaiServerPacketType FConvaiDataPacketParser::ToServerPacketType(const char* Str, int32 Len)
+{
+	switch (Len)
+	{
+	case 7:
+		return MatchesLiteral(Str, Len, "visemes") ? EConvaiServerPacketType::Visemes : EConvaiServerPacketType::Unknown;
+	case 11:
+		return MatchesLiteral(Str, Len, "bot-emotion") ? EConvaiServerPacketType::BotEmotion : EConvaiServerPacketType::Unknown;
+	case 13:
+		return MatchesLiteral(Str, Len, "packed-frames") ? EConvaiServerPacketType::PackedFrames : EConvaiServerPacketType::Unknown;
+	case 15:
+		return MatchesLiteral(Str, Len, "action-response") ? EConvaiServerPacketType::ActionResponse : EConvaiServerPacketType::Unknown;
+	case 19:
+		return MatchesLiteral(Str, Len, "moderation-response") ? EConvaiServerPacketType::ModerationResponse : EConvaiServerPacketType::Unknown;
+	case 22:
+		return MatchesLiteral(Str, Len, "behavior-tree-response") ? EConvaiServerPacketType::BTResponse : EConvaiServerPacketType::Unknown;
+	default:
+		return EConvaiServerPacketType::Unknown;
+	}
+}
+
+int32 FConvaiDataPacketParser::ToVisemeIndex(const char* Str, int32 Len)
+{
+	// Indices follow ConvaiConstants::VisemeNames
+	if (Len == 1)
+	{
+		return Str[0] == 'e' ? 11 : INDEX_NONE;
+	}
+	if (Len == 3)
+	{
+		return MatchesLiteral(Str, Len, "sil") ? 0 : INDEX_NONE;
+	}
+	if (Len != 2)
+	{
+		return INDEX_NONE;
+	}
+
+	switch (PackChars(Str[0], Str[1]))
+	{
+	case PackChars('p', 'p'): return 1;
+	case PackChars('f', 'f'): return 2;
+	case PackChars('t', 'h'): return 3;
+	case PackChars('d', 'd'): return 4;
+	case PackChars('k', 'k'): return 5;
+	case PackChars('c', 'h'): return 6;
+	case PackChars('s', 's'): return 7;
+	case PackChars('n', 'n'): return 8;
+	case PackChars('r', 'r'): return 9;
+	case PackChars('a', 'a'): return 10;
+	case PackChars('i', 'h'): return 12;
+	case PackChars('o', 'h'): return 13;
+	case PackChars('o', 'u'): return 14;
+	default: return INDEX_NONE;
+	}
+}
+
+bool FConvaiDataPacketParser::DecodePackedFrames(const char* Base64, int32 Len, FConvaiPackedFrames& OutFrames)
+{
+	constexpr int32 HeaderSize = 6;
+	constexpr uint8 SupportedVersion = 1;
+
+	OutFrames.NumFrames = 0;
+	OutFrames.Values.Reset();
+
+	TArray<uint8, TInlineAllocator<2048>> Bytes;
+	if (!Base64 || !DecodeBase64(Base64, Len, Bytes) || Bytes.Num() < HeaderSize || Bytes[0] != SupportedVersion)
+	{
+		return false;
+	}
+
+	const uint8 CurveSet = Bytes[1];
+	const uint8 Quantization = Bytes[2];
+	if (CurveSet > static_cast<uint8>(EConvaiCurveSet::ARKit) || Quantization > 1)
+	{
+		return false;
+	}
+
+	const int32 NumCurves = FConvaiPackedFrames::GetNumCurves(static_cast<EConvaiCurveSet>(CurveSet));
+	const int32 NumFrames = Bytes[4] | (Bytes[5] << 8);
+	const int32 NumValues = NumFrames * NumCurves;
+	const int32 BytesPerValue = Quantization == 0 ? 1 : 2;
+	if (NumFrames == 0 || Bytes.Num() < HeaderSize + NumValues * BytesPerValue)
+	{
+		return false;
+	}
+
+	OutFrames.CurveSet = static_cast<EConvaiCurveSet>(CurveSet);
+	OutFrames.NumCurves = NumCurves;
+	OutFrames.NumFrames = NumFrames;
+	OutFrames.FrameRate = Bytes[3];
+	OutFrames.Values.SetNumUninitialized(NumValues);
+
+	const uint8* Source = Bytes.GetData() + HeaderSize;
+	float* Dest = OutFrames.Values.GetData();
+	if (Quantization == 0)
+	{
+		constexpr float Scale = 1.0f / 255.0f;
+		for (int32 Index = 0; Index < NumValues; ++Index)
+		{
+			Dest[Index] = Source[Index] * Scale;
+		}
+	}
+	else
+	{
+		for (int32 Index = 0; Index < NumValues; ++Index)
+		{
+			FFloat16 Half;
+			Half.Encoded = static_cast<uint16>(Source[2 * Index] | (Source[2 * Index + 1] << 8));
+			Dest[Index] = FMath::Clamp(Half.GetFloat(), 0.0f, 1.0f);
+		}
+	}
+	return true;
+}
+
+#if !UE_BUILD_SHIPPING
+namespace
+{
+	// Previous handling: full DOM, FString type compares and a field lookup per viseme
+	EConvaiDataPacketType DecodeWithJsonDom(const ANSICHAR* Json, float (&OutVisemes)[FConvaiDataPacket::NumVisemes])
+	{
+		static const TCHAR* VisemeKeys[FConvaiDataPacket::NumVisemes] = {
+			TEXT("sil"), TEXT("pp"), TEXT("ff"), TEXT("th"), TEXT("dd"), TEXT("kk"), TEXT("ch"), TEXT("ss"),
+			TEXT("nn"), TEXT("rr"), TEXT("aa"), TEXT("e"), TEXT("ih"), TEXT("oh"), TEXT("ou") };
+
+		const FString JsonStr = UTF8_TO_TCHAR(Json);
+		TSharedPtr<FJsonObject> Root;
+		const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonStr);
+		FString TypeStr;
+		if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid() || !Root->TryGetStringField(TEXT("type"), TypeStr))
+		{
+			return EConvaiDataPacketType::Unknown;
+		}
+
+		const FTCHARToUTF8 TypeUTF8(*TypeStr);
+		const EConvaiDataPacketType Type = FConvaiDataPacketParser::ToPacketType(TypeUTF8.Get(), TypeUTF8.Length());
+
+		const TSharedPtr<FJsonObject>* Data = nullptr;
+		const TSharedPtr<FJsonObject>* Visemes = nullptr;
+		if (Type == EConvaiDataPacketType::ServerMessage && Root->TryGetObjectField(TEXT("data"), Data) && (*Data)->TryGetObjectField(TEXT("visemes"), Visemes))
+		{
+			for (int32 Index = 0; Index < FConvaiDataPacket::NumVisemes; ++Index)
+			{
+				double Value = 0.0;
+				(*Visemes)->TryGetNumberField(VisemeKeys[Index], Value);
+				OutVisemes[Index] = FMath::Clamp(static_cast<float>(Value), 0.0f, 1.0f);
+			}
+		}
+		return Type;
+	}
+}
+
+static FAutoConsoleCommand ConvaiBenchmarkPacketParserCommand(
+	TEXT("Convai.Packets.BenchmarkParser"),
+	TEXT("Compares FConvaiDataPacketParser with FJsonSerializer on data packets. CaptureFile is a log with one packet per line (the VeryVerbose \"Data packet received\" lines), built-in samples are used without it. Usage: Convai.Packets.BenchmarkParser [Iterations] [CaptureFile]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic([](const TArray<FString>& Args)
+	{
+		const int32 Iterations = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 1000;
+		if (Iterations <= 0)
+		{
+			return;
+		}
+
+		TArray<FString> Lines;
+		if (Args.Num() > 1)
+		{
+			if (!FFileHelper::LoadFileToStringArray(Lines, *Args[1]))
+			{
+				CONVAI_LOG(ConvaiDataPacketLog, Warning, TEXT("Could not read capture file %s"), *Args[1]);
+				return;
+			}
+		}
+		else
+		{
+			Lines.Add(TEXT("{\"type\":\"server-message\",\"data\":{\"type\":\"visemes\",\"visemes\":{\"sil\":0.02,\"pp\":0.0,\"ff\":0.01,\"th\":0.0,\"dd\":0.12,\"kk\":0.05,\"ch\":0.0,\"ss\":0.31,\"nn\":0.07,\"rr\":0.0,\"aa\":0.44,\"e\":0.18,\"ih\":0.09,\"oh\":0.0,\"ou\":0.03}}}"));
+			Lines.Add(TEXT("{\"type\":\"bot-transcription\",\"data\":{\"text\":\"Hello there, traveler! What brings you to the village today?\"}}"));
+			Lines.Add(TEXT("{\"type\":\"user-transcription\",\"data\":{\"text\":\"Where can I find the blacksmith?\",\"final\":true,\"timestamp\":\"2025-01-01T12:00:00.000Z\"}}"));
+			Lines.Add(TEXT("{\"type\":\"server-message\",\"data\":{\"type\":\"bot-emotion\",\"emotion\":\"joy\",\"scale\":2}}"));
+			Lines.Add(TEXT("{\"type\":\"bot-started-speaking\"}"));
+		}
+
+		// Packets are taken from the first '{' of each line so raw log lines can be fed in
+		TArray<TArray<ANSICHAR>> Packets;
+		for (const FString& Line : Lines)
+		{
+			const int32 JsonStart = Line.Find(TEXT("{"));
+			if (JsonStart == INDEX_NONE)
+			{
+				continue;
+			}
+			const FTCHARToUTF8 Converted(*Line + JsonStart);
+			TArray<ANSICHAR>& Packet = Packets.AddDefaulted_GetRef();
+			Packet.Append(Converted.Get(), Converted.Length());
+			Packet.Add('\0');
+		}
+
+		if (Packets.Num() == 0)
+		{
+			CONVAI_LOG(ConvaiDataPacketLog, Warning, TEXT("No packets to benchmark"));
+			return;
+		}
+
+		// Both paths must agree before their timings mean anything
+		int32 NumMismatches = 0;
+		for (const TArray<ANSICHAR>& Packet : Packets)
+		{
+			float DomVisemes[FConvaiDataPacket::NumVisemes] = {};
+			FConvaiDataPacket Parsed;
+			FConvaiDataPacketParser::Parse(Packet.GetData(), Packet.Num() - 1, Parsed);
+			const bool bSameType = DecodeWithJsonDom(Packet.GetData(), DomVisemes) == Parsed.Type;
+			const bool bSameVisemes = FMemory::Memcmp(DomVisemes, Parsed.Visemes, sizeof(DomVisemes)) == 0;
+			NumMismatches += (bSameType && bSameVisemes) ? 0 : 1;
+		}
+
+		const double DomStart = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			for (const TArray<ANSICHAR>& Packet : Packets)
+			{
+				float DomVisemes[FConvaiDataPacket::NumVisemes];
+				DecodeWithJsonDom(Packet.GetData(), DomVisemes);
+			}
+		}
+		const double DomSeconds = FPlatformTime::Seconds() - DomStart;
+
+		const double ParserStart = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			for (const TArray<ANSICHAR>& Packet : Packets)
+			{
+				FConvaiDataPacket Parsed;
+				FConvaiDataPacketParser::Parse(Packet.GetData(), Packet.Num() - 1, Parsed);
+			}
+		}
+		const double ParserSeconds = FPlatformTime::Seconds() - ParserStart;
+
+		const double NumParsed = static_cast<double>(Iterations) * Packets.Num();
+		CONVAI_LOG(ConvaiDataPacketLog, Display, TEXT("Packet parser benchmark, %d packets x %d: FJsonSerializer %.3f us/packet, FConvaiDataPacketParser %.3f us/packet, %d mismatches"),
+			Packets.Num(), Iterations, DomSeconds * 1e6 / NumParsed, ParserSeconds * 1e6 / NumParsed, NumMismatches);
+	}));
+#endif
@@ -5,9 +5,18 @@
 #include "ConvaiConnectionInterface.h"
 #include "ConvaiConnectionSessionProxy.h"
 #include "ConvaiUtils.h"
+#include "Misc/ScopeLock.h"
 
 DEFINE_LOG_CATEGORY(ConvaiDefinitionsLog);
 
+namespace
+{
+	// Characters whose server answered a packed frame request with JSON frames, and the format that was requested.
+	// An entry only holds while LipSyncFrameFormat still asks for that format
+	FCriticalSection PackedFramesFallbackMutex;
+	TMap<FString, EConvaiFrameFormat> PackedFramesFallbacks;
+}
+
 const TMap<EEmotionIntensity, float> FConvaiEmotionState::ScoreMultipliers = 
 {
 	{EEmotionIntensity::None, 0.0},
@@ -18,11 +27,6 @@ const TMap<EEmotionIntensity, float> FConvaiEmotionState::ScoreMultipliers =
 
 FConvaiConnectionParams FConvaiConnectionParams::Create(convai::ConvaiClient* InClient, const FString& InCharacterID, UConvaiConnectionSessionProxy* SessionProxy)
 {
-	FConvaiConnectionParams Params;
-	Params.Client = InClient;
-	Params.CharacterID = InCharacterID;
-	Params.LLMProvider = UConvaiUtils::GetLLMProvider();
-	
 	// Get interface once and reuse it
 	IConvaiConnectionInterface* Interface = nullptr;
 	if (SessionProxy)
@@ -32,6 +36,16 @@ FConvaiConnectionParams FConvaiConnectionParams::Create(convai::ConvaiClient* In
 			Interface = InterfaceScriptInterface.GetInterface();
 		}
 	}
+
+	return Create(InClient, InCharacterID, Interface);
+}
+
+FConvaiConnectionParams FConvaiConnectionParams::Create(convai::ConvaiClient* InClient, const FString& InCharacterID, IConvaiConnectionInterface* Interface)
+{
+	FConvaiConnectionParams Params;
+	Params.Client = InClient;
+	Params.CharacterID = InCharacterID;
+	Params.LLMProvider = UConvaiUtils::GetLLMProvider();
 	
 	// Determine connection type
 	Params.ConnectionType = UConvaiUtils::GetConnectionType();
@@ -84,6 +98,37 @@ FConvaiConnectionParams FConvaiConnectionParams::Create(convai::ConvaiClient* In
 		break;
 	}
 	
+	// Packed lipsync frames are opt-in until every server deployment sends them
+	FString FrameFormatSetting;
+	if (Params.BlendshapeProvider != TEXT("not_provided")
+		&& UConvaiSettingsUtils::GetParamValueAsString(TEXT("LipSyncFrameFormat"), FrameFormatSetting))
+	{
+		if (FrameFormatSetting.Equals(TEXT("PackedU8"), ESearchCase::IgnoreCase))
+		{
+			Params.FrameFormat = EConvaiFrameFormat::PackedU8;
+		}
+		else if (FrameFormatSetting.Equals(TEXT("PackedF16"), ESearchCase::IgnoreCase))
+		{
+			Params.FrameFormat = EConvaiFrameFormat::PackedF16;
+		}
+	}
+
+	// A fallback recorded for another format is stale, the setting changed since
+	{
+		FScopeLock Lock(&PackedFramesFallbackMutex);
+		if (const EConvaiFrameFormat* FallbackFormat = PackedFramesFallbacks.Find(InCharacterID))
+		{
+			if (*FallbackFormat == Params.FrameFormat)
+			{
+				Params.FrameFormat = EConvaiFrameFormat::Json;
+			}
+			else
+			{
+				PackedFramesFallbacks.Remove(InCharacterID);
+			}
+		}
+	}
+	
 	// Get speaker ID from interface
 	if (Interface)
 	{
@@ -92,4 +137,211 @@ FConvaiConnectionParams FConvaiConnectionParams::Create(convai::ConvaiClient* In
 	}
 	
 	return Params;
+}
+
+void FConvaiConnectionParams::DisablePackedFrames(const FString& InCharacterID, const EConvaiFrameFormat RequestedFormat)
+{
+	if (RequestedFormat == EConvaiFrameFormat::Json)
+	{
+		return;
+	}
+
+	FScopeLock Lock(&PackedFramesFallbackMutex);
+	const EConvaiFrameFormat* FallbackFormat = PackedFramesFallbacks.Find(InCharacterID);
+	if (!FallbackFormat || *FallbackFormat != RequestedFormat)
+	{
+		PackedFramesFallbacks.Add(InCharacterID, RequestedFormat);
+		CONVAI_LOG(ConvaiDefinitionsLog, Warning, TEXT("The server answered a packed lipsync frame request with JSON frames, later connections to character %s request JSON frames"), *InCharacterID);
+	}
+}
+
+FString FConvaiConnectionParams::GetNegotiatedBlendshapeProvider() const
+{
+	switch (FrameFormat)
+	{
+	case EConvaiFrameFormat::PackedU8:
+		return BlendshapeProvider + TEXT(";frame_format=packed_u8");
+	case EConvaiFrameFormat::PackedF16:
+		return BlendshapeProvider + TEXT(";frame_format=packed_f16");
+	default:
+		return BlendshapeProvider;
+	}
+}
+
+int32 FConvaiPackedFrames::GetNumCurves(const EConvaiCurveSet InCurveSet)
+{
+	return GetCurveNames(InCurveSet).Num();
+}
+
+const TArray<FName>& FConvaiPackedFrames::GetCurveNames(const EConvaiCurveSet InCurveSet)
+{
+	struct FCurveNameTables
+	{
+		TArray<FName> Visemes;
+		TArray<FName> ARKit;
+
+		FCurveNameTables()
+		{
+			for (const FString& Name : ConvaiConstants::VisemeNames)
+			{
+				Visemes.Add(FName(*Name));
+			}
+			for (const FString& Name : ConvaiConstants::BlendShapesNames)
+			{
+				ARKit.Add(FName(*Name));
+			}
+		}
+	};
+	static const FCurveNameTables Tables;
+
+	return InCurveSet == EConvaiCurveSet::ARKit ? Tables.ARKit : Tables.Visemes;
+}
+
+void FConvaiPackedFrames::Reset(const EConvaiCurveSet InCurveSet)
+{
+	CurveSet = InCurveSet;
+	NumCurves = GetNumCurves(InCurveSet);
+	NumFrames = 0;
+	Values.Reset();
+}
+
+float* FConvaiPackedFrames::AddFrame()
+{
+	if (NumCurves == 0)
+	{
+		NumCurves = GetNumCurves(CurveSet);
+	}
+
+	const int32 FirstValue = Values.AddZeroed(NumCurves);
+	++NumFrames;
+	return Values.GetData() + FirstValue;
+}
+
+void FConvaiPackedFrames::Append(const FConvaiPackedFrames& Other)
+{
+	check(IsEmpty() || Other.IsEmpty() || Other.CurveSet == CurveSet);
+	if (Other.IsEmpty())
+	{
+		return;
+	}
+
+	if (IsEmpty())
+	{
+		CurveSet = Other.CurveSet;
+		NumCurves = Other.NumCurves;
+	}
+	Values.Append(Other.Values.GetData(), Other.NumFrames * Other.NumCurves);
+	NumFrames += Other.NumFrames;
+	if (Other.FrameRate > 0)
+	{
+		FrameRate = Other.FrameRate;
+	}
+}
+
+void FConvaiPackedFrames::RemoveFrames(const int32 FrameIndex, const int32 Count)
+{
+	check(FrameIndex >= 0 && Count >= 0 && FrameIndex + Count <= NumFrames);
+	if (Count > 0)
+	{
+#if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 5
+		Values.RemoveAt(FrameIndex * NumCurves, Count * NumCurves, EAllowShrinking::No);
+#else
+		Values.RemoveAt(FrameIndex * NumCurves, Count * NumCurves, false);
+#endif
+		NumFrames -= Count;
+	}
+}
+
+void FConvaiPackedFrames::FrameToMap(const EConvaiCurveSet InCurveSet, const float* Weights, TMap<FName, float>& OutBlendShapes)
+{
+	const TArray<FName>& CurveNames = GetCurveNames(InCurveSet);
+	const int32 NumCurveNames = CurveNames.Num();
+
+	OutBlendShapes.Reset();
+	OutBlendShapes.Reserve(NumCurveNames);
+	for (int32 CurveIndex = 0; CurveIndex < NumCurveNames; ++CurveIndex)
+	{
+		OutBlendShapes.Add(CurveNames[CurveIndex], Weights[CurveIndex]);
+	}
+}
+
+void FConvaiPackedFrames::MapToFrame(const TMap<FName, float>& BlendShapes, const EConvaiCurveSet InCurveSet, float* OutWeights)
+{
+	const TArray<FName>& CurveNames = GetCurveNames(InCurveSet);
+	const int32 NumCurveNames = CurveNames.Num();
+	for (int32 CurveIndex = 0; CurveIndex < NumCurveNames; ++CurveIndex)
+	{
+		const float* Weight = BlendShapes.Find(CurveNames[CurveIndex]);
+		OutWeights[CurveIndex] = Weight ? *Weight : 0.0f;
+	}
+}
+
+void FConvaiPackedFrames::AppendFrame(const EConvaiCurveSet InCurveSet, const float* Weights, const int32 FrameIndex, FAnimationSequence& OutSequence)
+{
+	FAnimationFrame& AnimationFrame = OutSequence.AnimationFrames.AddDefaulted_GetRef();
+	AnimationFrame.FrameIndex = FrameIndex;
+	FrameToMap(InCurveSet, Weights, AnimationFrame.BlendShapes);
+}
+
+void FAnimationSequence::AppendFrames(const FAnimationSequence& Other)
+{
+	if (Other.GetNumFrames() == 0)
+	{
+		return;
+	}
+
+	if (Other.IsPacked() && AnimationFrames.Num() == 0 && (PackedFrames.IsEmpty() || PackedFrames.CurveSet == Other.PackedFrames.CurveSet))
+	{
+		PackedFrames.Append(Other.PackedFrames);
+		return;
+	}
+
+	// Mixed representations or curve sets, fall back to name-keyed frames
+	ExpandPackedFrames();
+	if (Other.IsPacked())
+	{
+		FAnimationSequence OtherExpanded = Other;
+		OtherExpanded.ExpandPackedFrames();
+		AnimationFrames.Append(MoveTemp(OtherExpanded.AnimationFrames));
+	}
+	else
+	{
+		AnimationFrames.Append(Other.AnimationFrames);
+	}
+}
+
+void FAnimationSequence::ExpandPackedFrames()
+{
+	if (!IsPacked())
+	{
+		return;
+	}
+
+	AnimationFrames.Reserve(AnimationFrames.Num() + PackedFrames.NumFrames);
+	for (int32 FrameIndex = 0; FrameIndex < PackedFrames.NumFrames; ++FrameIndex)
+	{
+		FConvaiPackedFrames::AppendFrame(PackedFrames.CurveSet, PackedFrames.GetFrame(FrameIndex), FrameIndex, *this);
+	}
+	PackedFrames.Reset(PackedFrames.CurveSet);
+}
+
+void FAnimationSequence::PackFrames(const EConvaiCurveSet InCurveSet)
+{
+	if (IsPacked())
+	{
+		if (PackedFrames.CurveSet == InCurveSet)
+		{
+			return;
+		}
+		ExpandPackedFrames();
+	}
+
+	PackedFrames.Reset(InCurveSet);
+	PackedFrames.FrameRate = FrameRate;
+	PackedFrames.Values.Reserve(AnimationFrames.Num() * PackedFrames.NumCurves);
+	for (const FAnimationFrame& Frame : AnimationFrames)
+	{
+		FConvaiPackedFrames::MapToFrame(Frame.BlendShapes, InCurveSet, PackedFrames.AddFrame());
+	}
+	AnimationFrames.Empty();
 }
\ No newline at end of file
@@ -1,13 +1,27 @@
 // Copyright 2022 Convai Inc. All Rights Reserved.
 
 #include "ConvaiFaceSync.h"
+#include "Math/VectorRegister.h"
 #include "Misc/ScopeLock.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Async/ParallelFor.h"
+#include "Containers/Ticker.h"
 #include "ConvaiUtils.h"
 
 DEFINE_LOG_CATEGORY(ConvaiFaceSyncLog);
 
 namespace
 {
+#if ENGINE_MAJOR_VERSION >= 5
+	using FConvaiVectorRegister = VectorRegister4Float;
+#else
+	using FConvaiVectorRegister = VectorRegister;
+#endif
+
+	// Consumed frames are trimmed in batches, so the remaining window is only moved every half second or so
+	constexpr int32 TrimThresholdFrames = 32;
+
 	// Helper function: Creates a zero blendshapes map
 	TMap<FName, float> CreateZeroBlendshapes()
 	{
@@ -31,6 +45,121 @@ namespace
 		return ZeroVisemes;
 	}
 
+	// Helper function: Packs a zero frame in curve-set order, runs during static init so it can't use the FConvaiPackedFrames tables
+	TArray<float> CreateZeroWeights(const TMap<FName, float>& ZeroFrame, const TArray<FString>& CurveNames)
+	{
+		TArray<float> ZeroWeights;
+		ZeroWeights.Reserve(CurveNames.Num());
+		for (const FString& CurveName : CurveNames)
+		{
+			ZeroWeights.Add(ZeroFrame.FindRef(*CurveName));
+		}
+		return ZeroWeights;
+	}
+
+	void CopyFrame(TArray<float>& OutFrame, const float* Frame, const int32 NumCurves)
+	{
+		OutFrame.SetNumUninitialized(NumCurves);
+		FMemory::Memcpy(OutFrame.GetData(), Frame, NumCurves * sizeof(float));
+	}
+
+#if ENGINE_MAJOR_VERSION >= 5
+	using FConvaiTickerHandle = FTSTicker::FDelegateHandle;
+#else
+	using FConvaiTickerHandle = FDelegateHandle;
+#endif
+
+	/**
+	 * Evaluates every face sync component with bParallelEvaluation set in one ParallelFor pass per frame,
+	 * so the game thread pays for one dispatch rather than one tick per talking character.
+	 * Game thread only.
+	 */
+	class FConvaiLipSyncBatch
+	{
+	public:
+		static FConvaiLipSyncBatch& Get()
+		{
+			static FConvaiLipSyncBatch Batch;
+			return Batch;
+		}
+
+		void Register(UConvaiFaceSyncComponent* Component)
+		{
+			check(IsInGameThread());
+			Components.AddUnique(Component);
+			if (!TickerHandle.IsValid())
+			{
+#if ENGINE_MAJOR_VERSION >= 5
+				TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FConvaiLipSyncBatch::Tick));
+#else
+				TickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FConvaiLipSyncBatch::Tick));
+#endif
+			}
+		}
+
+		void Unregister(UConvaiFaceSyncComponent* Component)
+		{
+			check(IsInGameThread());
+			Components.Remove(Component);
+			if (Components.Num() == 0 && TickerHandle.IsValid())
+			{
+#if ENGINE_MAJOR_VERSION >= 5
+				FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+#else
+				FTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+#endif
+				TickerHandle.Reset();
+			}
+		}
+
+	private:
+		bool Tick(float DeltaTime)
+		{
+			Evaluating.Reset();
+			for (const TWeakObjectPtr<UConvaiFaceSyncComponent>& Component : Components)
+			{
+				UConvaiFaceSyncComponent* Resolved = Component.Get();
+
+				// The core ticker keeps running while paused, a ticking component would not
+				const UWorld* World = Resolved ? Resolved->GetWorld() : nullptr;
+				if (World && !World->IsPaused())
+				{
+					// Subclass hooks are only read here on the game thread, never from the workers
+					Resolved->RefreshCurveLayout();
+					Evaluating.Add(Resolved);
+				}
+			}
+
+			// Same clock and offset for every character, the offset lookup parses the command line
+			const double CurrentTime = FPlatformTime::Seconds();
+			const double TimeOffset = UConvaiUtils::GetLipSyncTimeOffset();
+			Evaluated.SetNumZeroed(Evaluating.Num());
+			ParallelFor(Evaluating.Num(), [this, CurrentTime, TimeOffset](int32 Index)
+			{
+				Evaluated[Index] = Evaluating[Index]->EvaluateLipSync(CurrentTime, TimeOffset);
+			});
+
+			// Post-processing may touch the actor or other UObjects, so it runs here on the game thread
+			for (int32 Index = 0; Index < Evaluating.Num(); ++Index)
+			{
+				if (Evaluated[Index])
+				{
+					Evaluating[Index]->PublishEvaluatedFrame();
+				}
+				else
+				{
+					Evaluating[Index]->PublishSequenceEnd();
+				}
+			}
+			return true;
+		}
+
+		TArray<TWeakObjectPtr<UConvaiFaceSyncComponent>> Components;
+		TArray<UConvaiFaceSyncComponent*> Evaluating;
+		TArray<bool> Evaluated;
+		FConvaiTickerHandle TickerHandle;
+	};
+
 
 	float Calculate1DBezierCurve(float t, float P0, float P1, float P2, float P3)
 	{
@@ -48,6 +177,8 @@ namespace
 
 const TMap<FName, float> UConvaiFaceSyncComponent::ZeroBlendshapeFrame = CreateZeroBlendshapes();
 const TMap<FName, float> UConvaiFaceSyncComponent::ZeroVisemeFrame = CreateZeroVisemes();
+const TArray<float> UConvaiFaceSyncComponent::ZeroBlendshapeWeights = CreateZeroWeights(UConvaiFaceSyncComponent::ZeroBlendshapeFrame, ConvaiConstants::BlendShapesNames);
+const TArray<float> UConvaiFaceSyncComponent::ZeroVisemeWeights = CreateZeroWeights(UConvaiFaceSyncComponent::ZeroVisemeFrame, ConvaiConstants::VisemeNames);
 
 UConvaiFaceSyncComponent::UConvaiFaceSyncComponent()
 {
@@ -57,7 +188,6 @@ UConvaiFaceSyncComponent::UConvaiFaceSyncComponent()
 	bIsPaused = false;
 	PauseStartTime = 0;
 	TotalPausedDuration = 0;
-	//CurrentBlendShapesMap = ZeroBlendshapeFrame;
 }
 
 UConvaiFaceSyncComponent::~UConvaiFaceSyncComponent() // Implement destructor
@@ -68,7 +198,25 @@ UConvaiFaceSyncComponent::~UConvaiFaceSyncComponent() // Implement destructor
 void UConvaiFaceSyncComponent::BeginPlay()
 {
 	Super::BeginPlay();
-	CurrentBlendShapesMap = GenerateZeroFrame();
+	RefreshCurveLayout();
+	CurrentFrame = GetZeroFrame();
+	FrameSource->Publish(GetCurveSet(), CurrentFrame.GetData(), CurrentFrame.Num(), false, GFrameCounter);
+
+	if (bParallelEvaluation)
+	{
+		SetComponentTickEnabled(false);
+		FConvaiLipSyncBatch::Get().Register(this);
+	}
+}
+
+void UConvaiFaceSyncComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (bParallelEvaluation)
+	{
+		FConvaiLipSyncBatch::Get().Unregister(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void UConvaiFaceSyncComponent::TickComponent(float DeltaTime, ELevelTick TickType,
@@ -76,22 +224,37 @@ void UConvaiFaceSyncComponent::TickComponent(float DeltaTime, ELevelTick TickTyp
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
+	RefreshCurveLayout();
+	if (EvaluateLipSync(FPlatformTime::Seconds(), UConvaiUtils::GetLipSyncTimeOffset()))
+	{
+		PublishEvaluatedFrame();
+
+		// Trigger the blueprint event
+		OnFacialDataReady.ExecuteIfBound();
+	}
+	else
+	{
+		PublishSequenceEnd();
+	}
+}
+
+bool UConvaiFaceSyncComponent::EvaluateLipSync(double CurrentTime, double TimeOffset)
+{
 	// Interpolate blendshapes and advance animation sequence
-	if (IsValidSequence(MainSequenceBuffer))
+	if (IsValidSequence(MainSequenceBuffer) && bHasCurveLayout)
 	{
 		// Skip processing if paused
 		if (bIsPaused)
 		{
-			return;
+			return false;
 		}
 
 		SequenceCriticalSection.Lock();
 
 		// Calculate time passed since ConvaiProcessLipSyncAdvanced was called
 		// Subtract the total paused duration to maintain continuity
-		double CurrentTime = FPlatformTime::Seconds();
 		CurrentSequenceTimePassed = (CurrentTime - StartTime) - TotalPausedDuration;
-		CurrentSequenceTimePassed += UConvaiUtils::GetLipSyncTimeOffset();
+		CurrentSequenceTimePassed += TimeOffset;
 		CurrentSequenceTimePassed = FMath::Max(0.0, CurrentSequenceTimePassed);
 
 		if (CurrentSequenceTimePassed > MainSequenceBuffer.Duration)
@@ -99,88 +262,148 @@ void UConvaiFaceSyncComponent::TickComponent(float DeltaTime, ELevelTick TickTyp
 			 CONVAI_LOG(ConvaiFaceSyncLog, Log, TEXT("Tick: Can't play lipsync - CurrentSequenceTimePassed: %f - MainSequenceBuffer.Duration: %f"), CurrentSequenceTimePassed, MainSequenceBuffer.Duration);
 
 			SequenceCriticalSection.Unlock();
-			return;
+			bPlayheadPastEnd = true;
+			return false;
 		}
 
 		bIsPlaying = true;
+		bPlayheadPastEnd = false;
+
+		// Frames are still in the other curve set if the face data type was switched while talking.
+		// The layout was refreshed on the game thread, GetCurveSet is not called from workers
+		const EConvaiCurveSet CurveSet = LayoutCurveSet;
+		MainSequenceBuffer.PackFrames(CurveSet);
+		const FConvaiPackedFrames& Frames = MainSequenceBuffer.PackedFrames;
+		const int32 NumFrames = Frames.NumFrames;
+		const int32 NumCurves = Frames.NumCurves;
+		if (CurrentFrame.Num() != NumCurves)
+		{
+			CurrentFrame = ZeroFrameWeights;
+		}
 
 		// Calculate frame duration and offsets
-		float FrameDuration = MainSequenceBuffer.Duration / MainSequenceBuffer.AnimationFrames.Num();
+		float FrameDuration = MainSequenceBuffer.Duration / NumFrames;
 		float FrameOffset = FrameDuration * 0.5f;
-		int32 FrameIndex;
 		int32 BufferIndex;
-
-		TMap<FName, float> StartFrame;
-		TMap<FName, float> EndFrame;
 		float Alpha;
 
-		// Choose the current and next BlendShapes
+		// Choose the current and next frames, copied so the lock is only held for the copy
 		if (CurrentSequenceTimePassed <= FrameOffset)
 		{
-			//StartFrame = ZeroBlendshapeFrame;
-			StartFrame = GetCurrentFrame();
-			EndFrame = MainSequenceBuffer.AnimationFrames[0].BlendShapes;
+			CopyFrame(StartFrameWeights, CurrentFrame.GetData(), NumCurves);
+			CopyFrame(EndFrameWeights, Frames.GetFrame(0), NumCurves);
 			Alpha = CurrentSequenceTimePassed / FrameOffset + 0.5;
-			FrameIndex = MainSequenceBuffer.AnimationFrames[0].FrameIndex;
 			BufferIndex = 0;
 		}
 		else if (CurrentSequenceTimePassed >= MainSequenceBuffer.Duration - FrameOffset)
 		{
-			int LastFrameIdx = MainSequenceBuffer.AnimationFrames.Num() - 1;
-			StartFrame = MainSequenceBuffer.AnimationFrames[LastFrameIdx].BlendShapes;
-			EndFrame = GenerateZeroFrame();
+			int LastFrameIdx = NumFrames - 1;
+			CopyFrame(StartFrameWeights, Frames.GetFrame(LastFrameIdx), NumCurves);
+			CopyFrame(EndFrameWeights, ZeroFrameWeights.GetData(), NumCurves);
 			Alpha = (CurrentSequenceTimePassed - (MainSequenceBuffer.Duration - FrameOffset)) / FrameOffset;
-			FrameIndex = MainSequenceBuffer.AnimationFrames[LastFrameIdx].FrameIndex;
 			BufferIndex = LastFrameIdx;
 		}
 		else
 		{
 			int CurrentFrameIndex = FMath::FloorToInt((CurrentSequenceTimePassed - FrameOffset) / FrameDuration);
-			CurrentFrameIndex = FMath::Min(CurrentFrameIndex, MainSequenceBuffer.AnimationFrames.Num() - 1);
-			int NextFrameIndex = FMath::Min(CurrentFrameIndex + 1, MainSequenceBuffer.AnimationFrames.Num() - 1);
-			StartFrame = MainSequenceBuffer.AnimationFrames[CurrentFrameIndex].BlendShapes;
-			EndFrame = MainSequenceBuffer.AnimationFrames[NextFrameIndex].BlendShapes;
+			CurrentFrameIndex = FMath::Min(CurrentFrameIndex, NumFrames - 1);
+			int NextFrameIndex = FMath::Min(CurrentFrameIndex + 1, NumFrames - 1);
+			CopyFrame(StartFrameWeights, Frames.GetFrame(CurrentFrameIndex), NumCurves);
+			CopyFrame(EndFrameWeights, Frames.GetFrame(NextFrameIndex), NumCurves);
 			Alpha = (CurrentSequenceTimePassed - FrameOffset - (CurrentFrameIndex * FrameDuration)) / FrameDuration;
 
-			Apply_StartEndFrames_PostProcessing(CurrentFrameIndex, NextFrameIndex, Alpha, StartFrame, EndFrame);
+			Apply_StartEndFrames_PostProcessing(CurrentFrameIndex, NextFrameIndex, Alpha, StartFrameWeights, EndFrameWeights);
 
-			FrameIndex = MainSequenceBuffer.AnimationFrames[CurrentFrameIndex].FrameIndex;
 			BufferIndex = CurrentFrameIndex;
+
+			if (CurrentFrameIndex >= TrimThresholdFrames)
+			{
+				TrimConsumedFrames(CurrentFrameIndex, FrameDuration);
+				BufferIndex = 0;
+			}
 		}
 		SequenceCriticalSection.Unlock();
 
-		// CONVAI_LOG(ConvaiFaceSyncLog, Log, TEXT("Evaluate: FrameIndex:%d Alpha: %f FramesLeft: %d"), FrameIndex, Alpha, MainSequenceBuffer.AnimationFrames.Num() - BufferIndex);
+		// CONVAI_LOG(ConvaiFaceSyncLog, Log, TEXT("Evaluate: BufferIndex:%d Alpha: %f FramesLeft: %d"), BufferIndex, Alpha, MainSequenceBuffer.GetNumFrames() - BufferIndex);
 
 		// Apply interpolation if enabled, otherwise just use the end frame for better performance
 		if (bEnableInterpolation)
 		{
-			CurrentBlendShapesMap = InterpolateFrames(StartFrame, EndFrame, Alpha);
+			InterpolateFrames(StartFrameWeights.GetData(), EndFrameWeights.GetData(), Alpha, CurrentFrame.GetData(), NumCurves);
 		}
 		else
 		{
-			CurrentBlendShapesMap = EndFrame;
+			CurrentFrame = EndFrameWeights;
+		}
+
+		// Curves GetCurveNames leaves out stay at rest
+		if (CurveMask.Num() == NumCurves)
+		{
+			for (int32 CurveIndex = 0; CurveIndex < NumCurves; ++CurveIndex)
+			{
+				CurrentFrame[CurveIndex] *= CurveMask[CurveIndex];
+			}
 		}
 
-		ApplyPostProcessing();
+		return true;
+	}
+	return false;
+}
 
-		// Trigger the blueprint event
-		OnFacialDataReady.ExecuteIfBound();
+void UConvaiFaceSyncComponent::PublishEvaluatedFrame()
+{
+	check(IsInGameThread());
+
+	ApplyPostProcessing();
+	FrameSource->Publish(GetCurveSet(), CurrentFrame.GetData(), CurrentFrame.Num(), true, GFrameCounter);
+	bPublishedPlaying = true;
+}
+
+void UConvaiFaceSyncComponent::PublishSequenceEnd()
+{
+	check(IsInGameThread());
+
+	// Once per reply, the sequence stays valid in case more frames stream in
+	if (!bPlayheadPastEnd || !bPublishedPlaying)
+	{
+		return;
 	}
+
+	FrameSource->Publish(GetCurveSet(), GetZeroFrame().GetData(), GetZeroFrame().Num(), false, GFrameCounter);
+	bPublishedPlaying = false;
+}
+
+TMap<FName, float> UConvaiFaceSyncComponent::GetLatestLipSyncFrame(bool& bIsLipSyncPlaying) const
+{
+	FConvaiLipSyncSnapshot Snapshot;
+	FrameSource->Read(Snapshot);
+	bIsLipSyncPlaying = Snapshot.bIsPlaying;
+
+	TMap<FName, float> BlendShapes;
+	if (Snapshot.Weights.Num() == FConvaiPackedFrames::GetNumCurves(Snapshot.CurveSet))
+	{
+		FConvaiPackedFrames::FrameToMap(Snapshot.CurveSet, Snapshot.Weights.GetData(), BlendShapes);
+	}
+	return BlendShapes;
 }
 
 void UConvaiFaceSyncComponent::ConvaiApplyPrecomputedFacialAnimation(uint8* InPCMData, uint32 InPCMDataSize, uint32 InSampleRate, uint32 InNumChannels, FAnimationSequence FaceSequence)
 {
+	// Everything is kept packed against this component's curve set, name-keyed frames are converted once here
+	FaceSequence.PackFrames(GetCurveSet());
+
 	SequenceCriticalSection.Lock();
-	MainSequenceBuffer.AnimationFrames.Append(FaceSequence.AnimationFrames);
+	MainSequenceBuffer.AppendFrames(FaceSequence);
 	MainSequenceBuffer.Duration += FaceSequence.Duration;
 	MainSequenceBuffer.FrameRate = FaceSequence.FrameRate;
+	PeakBufferedFrames = FMath::Max(PeakBufferedFrames, MainSequenceBuffer.GetNumFrames());
 	CalculateStartingTime();
 	SequenceCriticalSection.Unlock();
 
 	if (IsRecordingLipSync)
 	{
 		FScopeLock ScopeLock(&RecordingCriticalSection);
-		RecordedSequenceBuffer.AnimationFrames.Append(FaceSequence.AnimationFrames);
+		RecordedSequenceBuffer.AppendFrames(FaceSequence);
 		RecordedSequenceBuffer.Duration += FaceSequence.Duration;
 		RecordedSequenceBuffer.FrameRate = FaceSequence.FrameRate;
 	}
@@ -188,7 +411,6 @@ void UConvaiFaceSyncComponent::ConvaiApplyPrecomputedFacialAnimation(uint8* InPC
 
 void UConvaiFaceSyncComponent::ConvaiApplyFacialFrame(FAnimationFrame FaceFrame, float Duration)
 {
-	SequenceCriticalSection.Lock();
 	if (!GeneratesFacialDataAsBlendshapes())
 	{
 		float* sil = FaceFrame.BlendShapes.Find("sil");
@@ -200,15 +422,21 @@ void UConvaiFaceSyncComponent::ConvaiApplyFacialFrame(FAnimationFrame FaceFrame,
 		}
 	}
 
-	MainSequenceBuffer.AnimationFrames.Add(FaceFrame);
+	FAnimationSequence FaceSequence;
+	FaceSequence.AnimationFrames.Add(MoveTemp(FaceFrame));
+	FaceSequence.PackFrames(GetCurveSet());
+
+	SequenceCriticalSection.Lock();
+	MainSequenceBuffer.AppendFrames(FaceSequence);
 	MainSequenceBuffer.Duration += Duration;
 	MainSequenceBuffer.FrameRate = Duration==0? -1 : 1.0/Duration;
+	PeakBufferedFrames = FMath::Max(PeakBufferedFrames, MainSequenceBuffer.GetNumFrames());
 	SequenceCriticalSection.Unlock();
 
 	if (IsRecordingLipSync)
 	{
 		FScopeLock ScopeLock(&RecordingCriticalSection);
-		RecordedSequenceBuffer.AnimationFrames.Add(FaceFrame);
+		RecordedSequenceBuffer.AppendFrames(FaceSequence);
 		RecordedSequenceBuffer.Duration += Duration;
 		RecordedSequenceBuffer.FrameRate = Duration == 0 ? -1 : 1.0 / Duration;
 	}
@@ -228,7 +456,7 @@ void UConvaiFaceSyncComponent::StartRecordingLipSync()
 
 FAnimationSequenceBP UConvaiFaceSyncComponent::FinishRecordingLipSync()
 {
-	CONVAI_LOG(ConvaiFaceSyncLog, Log, TEXT("Finished Recording LipSync - Total Frames: %d - Duration: %f"), RecordedSequenceBuffer.AnimationFrames.Num(), RecordedSequenceBuffer.Duration);
+	CONVAI_LOG(ConvaiFaceSyncLog, Log, TEXT("Finished Recording LipSync - Total Frames: %d - Duration: %f"), RecordedSequenceBuffer.GetNumFrames(), RecordedSequenceBuffer.Duration);
 
 	if (!IsRecordingLipSync)
 		return FAnimationSequenceBP();
@@ -236,15 +464,18 @@ FAnimationSequenceBP UConvaiFaceSyncComponent::FinishRecordingLipSync()
 	FScopeLock ScopeLock(&RecordingCriticalSection);
 	IsRecordingLipSync = false;
 
+	// Blueprint only sees the reflected, name-keyed frames
 	FAnimationSequenceBP AnimationSequenceBP;
-	AnimationSequenceBP.AnimationSequence = RecordedSequenceBuffer;
-	RecordedSequenceBuffer.AnimationFrames.Empty();
-	RecordedSequenceBuffer.Duration = 0;
+	AnimationSequenceBP.AnimationSequence = MoveTemp(RecordedSequenceBuffer);
+	AnimationSequenceBP.AnimationSequence.ExpandPackedFrames();
+	RecordedSequenceBuffer = FAnimationSequence();
 	return AnimationSequenceBP;
 }
 
 bool UConvaiFaceSyncComponent::PlayRecordedLipSync(FAnimationSequenceBP RecordedLipSync, int StartFrame, int EndFrame, float OverwriteDuration)
 {
+	RecordedLipSync.AnimationSequence.ExpandPackedFrames();
+
 	if (!IsValidSequence(RecordedLipSync.AnimationSequence))
 	{
 		CONVAI_LOG(ConvaiFaceSyncLog, Warning, TEXT("Recorded LipSync is not valid - Total Frames: %d - Duration: %f"), RecordedLipSync.AnimationSequence.AnimationFrames.Num(), RecordedLipSync.AnimationSequence.Duration);
@@ -312,7 +543,7 @@ bool UConvaiFaceSyncComponent::PlayRecordedLipSync(FAnimationSequenceBP Recorded
 
 bool UConvaiFaceSyncComponent::IsValidSequence(const FAnimationSequence& Sequence)
 {
-	if (Sequence.Duration > 0 && Sequence.AnimationFrames.Num() > 0 && Sequence.AnimationFrames[0].BlendShapes.Num() > 0)
+	if (Sequence.Duration > 0 && (Sequence.IsPacked() || (Sequence.AnimationFrames.Num() > 0 && Sequence.AnimationFrames[0].BlendShapes.Num() > 0)))
 		return true;
 	else
 		return false;
@@ -342,25 +573,195 @@ void UConvaiFaceSyncComponent::ForceRecalculateStartTime()
 	bIsPaused = false;
 }
 
+void UConvaiFaceSyncComponent::TrimConsumedFrames(const int32 FrameIndex, const float FrameDuration)
+{
+	// Frame duration is Duration / NumFrames, removing whole frames with their share keeps it unchanged
+	FConvaiPackedFrames& Frames = MainSequenceBuffer.PackedFrames;
+	const double Trimmed = FrameIndex * static_cast<double>(FrameDuration);
+	Frames.RemoveFrames(0, FrameIndex);
+	MainSequenceBuffer.Duration = FMath::Max(0.0f, MainSequenceBuffer.Duration - static_cast<float>(Trimmed));
+	StartTime += Trimmed;
+	CurrentSequenceTimePassed -= static_cast<float>(Trimmed);
+	NumTrimmedFrames += FrameIndex;
+	TrimmedDuration += Trimmed;
+
+	// Give memory back once a burst has played out
+	if (Frames.Values.Max() > 4 * FMath::Max(Frames.Values.Num(), TrimThresholdFrames * Frames.NumCurves))
+	{
+		Frames.Values.Shrink();
+	}
+}
+
+int32 UConvaiFaceSyncComponent::GetBufferedLipSyncFrames()
+{
+	FScopeLock ScopeLock(&SequenceCriticalSection);
+	return MainSequenceBuffer.GetNumFrames();
+}
+
+int64 UConvaiFaceSyncComponent::GetBufferedLipSyncBytes()
+{
+	FScopeLock ScopeLock(&SequenceCriticalSection);
+	int64 Bytes = MainSequenceBuffer.PackedFrames.Values.GetAllocatedSize() + MainSequenceBuffer.AnimationFrames.GetAllocatedSize();
+	for (const FAnimationFrame& Frame : MainSequenceBuffer.AnimationFrames)
+	{
+		Bytes += Frame.BlendShapes.GetAllocatedSize();
+	}
+	return Bytes;
+}
+
+int32 UConvaiFaceSyncComponent::GetPeakBufferedLipSyncFrames()
+{
+	FScopeLock ScopeLock(&SequenceCriticalSection);
+	return PeakBufferedFrames;
+}
+
 void UConvaiFaceSyncComponent::ClearMainSequence()
 {
 	SequenceCriticalSection.Lock();
 	MainSequenceBuffer.AnimationFrames.Empty();
+	MainSequenceBuffer.PackedFrames.Reset(GetCurveSet());
 	MainSequenceBuffer.Duration = 0;
 	SequenceCriticalSection.Unlock();
 }
 
 TMap<FName, float> UConvaiFaceSyncComponent::InterpolateFrames(const TMap<FName, float>& StartFrame, const TMap<FName, float>& EndFrame, float Alpha)
 {
-	const TArray<FString>& CurveNames = GetCurveNames();
 	TMap<FName, float> Result;
-	for (const auto& CurveName : CurveNames)
+	InterpolateFrames(StartFrame, EndFrame, Alpha, Result);
+	return Result;
+}
+
+void UConvaiFaceSyncComponent::InterpolateFrames(const TMap<FName, float>& StartFrame, const TMap<FName, float>& EndFrame, float Alpha, TMap<FName, float>& OutFrame)
+{
+	// Packed once through the cached curve indices, then the same kernel as the tick
+	const EConvaiCurveSet CurveSet = GetCurveSet();
+	const int32 NumCurves = FConvaiPackedFrames::GetNumCurves(CurveSet);
+
+	TArray<float, TInlineAllocator<128>> Weights;
+	Weights.SetNumUninitialized(NumCurves * 2);
+	FConvaiPackedFrames::MapToFrame(StartFrame, CurveSet, Weights.GetData());
+	FConvaiPackedFrames::MapToFrame(EndFrame, CurveSet, Weights.GetData() + NumCurves);
+	InterpolateFrames(Weights.GetData(), Weights.GetData() + NumCurves, Alpha, Weights.GetData(), NumCurves);
+
+	FConvaiPackedFrames::FrameToMap(CurveSet, Weights.GetData(), OutFrame);
+}
+
+void UConvaiFaceSyncComponent::InterpolateFrames(const float* StartFrame, const float* EndFrame, float Alpha, float* OutFrame, int32 NumCurves)
+{
+	// Four curves per register: 52 ARKit curves are 13 vectors, 15 visemes are 3 vectors and a scalar tail of 3.
+	// Each block is loaded before it is stored, so OutFrame may alias either input.
+	const FConvaiVectorRegister AlphaVector = VectorSetFloat1(Alpha);
+	int32 CurveIndex = 0;
+	for (; CurveIndex + 4 <= NumCurves; CurveIndex += 4)
 	{
-		float StartValue = StartFrame.Contains(*CurveName) ? StartFrame[*CurveName] : 0.0;
-		float EndValue = EndFrame.Contains(*CurveName) ? EndFrame[*CurveName] : 0.0;
-		Result.Add(*CurveName, FMath::Lerp(StartValue, EndValue, Alpha));
+		const FConvaiVectorRegister Start = VectorLoad(StartFrame + CurveIndex);
+		const FConvaiVectorRegister End = VectorLoad(EndFrame + CurveIndex);
+		VectorStore(VectorMultiplyAdd(VectorSubtract(End, Start), AlphaVector, Start), OutFrame + CurveIndex);
+	}
+	for (; CurveIndex < NumCurves; ++CurveIndex)
+	{
+		OutFrame[CurveIndex] = FMath::Lerp(StartFrame[CurveIndex], EndFrame[CurveIndex], Alpha);
+	}
+}
+
+TMap<FName, float> UConvaiFaceSyncComponent::ConvaiGetFaceBlendshapes()
+{
+	TMap<FName, float> BlendShapes;
+	const EConvaiCurveSet CurveSet = GetCurveSet();
+	if (CurrentFrame.Num() != FConvaiPackedFrames::GetNumCurves(CurveSet))
+	{
+		return BlendShapes;
+	}
+
+	if (bCustomCurveNames && LayoutCurveSet == CurveSet)
+	{
+		// Keyed by the subclass' names, names outside the curve set read 0
+		const TArray<FName>& CurveSetNames = FConvaiPackedFrames::GetCurveNames(CurveSet);
+		for (const FString& CurveName : GetCurveNames())
+		{
+			const int32 CurveIndex = CurveSetNames.IndexOfByKey(FName(*CurveName));
+			BlendShapes.Add(*CurveName, CurveIndex != INDEX_NONE ? CurrentFrame[CurveIndex] : 0.0f);
+		}
+		return BlendShapes;
+	}
+
+	FConvaiPackedFrames::FrameToMap(CurveSet, CurrentFrame.GetData(), BlendShapes);
+	return BlendShapes;
+}
+
+const TArray<float>& UConvaiFaceSyncComponent::GetZeroFrame()
+{
+	const EConvaiCurveSet CurveSet = GetCurveSet();
+	if (bHasCurveLayout && LayoutCurveSet == CurveSet)
+	{
+		return ZeroFrameWeights;
+	}
+
+	// The face data type was switched and the game thread has not refreshed the layout yet
+	return CurveSet == EConvaiCurveSet::ARKit ? ZeroBlendshapeWeights : ZeroVisemeWeights;
+}
+
+void UConvaiFaceSyncComponent::RefreshCurveLayout()
+{
+	check(IsInGameThread());
+
+	const EConvaiCurveSet CurveSet = GetCurveSet();
+	if (bHasCurveLayout && LayoutCurveSet == CurveSet)
+	{
+		return;
+	}
+
+	const int32 NumCurves = FConvaiPackedFrames::GetNumCurves(CurveSet);
+	ZeroFrameWeights.SetNumUninitialized(NumCurves);
+	FConvaiPackedFrames::MapToFrame(GenerateZeroFrame(), CurveSet, ZeroFrameWeights.GetData());
+
+	const TArray<FString>& CurveNames = GetCurveNames();
+	bCustomCurveNames = &CurveNames != &ConvaiConstants::BlendShapesNames && &CurveNames != &ConvaiConstants::VisemeNames;
+
+	CurveMask.Reset();
+	if (bCustomCurveNames)
+	{
+		CurveMask.SetNumZeroed(NumCurves);
+		const TArray<FName>& CurveSetNames = FConvaiPackedFrames::GetCurveNames(CurveSet);
+		for (const FString& CurveName : CurveNames)
+		{
+			const int32 CurveIndex = CurveSetNames.IndexOfByKey(FName(*CurveName));
+			if (CurveIndex != INDEX_NONE)
+			{
+				CurveMask[CurveIndex] = 1.0f;
+			}
+		}
+		if (!CurveMask.Contains(0.0f))
+		{
+			CurveMask.Reset();
+		}
+	}
+
+	LayoutCurveSet = CurveSet;
+	bHasCurveLayout = true;
+}
+
+void UConvaiFaceSyncComponent::Apply_StartEndFrames_PostProcessing(const int& CurrentFrameIndex, const int& NextFrameIndex, float& Alpha, TArrayView<float> StartFrame, TArrayView<float> EndFrame)
+{
+	if (!bForwardLegacyPostProcessing)
+	{
+		return;
+	}
+
+	const EConvaiCurveSet CurveSet = GetCurveSet();
+	FConvaiPackedFrames::FrameToMap(CurveSet, StartFrame.GetData(), LegacyStartFrame);
+	FConvaiPackedFrames::FrameToMap(CurveSet, EndFrame.GetData(), LegacyEndFrame);
+
+PRAGMA_DISABLE_DEPRECATION_WARNINGS
+	Apply_StartEndFrames_PostProcessing(CurrentFrameIndex, NextFrameIndex, Alpha, LegacyStartFrame, LegacyEndFrame);
+PRAGMA_ENABLE_DEPRECATION_WARNINGS
+
+	// Still set means a subclass overrides the deprecated overload, take its edits back
+	if (bForwardLegacyPostProcessing)
+	{
+		FConvaiPackedFrames::MapToFrame(LegacyStartFrame, CurveSet, StartFrame.GetData());
+		FConvaiPackedFrames::MapToFrame(LegacyEndFrame, CurveSet, EndFrame.GetData());
 	}
-	return Result;
 }
 
 namespace
@@ -377,7 +778,7 @@ namespace
 	FLipSyncSequenceInfo GetSequenceInfo(const FAnimationSequence& Sequence, double CurrentTimePassed)
 	{
 		FLipSyncSequenceInfo Info;
-		Info.TotalFrames = Sequence.AnimationFrames.Num();
+		Info.TotalFrames = Sequence.GetNumFrames();
 		Info.TotalDuration = Sequence.Duration;
 		Info.RemainingDuration = FMath::Max(0.0f, Info.TotalDuration - (float)CurrentTimePassed);
 
@@ -403,7 +804,7 @@ void UConvaiFaceSyncComponent::ConvaiStopLipSync()
 	FLipSyncSequenceInfo Info = GetSequenceInfo(MainSequenceBuffer, CurrentSequenceTimePassed);
 	SequenceCriticalSection.Unlock();
 
-	CONVAI_LOG(ConvaiFaceSyncLog, Log, TEXT("ConvaiStopLipSync: Stopping lipsync - bIsPlaying: %s, bIsPaused: %s, TotalFrames: %d, FramesRemaining: %d, TotalDuration: %.3f, TimePlayed: %.3f, TimeRemaining: %.3f, TotalPausedDuration: %.3f"),
+	CONVAI_LOG(ConvaiFaceSyncLog, Log, TEXT("ConvaiStopLipSync: Stopping lipsync - bIsPlaying: %s, bIsPaused: %s, TotalFrames: %d, FramesRemaining: %d, TotalDuration: %.3f, TimePlayed: %.3f, TimeRemaining: %.3f, TotalPausedDuration: %.3f, TrimmedFrames: %d, TrimmedDuration: %.3f, PeakBufferedFrames: %d"),
 		bIsPlaying ? TEXT("true") : TEXT("false"),
 		bIsPaused ? TEXT("true") : TEXT("false"),
 		Info.TotalFrames,
@@ -411,7 +812,10 @@ void UConvaiFaceSyncComponent::ConvaiStopLipSync()
 		Info.TotalDuration,
 		CurrentSequenceTimePassed,
 		Info.RemainingDuration,
-		TotalPausedDuration);
+		TotalPausedDuration,
+		NumTrimmedFrames,
+		TrimmedDuration,
+		PeakBufferedFrames);
 
 	bIsPlaying = false;
 	bIsPaused = false;
@@ -419,6 +823,16 @@ void UConvaiFaceSyncComponent::ConvaiStopLipSync()
 	TotalPausedDuration = 0;
 	PauseStartTime = 0;
 	ClearMainSequence();
+
+	SequenceCriticalSection.Lock();
+	MainSequenceBuffer.PackedFrames.Values.Shrink();
+	PeakBufferedFrames = 0;
+	NumTrimmedFrames = 0;
+	TrimmedDuration = 0;
+	SequenceCriticalSection.Unlock();
+
+	FrameSource->Publish(GetCurveSet(), GetZeroFrame().GetData(), GetZeroFrame().Num(), false, GFrameCounter);
+	bPublishedPlaying = false;
 }
 
 void UConvaiFaceSyncComponent::ConvaiPauseLipSync()
@@ -466,3 +880,96 @@ void UConvaiFaceSyncComponent::ConvaiResumeLipSync()
 			Info.RemainingDuration);
 	}
 }
+
+void FConvaiLipSyncFrameSource::Publish(const EConvaiCurveSet CurveSet, const float* Weights, const int32 NumCurves, const bool bIsPlaying, const uint64 FrameNumber)
+{
+	FScopeLock Lock(&Mutex);
+	Snapshot.CurveSet = CurveSet;
+	Snapshot.bIsPlaying = bIsPlaying;
+	Snapshot.FrameNumber = FrameNumber;
+	CopyFrame(Snapshot.Weights, Weights, NumCurves);
+}
+
+void FConvaiLipSyncFrameSource::Read(FConvaiLipSyncSnapshot& OutSnapshot) const
+{
+	FScopeLock Lock(&Mutex);
+	OutSnapshot.CurveSet = Snapshot.CurveSet;
+	OutSnapshot.bIsPlaying = Snapshot.bIsPlaying;
+	OutSnapshot.FrameNumber = Snapshot.FrameNumber;
+	CopyFrame(OutSnapshot.Weights, Snapshot.Weights.GetData(), Snapshot.Weights.Num());
+}
+
+void FConvaiLipSyncFrameSource::ReadBlendshapes(TMap<FName, float>& OutBlendShapes) const
+{
+	FScopeLock Lock(&Mutex);
+	if (Snapshot.Weights.Num() == FConvaiPackedFrames::GetNumCurves(Snapshot.CurveSet))
+	{
+		FConvaiPackedFrames::FrameToMap(Snapshot.CurveSet, Snapshot.Weights.GetData(), OutBlendShapes);
+	}
+	else
+	{
+		OutBlendShapes.Reset();
+	}
+}
+
+#if !UE_BUILD_SHIPPING
+static FAutoConsoleCommand ConvaiBenchmarkLipSyncInterpolationCommand(
+	TEXT("Convai.LipSync.BenchmarkInterpolation"),
+	TEXT("Compares name-keyed frame interpolation with the packed kernel on ARKit frames. Usage: Convai.LipSync.BenchmarkInterpolation [Iterations]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic([](const TArray<FString>& Args)
+	{
+		const int32 Iterations = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 100000;
+		if (Iterations <= 0)
+		{
+			return;
+		}
+
+		const TArray<FString>& CurveNames = ConvaiConstants::BlendShapesNames;
+		const int32 NumCurves = CurveNames.Num();
+
+		TMap<FName, float> StartMap;
+		TMap<FName, float> EndMap;
+		TArray<float> StartFrame;
+		TArray<float> EndFrame;
+		for (int32 CurveIndex = 0; CurveIndex < NumCurves; ++CurveIndex)
+		{
+			const float Start = FMath::Frac(CurveIndex * 0.37f);
+			const float End = FMath::Frac(CurveIndex * 0.61f);
+			StartMap.Add(*CurveNames[CurveIndex], Start);
+			EndMap.Add(*CurveNames[CurveIndex], End);
+			StartFrame.Add(Start);
+			EndFrame.Add(End);
+		}
+
+		// Per-curve FName lookups into a fresh map, as frames were interpolated before they were packed
+		float Checksum = 0.0f;
+		const double MapStart = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			const float Alpha = (Iteration & 63) / 63.0f;
+			TMap<FName, float> Result;
+			for (const FString& CurveName : CurveNames)
+			{
+				const float StartValue = StartMap.Contains(*CurveName) ? StartMap[*CurveName] : 0.0f;
+				const float EndValue = EndMap.Contains(*CurveName) ? EndMap[*CurveName] : 0.0f;
+				Result.Add(*CurveName, FMath::Lerp(StartValue, EndValue, Alpha));
+			}
+			Checksum += Result.FindRef(*CurveNames[0]);
+		}
+		const double MapSeconds = FPlatformTime::Seconds() - MapStart;
+
+		TArray<float> OutFrame;
+		OutFrame.SetNumUninitialized(NumCurves);
+		const double PackedStart = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			const float Alpha = (Iteration & 63) / 63.0f;
+			UConvaiFaceSyncComponent::InterpolateFrames(StartFrame.GetData(), EndFrame.GetData(), Alpha, OutFrame.GetData(), NumCurves);
+			Checksum += OutFrame[0];
+		}
+		const double PackedSeconds = FPlatformTime::Seconds() - PackedStart;
+
+		CONVAI_LOG(ConvaiFaceSyncLog, Display, TEXT("Interpolation benchmark, %d frames of %d curves: name-keyed %.3f us/frame, packed %.3f us/frame (checksum %f)"),
+			Iterations, NumCurves, MapSeconds * 1e6 / Iterations, PackedSeconds * 1e6 / Iterations, Checksum);
+	}));
+#endif
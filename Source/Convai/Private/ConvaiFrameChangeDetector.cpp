@@ -0,0 +1,75 @@
+// Copyright 2022 Convai Inc. All Rights Reserved.
+
+#include "ConvaiFrameChangeDetector.h"
+
+void FConvaiFrameChangeDetector::ComputeSignature(const uint8* RGBA, int32 Width, int32 Height, uint8* OutSignature)
+{
+	constexpr int32 SamplesPerAxis = GridSize * SamplesPerCell;
+	constexpr int32 SamplesInCell = SamplesPerCell * SamplesPerCell;
+
+	// Sample centres of a regular SamplesPerAxis grid, in pixels
+	int32 SampleX[SamplesPerAxis];
+	int32 SampleY[SamplesPerAxis];
+	for (int32 Index = 0; Index < SamplesPerAxis; ++Index)
+	{
+		SampleX[Index] = static_cast<int32>((int64(Index) * 2 + 1) * Width / (SamplesPerAxis * 2));
+		SampleY[Index] = static_cast<int32>((int64(Index) * 2 + 1) * Height / (SamplesPerAxis * 2));
+	}
+
+	for (int32 CellY = 0; CellY < GridSize; ++CellY)
+	{
+		for (int32 CellX = 0; CellX < GridSize; ++CellX)
+		{
+			uint32 LumaSum = 0;
+			for (int32 SubY = 0; SubY < SamplesPerCell; ++SubY)
+			{
+				const uint8* Row = RGBA + int64(SampleY[CellY * SamplesPerCell + SubY]) * Width * 4;
+				for (int32 SubX = 0; SubX < SamplesPerCell; ++SubX)
+				{
+					const uint8* Pixel = Row + SampleX[CellX * SamplesPerCell + SubX] * 4;
+
+					// Rec. 601 luma in 8.8 fixed point
+					LumaSum += (Pixel[0] * 77 + Pixel[1] * 150 + Pixel[2] * 29) >> 8;
+				}
+			}
+			OutSignature[CellY * GridSize + CellX] = static_cast<uint8>(LumaSum / SamplesInCell);
+		}
+	}
+}
+
+float FConvaiFrameChangeDetector::Compare(const uint8* RGBA, int32 Width, int32 Height)
+{
+	if (!RGBA || Width <= 0 || Height <= 0)
+	{
+		return 1.0f;
+	}
+
+	ComputeSignature(RGBA, Width, Height, Pending);
+	PendingSize = FIntPoint(Width, Height);
+
+	if (!bHasReference || PendingSize != ReferenceSize)
+	{
+		return 1.0f;
+	}
+
+	int32 MaxDifference = 0;
+	for (int32 Cell = 0; Cell < GridSize * GridSize; ++Cell)
+	{
+		MaxDifference = FMath::Max(MaxDifference, FMath::Abs(int32(Pending[Cell]) - int32(Reference[Cell])));
+	}
+	return MaxDifference / 255.0f;
+}
+
+void FConvaiFrameChangeDetector::Accept()
+{
+	FMemory::Memcpy(Reference, Pending, sizeof(Reference));
+	ReferenceSize = PendingSize;
+	bHasReference = PendingSize.X > 0 && PendingSize.Y > 0;
+}
+
+void FConvaiFrameChangeDetector::Reset()
+{
+	ReferenceSize = FIntPoint::ZeroValue;
+	PendingSize = FIntPoint::ZeroValue;
+	bHasReference = false;
+}
@@ -24,6 +24,7 @@
 #include "ConvaiSubsystem.h"
 #include "Engine/GameInstance.h"
 #include "Async/Async.h"
+#include "ConvaiThreadSafeBuffers.h"
 #include "Interface/ConvaiAudioCaptureInterface.h"
 
 DEFINE_LOG_CATEGORY(ConvaiPlayerLog);
@@ -61,6 +62,137 @@ static Audio::FMixerDevice* GetAudioMixerDeviceFromWorldContext(const UObject* W
 	return nullptr;
 }
 
+/**
+ * Receives the capture submix output on the audio render thread, resamples it to
+ * VoiceCaptureSampleRate and cuts it into fixed-size frames. While the player has a direct
+ * connection set, frames go straight to that connection's client from the render thread.
+ * Otherwise, e.g. when audio processing is attached, they are queued and the player drains
+ * them on the game thread. The render thread never touches the owning player.
+ */
+class FConvaiMicCaptureListener : public ISubmixBufferListener, public TSharedFromThis<FConvaiMicCaptureListener, ESPMode::ThreadSafe>
+{
+public:
+	explicit FConvaiMicCaptureListener(int32 InFrameSize)
+		: FrameSize(InFrameSize)
+		, Frames(ConvaiConstants::VoiceCaptureSampleRate)
+	{
+		// Room for a frame plus a generous render buffer so the render thread never allocates
+		PendingSamples.Reserve(FrameSize + ConvaiConstants::VoiceCaptureSampleRate / 10);
+		DrainedFrame.SetNumUninitialized(FrameSize);
+	}
+
+	virtual void OnNewSubmixBuffer(const USoundSubmix* OwningSubmix, float* AudioData, int32 NumSamples, int32 NumChannels, const int32 SampleRate, double AudioClock) override
+	{
+		if (!bActive || !AudioData || NumSamples <= 0 || NumChannels <= 0)
+		{
+			return;
+		}
+
+		Resampler.Initialize(SampleRate, ConvaiConstants::VoiceCaptureSampleRate, NumChannels);
+		Resampler.Process(AudioData, NumSamples / NumChannels, PendingSamples);
+
+		int32 SamplesQueued = 0;
+		{
+			// Held across the sends so the game thread never releases the connection mid-send
+			FScopeLock Lock(&DirectConnectionMutex);
+			const bool bMuted = bMute.load(std::memory_order_relaxed);
+			while (PendingSamples.Num() - SamplesQueued >= FrameSize)
+			{
+				const int16* Frame = PendingSamples.GetData() + SamplesQueued;
+				SamplesQueued += FrameSize;
+
+				if (DirectConnection.IsValid())
+				{
+					convai::ConvaiClient* Client = DirectConnection->GetClient();
+					if (!bMuted && Client && DirectConnection->IsConnected())
+					{
+						// Mono, so the number of frames equals the number of samples
+						Client->SendAudio(reinterpret_cast<const int16_t*>(Frame), FrameSize);
+					}
+					continue;
+				}
+
+				// A stalled game thread loses whole frames, never part of one
+				if (!Frames.Push(Frame, FrameSize))
+				{
+					FramesDropped.fetch_add(1, std::memory_order_relaxed);
+				}
+			}
+		}
+
+#if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 5
+		PendingSamples.RemoveAt(0, SamplesQueued, EAllowShrinking::No);
+#else
+		PendingSamples.RemoveAt(0, SamplesQueued, false);
+#endif
+	}
+
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 4
+	virtual const FString& GetListenerName() const override
+	{
+		static const FString ListenerName(TEXT("ConvaiMicCaptureListener"));
+		return ListenerName;
+	}
+#endif
+
+	// Game thread: hands every queued frame to Sink, oldest first
+	template <typename SinkType>
+	void DrainFrames(SinkType&& Sink)
+	{
+		while (Frames.Num() >= static_cast<uint32>(FrameSize))
+		{
+			Frames.Pop(DrainedFrame.GetData(), FrameSize);
+			Sink(DrainedFrame.GetData(), FrameSize);
+		}
+	}
+
+	int32 GetFramesDropped() const
+	{
+		return FramesDropped.load(std::memory_order_relaxed);
+	}
+
+	/**
+	 * Game thread: sends later frames straight to Connection from the render thread, or queues them when null.
+	 * The connection is only ever released here, so its last reference never drops on the render thread.
+	 */
+	void SetDirectConnection(const FConvaiCharacterConnectionPtr& Connection)
+	{
+		FConvaiCharacterConnectionPtr Released;
+		{
+			FScopeLock Lock(&DirectConnectionMutex);
+			if (DirectConnection == Connection)
+			{
+				return;
+			}
+			Released = MoveTemp(DirectConnection);
+			DirectConnection = Connection;
+		}
+	}
+
+	std::atomic<bool> bActive{ true };
+
+	// Mirrors the player's bMute for direct sends
+	std::atomic<bool> bMute{ false };
+
+private:
+	int32 FrameSize;
+
+	// Written by the game thread, read by the render thread while sending
+	FCriticalSection DirectConnectionMutex;
+	FConvaiCharacterConnectionPtr DirectConnection;
+
+	// Render thread -> game thread, about a second of audio
+	TConvaiSPSCRingBuffer<int16> Frames;
+	std::atomic<int32> FramesDropped{ 0 };
+
+	// Render thread only
+	FConvaiResampler Resampler;
+	TArray<int16> PendingSamples;
+
+	// Game thread only
+	TArray<int16> DrainedFrame;
+};
+
 UConvaiPlayerComponent::UConvaiPlayerComponent()
 {
 	PrimaryComponentTick.bCanEverTick = true;
@@ -422,7 +554,8 @@ bool UConvaiPlayerComponent::SetAudioCaptureComponent(UActorComponent* InAudioCa
 
 void UConvaiPlayerComponent::UpdateVoiceCapture(float DeltaTime)
 {
-	if (IsRecording || IsStreaming) {
+	// Streaming through the submix listener is driven by the audio render thread, not by Tick
+	if (IsRecording || bStreamingByChunks) {
 		RemainingTimeUntilNextUpdate -= DeltaTime;
 		if (RemainingTimeUntilNextUpdate <= 0)
 		{
@@ -507,17 +640,11 @@ void UConvaiPlayerComponent::StopVoiceChunkCapture()
 	if (RecordedBuffer.Num() == 0)
 		return;
 
-	Audio::TSampleBuffer<int16> Int16Buffer = Audio::TSampleBuffer<int16>(RecordedBuffer, NumChannels, SampleRate);
-	TArray<int16> OutConverted;
-
-	if (NumChannels > 1 || SampleRate != static_cast<int32>(ConvaiConstants::VoiceCaptureSampleRate))
-	{
-		UConvaiUtils::ResampleAudio(SampleRate, ConvaiConstants::VoiceCaptureSampleRate, NumChannels, true, static_cast<TArray<int16>>(Int16Buffer.GetArrayView()), Int16Buffer.GetNumSamples(), OutConverted);
-	}
-	else
-	{
-		OutConverted = static_cast<TArray<int16>>(Int16Buffer.GetArrayView());
-	}
+	// Converts to int16, downmixes to mono and resamples in one pass, continuing from the previous chunk's filter state
+	TArray<int16>& OutConverted = VoiceCaptureChunkBuffer;
+	OutConverted.Reset();
+	VoiceCaptureResampler.Initialize(SampleRate, ConvaiConstants::VoiceCaptureSampleRate, NumChannels);
+	VoiceCaptureResampler.Process(RecordedBuffer, OutConverted);
 
 	if (IsRecording)
 	{
@@ -530,23 +657,144 @@ void UConvaiPlayerComponent::StopVoiceChunkCapture()
 		//}
 	}
 
-	// Write to the shared buffer for direct access
-	if (IsStreaming)
+	// This runs on the audio thread when driven by UpdateVoiceCapture, sending needs the game thread
+	if (bStreamingByChunks && OutConverted.Num() > 0)
 	{
-		if (bMute) return;
-		
-		if (SupportsAudioProcessing())
+		TWeakObjectPtr<UConvaiPlayerComponent> WeakThis(this);
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, Chunk = TArray<int16>(OutConverted)]()
+			{
+				if (WeakThis.IsValid())
+				{
+					WeakThis->SendCapturedAudio(Chunk.GetData(), Chunk.Num());
+				}
+			});
+	}
+}
+
+void UConvaiPlayerComponent::SendCapturedAudio(const int16* AudioData, int32 NumSamples)
+{
+	check(IsInGameThread());
+
+	if (bMute || NumSamples <= 0)
+		return;
+
+	if (SupportsAudioProcessing())
+	{
+		SafeProcessAudioData(AudioData, NumSamples, ConvaiConstants::VoiceCaptureSampleRate);
+	}
+	// Send audio to the session proxy if we have one
+	else if (IsValid(SessionProxyInstance))
+	{
+		// Mono, so the number of frames equals the number of samples
+		SessionProxyInstance->SendAudio((const int16_t*)AudioData, NumSamples);
+	}
+}
+
+bool UConvaiPlayerComponent::StartMicCaptureListener()
+{
+	USoundSubmix* CaptureSubmix = IsValid(AudioCaptureComponent) ? Cast<USoundSubmix>(AudioCaptureComponent->SoundSubmix) : nullptr;
+	FAudioDevice* AudioDevice = GetAudioDeviceFromWorldContext(this);
+	if (!CaptureSubmix || !AudioDevice)
+	{
+		CONVAI_LOG(ConvaiPlayerLog, Warning, TEXT("StartMicCaptureListener: No capture submix or audio device, falling back to tick-driven capture"));
+		return false;
+	}
+
+	const int32 FrameDurationMs = StreamingFrameDurationMs >= 20 ? 20 : 10;
+	const int32 FrameSize = ConvaiConstants::VoiceCaptureSampleRate * FrameDurationMs / 1000;
+	MicCaptureListener = MakeShared<FConvaiMicCaptureListener, ESPMode::ThreadSafe>(FrameSize);
+	UpdateMicCaptureRouting();
+
+	// The core ticker keeps running while the game is paused, unlike component ticks
+#if ENGINE_MAJOR_VERSION >= 5
+	MicCaptureTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UConvaiPlayerComponent::DrainMicCapture));
+#else
+	MicCaptureTickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UConvaiPlayerComponent::DrainMicCapture));
+#endif
+
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 4
+	AudioDevice->RegisterSubmixBufferListener(MicCaptureListener.ToSharedRef(), *CaptureSubmix);
+#else
+	AudioDevice->RegisterSubmixBufferListener(MicCaptureListener.Get(), CaptureSubmix);
+#endif
+
+	CONVAI_LOG(ConvaiPlayerLog, Log, TEXT("Streaming microphone from the audio thread in %d ms frames"), FrameDurationMs);
+	return true;
+}
+
+void UConvaiPlayerComponent::StopMicCaptureListener()
+{
+	if (!MicCaptureListener.IsValid())
+		return;
+
+	MicCaptureListener->bActive = false;
+	MicCaptureListener->SetDirectConnection(nullptr);
+
+#if ENGINE_MAJOR_VERSION >= 5
+	FTSTicker::GetCoreTicker().RemoveTicker(MicCaptureTickerHandle);
+#else
+	FTicker::GetCoreTicker().RemoveTicker(MicCaptureTickerHandle);
+#endif
+	MicCaptureTickerHandle.Reset();
+
+	USoundSubmix* CaptureSubmix = IsValid(AudioCaptureComponent) ? Cast<USoundSubmix>(AudioCaptureComponent->SoundSubmix) : nullptr;
+	if (FAudioDevice* AudioDevice = GetAudioDeviceFromWorldContext(this))
+	{
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 4
+		// The device holds its own reference until the unregistration reaches the render thread
+		if (CaptureSubmix)
+		{
+			AudioDevice->UnregisterSubmixBufferListener(MicCaptureListener.ToSharedRef(), *CaptureSubmix);
+		}
+#else
+		UConvaiUtils::UnregisterSubmixBufferListener(AudioDevice, MicCaptureListener.Get(), CaptureSubmix);
+#endif
+	}
+
+	// Send what was captured before the mute
+	DrainMicCapture(0.f);
+
+	if (const int32 FramesDropped = MicCaptureListener->GetFramesDropped())
+	{
+		CONVAI_LOG(ConvaiPlayerLog, Warning, TEXT("StopMicCaptureListener: %d microphone frames were dropped while the game thread was stalled"), FramesDropped);
+	}
+	MicCaptureListener.Reset();
+}
+
+void UConvaiPlayerComponent::UpdateMicCaptureRouting()
+{
+	if (!MicCaptureListener.IsValid())
+		return;
+
+	MicCaptureListener->bMute = bMute;
+
+	// Audio processing runs on the game thread, so frames only bypass it when none is attached
+	FConvaiCharacterConnectionPtr Connection;
+	if (!SupportsAudioProcessing() && IsValid(SessionProxyInstance))
+	{
+		if (const UConvaiSubsystem* ConvaiSubsystem = UConvaiUtils::GetConvaiSubsystem(this))
 		{
-			SafeProcessAudioData(OutConverted.GetData(), OutConverted.Num(), ConvaiConstants::VoiceCaptureSampleRate);
+			Connection = ConvaiSubsystem->GetSessionConnection(SessionProxyInstance);
 		}
-		// Send audio to the session proxy if we have one
-		else if (IsValid(SessionProxyInstance))
+	}
+	MicCaptureListener->SetDirectConnection(Connection);
+}
+
+bool UConvaiPlayerComponent::DrainMicCapture(float DeltaTime)
+{
+	if (MicCaptureListener.IsValid())
+	{
+		// Not while stopping, the connection must be released before the listener is
+		if (MicCaptureListener->bActive)
 		{
-			// Calculate the number of frames (samples per channel)
-			const size_t NumFrames = OutConverted.Num();
-			SessionProxyInstance->SendAudio((const int16_t*)OutConverted.GetData(), NumFrames);
+			UpdateMicCaptureRouting();
 		}
+		MicCaptureListener->DrainFrames([this](const int16* Frame, int32 NumSamples)
+			{
+				SendCapturedAudio(Frame, NumSamples);
+			});
 	}
+	return true;
 }
 
 void UConvaiPlayerComponent::StartRecording()
@@ -787,9 +1035,13 @@ bool UConvaiPlayerComponent::UnmuteStreamingAudio()
 
 	StartAudioCaptureComponent();    // Start the AudioCaptureComponent
 
-	// Reset audio buffers
-	StartVoiceChunkCapture();
-	StopVoiceChunkCapture();
+	if (!bStreamFromAudioThread || !StartMicCaptureListener())
+	{
+		// Reset audio buffers
+		StartVoiceChunkCapture();
+		StopVoiceChunkCapture();
+		bStreamingByChunks = true;
+	}
 
 	IsStreaming = true;
 	VoiceCaptureRingBuffer.Empty();
@@ -805,7 +1057,15 @@ void UConvaiPlayerComponent::MuteStreamingAudio()
 		return;
 	}
 
-	StopVoiceChunkCapture();
+	if (MicCaptureListener.IsValid())
+	{
+		StopMicCaptureListener();
+	}
+	else
+	{
+		StopVoiceChunkCapture();
+		bStreamingByChunks = false;
+	}
 	StopAudioCaptureComponent();  // Stop the AudioCaptureComponent
 	IsStreaming = false;
 
@@ -861,7 +1121,7 @@ void UConvaiPlayerComponent::OnTranscriptionReceived(FString Transcription, bool
 		
 	if (!IsInGameThread())
 	{
-		AsyncTask(ENamedThreads::GameThread, [this, Transcription, IsTranscriptionReady, IsFinal]
+		EnqueueGameThreadTask([this, Transcription, IsTranscriptionReady, IsFinal]
 			{
 				OnTranscriptionReceived(Transcription, IsTranscriptionReady, IsFinal);
 			});
@@ -879,7 +1139,7 @@ void UConvaiPlayerComponent::OnStartedTalking()
 {
 	if (!IsInGameThread())
 	{
-		AsyncTask(ENamedThreads::GameThread, [this]
+		EnqueueGameThreadTask([this]
 			{
 				OnStartedTalking();
 			});
@@ -898,7 +1158,7 @@ void UConvaiPlayerComponent::OnFinishedTalking()
 {
 	if (!IsInGameThread())
 	{
-		AsyncTask(ENamedThreads::GameThread, [this]
+		EnqueueGameThreadTask([this]
 			{
 				OnFinishedTalking();
 			});
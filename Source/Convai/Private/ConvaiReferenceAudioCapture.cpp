@@ -0,0 +1,198 @@
+// Copyright 2022 Convai Inc. All Rights Reserved.
+
+#include "ConvaiReferenceAudioCapture.h"
+#include "Engine/World.h"
+#include "Async/Async.h"
+#include "ConvaiDefinitions.h"
+#include "ConvaiUtils.h"
+#include "Utility/Log/ConvaiLogger.h"
+
+DEFINE_LOG_CATEGORY_STATIC(ConvaiReferenceAudioCapture, Log, All);
+
+FConvaiReferenceAudioCapture::FConvaiReferenceAudioCapture(convai::ConvaiClient* InConvaiClient, UWorld* InWorld)
+    : ConvaiClient(InConvaiClient)
+    , WorldPtr(InWorld)
+    , bIsCapturing(false)
+    , ProcessingChunkSize(0)
+    , TargetSampleRate(ConvaiConstants::VoiceCaptureSampleRate)
+{
+    // Calculate processing chunk size for 10ms frames
+    ProcessingChunkSize = TargetSampleRate / 100;
+    FrameBuffer.SetNumUninitialized(ProcessingChunkSize);
+
+    // One second of headroom between the render thread and the send task
+    ReferenceRingBuffer.Init(TargetSampleRate);
+
+    // Mixer buffers are typically 256-1024 frames at 48kHz, reserve generously so the render thread never allocates
+    ResampledBuffer.Reserve(ProcessingChunkSize * 10);
+
+    CONVAI_LOG(ConvaiReferenceAudioCapture, Log, TEXT("ConvaiReferenceAudioCapture created with chunk size: %d"), ProcessingChunkSize);
+}
+
+FConvaiReferenceAudioCapture::~FConvaiReferenceAudioCapture()
+{
+    // Owners stop the capture first, the device may otherwise still be calling this listener
+    ensureMsgf(!bIsCapturing, TEXT("FConvaiReferenceAudioCapture released while capturing, call StopCapture first"));
+
+    CONVAI_LOG(ConvaiReferenceAudioCapture, Log, TEXT("ConvaiReferenceAudioCapture destroyed"));
+}
+
+void FConvaiReferenceAudioCapture::StartCapture()
+{
+    if (bIsCapturing)
+    {
+        CONVAI_LOG(ConvaiReferenceAudioCapture, Warning, TEXT("Reference audio capture already active"));
+        return;
+    }
+
+    if (!ConvaiClient)
+    {
+        CONVAI_LOG(ConvaiReferenceAudioCapture, Error, TEXT("ConvaiClient is null, cannot start reference audio capture"));
+        return;
+    }
+
+    UWorld* World = WorldPtr.Get();
+    if (!World)
+    {
+        CONVAI_LOG(ConvaiReferenceAudioCapture, Error, TEXT("World is invalid, cannot start reference audio capture"));
+        return;
+    }
+
+    AudioDeviceHandle = World->GetAudioDevice();
+    if (!AudioDeviceHandle.IsValid())
+    {
+        CONVAI_LOG(ConvaiReferenceAudioCapture, Error, TEXT("Failed to get audio device for reference audio capture"));
+        return;
+    }
+
+    bIsCapturing = true;
+
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 4
+    AudioDeviceHandle->RegisterSubmixBufferListener(AsShared(), AudioDeviceHandle->GetMainSubmixObject());
+#else
+    // A null submix registers on the main submix
+    AudioDeviceHandle->RegisterSubmixBufferListener(this);
+#endif
+
+    CONVAI_LOG(ConvaiReferenceAudioCapture, Log, TEXT("Reference audio capture started"));
+}
+
+void FConvaiReferenceAudioCapture::StopCapture()
+{
+    if (!bIsCapturing)
+    {
+        CONVAI_LOG(ConvaiReferenceAudioCapture, Warning, TEXT("Reference audio capture not active"));
+        return;
+    }
+
+    {
+        // Waits for an in-flight send, later sends see bIsCapturing == false
+        FScopeLock Lock(&ClientMutex);
+        bIsCapturing = false;
+    }
+
+    if (AudioDeviceHandle.IsValid())
+    {
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 4
+        // The device holds its own reference until the render thread has dropped the listener
+        AudioDeviceHandle->UnregisterSubmixBufferListener(AsShared(), AudioDeviceHandle->GetMainSubmixObject());
+#else
+        // Registered by raw pointer, wait until the render thread has dropped it
+        UConvaiUtils::UnregisterSubmixBufferListener(AudioDeviceHandle.GetAudioDevice(), this, nullptr);
+#endif
+    }
+    AudioDeviceHandle.Reset();
+
+    CONVAI_LOG(ConvaiReferenceAudioCapture, Log, TEXT("Reference audio capture stopped"));
+}
+
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 4
+const FString& FConvaiReferenceAudioCapture::GetListenerName() const
+{
+    static const FString ListenerName(TEXT("ConvaiReferenceAudioCapture"));
+    return ListenerName;
+}
+#endif
+
+void FConvaiReferenceAudioCapture::OnNewSubmixBuffer(const USoundSubmix* OwningSubmix, float* AudioData, int32 NumSamples, int32 NumChannels, const int32 SampleRate, double AudioClock)
+{
+    if (!bIsCapturing || !AudioData || NumSamples <= 0 || NumChannels <= 0)
+    {
+        return;
+    }
+
+    // Convert, downmix and resample in one pass, continuing from the previous render buffer
+    ResampledBuffer.Reset();
+    Resampler.Initialize(SampleRate, TargetSampleRate, NumChannels);
+    Resampler.Process(AudioData, NumSamples / NumChannels, ResampledBuffer);
+
+    if (ResampledBuffer.Num() > 0 && !ReferenceRingBuffer.Push(ResampledBuffer.GetData(), ResampledBuffer.Num()))
+    {
+        // The send task fell a full second behind, drop this buffer rather than block the render thread
+        return;
+    }
+
+    if (ReferenceRingBuffer.Num() >= (uint32)ProcessingChunkSize)
+    {
+        ScheduleSendTask();
+    }
+}
+
+void FConvaiReferenceAudioCapture::ScheduleSendTask()
+{
+    bool bExpected = false;
+    if (!bSendTaskScheduled.compare_exchange_strong(bExpected, true))
+    {
+        // A send task is already pending and will pick up the new frames
+        return;
+    }
+
+    TWeakPtr<FConvaiReferenceAudioCapture, ESPMode::ThreadSafe> WeakSelf = AsShared();
+    AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [WeakSelf]()
+    {
+        if (TSharedPtr<FConvaiReferenceAudioCapture, ESPMode::ThreadSafe> SharedThis = WeakSelf.Pin())
+        {
+            SharedThis->SendPendingFrames();
+        }
+    });
+}
+
+void FConvaiReferenceAudioCapture::SendPendingFrames()
+{
+    for (;;)
+    {
+        {
+            FScopeLock Lock(&ClientMutex);
+            while (bIsCapturing && ReferenceRingBuffer.Num() >= (uint32)ProcessingChunkSize)
+            {
+                ReferenceRingBuffer.Pop(FrameBuffer.GetData(), ProcessingChunkSize);
+                SendAudioChunkToConvaiClient(FrameBuffer.GetData(), ProcessingChunkSize);
+            }
+        }
+
+        bSendTaskScheduled.store(false);
+
+        // A frame may have completed between the last check and clearing the flag
+        if (!bIsCapturing || ReferenceRingBuffer.Num() < (uint32)ProcessingChunkSize)
+        {
+            return;
+        }
+
+        bool bExpected = false;
+        if (!bSendTaskScheduled.compare_exchange_strong(bExpected, true))
+        {
+            return;
+        }
+    }
+}
+
+void FConvaiReferenceAudioCapture::SendAudioChunkToConvaiClient(const int16* AudioData, int32 NumSamples)
+{
+    if (!ConvaiClient || !AudioData || NumSamples <= 0)
+    {
+        return;
+    }
+
+    // Send reference audio to ConvaiClient
+    ConvaiClient->SendReferenceAudio(AudioData, NumSamples);
+}
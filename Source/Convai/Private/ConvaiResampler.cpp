@@ -0,0 +1,420 @@
+// Copyright 2022 Convai Inc. All Rights Reserved.
+
+#include "ConvaiResampler.h"
+#include "Math/VectorRegister.h"
+#include "Misc/ScopeLock.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Runtime/Launch/Resources/Version.h"
+#include "ConvaiUtils.h"
+#include "Utility/Log/ConvaiLogger.h"
+
+DEFINE_LOG_CATEGORY(ConvaiResamplerLog);
+
+namespace
+{
+#if ENGINE_MAJOR_VERSION >= 5
+	using FConvaiVectorRegister = VectorRegister4Float;
+#else
+	using FConvaiVectorRegister = VectorRegister;
+#endif
+
+	int32 GreatestCommonDivisor(int32 A, int32 B)
+	{
+		while (B != 0)
+		{
+			const int32 Remainder = A % B;
+			A = B;
+			B = Remainder;
+		}
+		return A;
+	}
+
+	// Blackman window over [-HalfWidth, HalfWidth]
+	double BlackmanWindow(double X, double HalfWidth)
+	{
+		if (FMath::Abs(X) >= HalfWidth)
+		{
+			return 0.0;
+		}
+		const double Phase = PI * X / HalfWidth;
+		return 0.42 + 0.5 * FMath::Cos(Phase) + 0.08 * FMath::Cos(2.0 * Phase);
+	}
+
+	double Sinc(double X)
+	{
+		if (FMath::Abs(X) < 1e-9)
+		{
+			return 1.0;
+		}
+		return FMath::Sin(PI * X) / (PI * X);
+	}
+
+	TSharedPtr<const FConvaiPolyphaseFilterTable, ESPMode::ThreadSafe> BuildFilterTable(int32 SourceSampleRate, int32 TargetSampleRate)
+	{
+		TSharedPtr<FConvaiPolyphaseFilterTable, ESPMode::ThreadSafe> NewTable = MakeShared<FConvaiPolyphaseFilterTable, ESPMode::ThreadSafe>();
+
+		const int32 Divisor = GreatestCommonDivisor(SourceSampleRate, TargetSampleRate);
+		NewTable->SourceSampleRate = SourceSampleRate;
+		NewTable->TargetSampleRate = TargetSampleRate;
+		NewTable->Interpolation = TargetSampleRate / Divisor;
+		NewTable->Step = SourceSampleRate / Divisor;
+		NewTable->NumPhases = FMath::Min(NewTable->Interpolation, FConvaiPolyphaseFilterTable::MaxPhases);
+
+		// When downsampling the cutoff moves to the target Nyquist and the kernel widens accordingly
+		const double Cutoff = FMath::Min(1.0, static_cast<double>(TargetSampleRate) / static_cast<double>(SourceSampleRate));
+		const int32 HalfWidth = FMath::CeilToInt(FConvaiPolyphaseFilterTable::ZeroCrossings / Cutoff);
+		NewTable->NumTaps = Align(2 * HalfWidth, 4);
+
+		const int32 NumTaps = NewTable->NumTaps;
+		const double Center = NumTaps / 2 - 1;
+		NewTable->Coefficients.SetNumUninitialized(NewTable->NumPhases * NumTaps);
+
+		for (int32 PhaseIndex = 0; PhaseIndex < NewTable->NumPhases; ++PhaseIndex)
+		{
+			const double Fraction = static_cast<double>(PhaseIndex) / NewTable->NumPhases;
+			float* Coefficients = NewTable->Coefficients.GetData() + PhaseIndex * NumTaps;
+
+			double Sum = 0.0;
+			for (int32 Tap = 0; Tap < NumTaps; ++Tap)
+			{
+				const double X = Tap - Center - Fraction;
+				const double Value = Cutoff * Sinc(Cutoff * X) * BlackmanWindow(X, NumTaps / 2);
+				Coefficients[Tap] = static_cast<float>(Value);
+				Sum += Value;
+			}
+
+			// Normalize every phase to unity DC gain
+			const float Normalization = Sum > 0.0 ? static_cast<float>(1.0 / Sum) : 1.0f;
+			for (int32 Tap = 0; Tap < NumTaps; ++Tap)
+			{
+				Coefficients[Tap] *= Normalization;
+			}
+		}
+
+		CONVAI_LOG(ConvaiResamplerLog, Log, TEXT("Built polyphase filter %d -> %d Hz: %d phases, %d taps"), SourceSampleRate, TargetSampleRate, NewTable->NumPhases, NumTaps);
+
+		return NewTable;
+	}
+
+	FORCEINLINE float DotProduct(const float* RESTRICT Input, const float* RESTRICT Coefficients, int32 NumTaps)
+	{
+		FConvaiVectorRegister Accumulator = VectorZero();
+		for (int32 Tap = 0; Tap < NumTaps; Tap += 4)
+		{
+			Accumulator = VectorMultiplyAdd(VectorLoad(Input + Tap), VectorLoad(Coefficients + Tap), Accumulator);
+		}
+
+		alignas(16) float Lanes[4];
+		VectorStoreAligned(Accumulator, Lanes);
+		return (Lanes[0] + Lanes[1]) + (Lanes[2] + Lanes[3]);
+	}
+
+	FORCEINLINE int16 FloatToInt16(float Sample)
+	{
+		return static_cast<int16>(FMath::Clamp(FMath::RoundToInt(Sample * 32767.0f), -32768, 32767));
+	}
+
+	FORCEINLINE float SampleToFloat(int16 Sample)
+	{
+		return static_cast<float>(Sample) * (1.0f / 32767.0f);
+	}
+
+	FORCEINLINE float SampleToFloat(float Sample)
+	{
+		return Sample;
+	}
+
+	// Averages the channels of interleaved input into mono float
+	template<typename SampleType>
+	void DownmixToMono(const SampleType* RESTRICT InSamples, int32 NumFrames, int32 NumChannels, float* RESTRICT OutSamples)
+	{
+		if (NumChannels == 1)
+		{
+			for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+			{
+				OutSamples[Frame] = SampleToFloat(InSamples[Frame]);
+			}
+		}
+		else if (NumChannels == 2)
+		{
+			for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+			{
+				OutSamples[Frame] = 0.5f * (SampleToFloat(InSamples[2 * Frame]) + SampleToFloat(InSamples[2 * Frame + 1]));
+			}
+		}
+		else
+		{
+			const float ChannelScale = 1.0f / NumChannels;
+			for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+			{
+				const SampleType* FrameSamples = InSamples + Frame * NumChannels;
+				float Sum = 0.0f;
+				for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+				{
+					Sum += SampleToFloat(FrameSamples[Channel]);
+				}
+				OutSamples[Frame] = Sum * ChannelScale;
+			}
+		}
+	}
+
+	// Float fast path for mixer output: stereo deinterleaves four frames per iteration with two shuffles
+	void DownmixToMono(const float* RESTRICT InSamples, int32 NumFrames, int32 NumChannels, float* RESTRICT OutSamples)
+	{
+		if (NumChannels == 1)
+		{
+			FMemory::Memcpy(OutSamples, InSamples, NumFrames * sizeof(float));
+			return;
+		}
+
+		if (NumChannels != 2)
+		{
+			DownmixToMono<float>(InSamples, NumFrames, NumChannels, OutSamples);
+			return;
+		}
+
+		const FConvaiVectorRegister Half = VectorSetFloat1(0.5f);
+		const int32 NumVectorFrames = NumFrames & ~3;
+		for (int32 Frame = 0; Frame < NumVectorFrames; Frame += 4)
+		{
+			const FConvaiVectorRegister First = VectorLoad(InSamples + 2 * Frame);
+			const FConvaiVectorRegister Second = VectorLoad(InSamples + 2 * Frame + 4);
+			const FConvaiVectorRegister Left = VectorShuffle(First, Second, 0, 2, 0, 2);
+			const FConvaiVectorRegister Right = VectorShuffle(First, Second, 1, 3, 1, 3);
+			VectorStore(VectorMultiply(VectorAdd(Left, Right), Half), OutSamples + Frame);
+		}
+
+		for (int32 Frame = NumVectorFrames; Frame < NumFrames; ++Frame)
+		{
+			OutSamples[Frame] = 0.5f * (InSamples[2 * Frame] + InSamples[2 * Frame + 1]);
+		}
+	}
+}
+
+FConvaiResampler::FConvaiResampler()
+	: SourceSampleRate(0)
+	, TargetSampleRate(0)
+	, NumChannels(0)
+	, bPassthrough(false)
+	, PhaseAccumulator(0)
+{
+}
+
+TSharedPtr<const FConvaiPolyphaseFilterTable, ESPMode::ThreadSafe> FConvaiResampler::GetFilterTable(int32 InSourceSampleRate, int32 InTargetSampleRate)
+{
+	static FCriticalSection TableCacheMutex;
+	static TMap<uint64, TSharedPtr<const FConvaiPolyphaseFilterTable, ESPMode::ThreadSafe>> TableCache;
+
+	const uint64 Key = (static_cast<uint64>(InSourceSampleRate) << 32) | static_cast<uint32>(InTargetSampleRate);
+
+	FScopeLock Lock(&TableCacheMutex);
+	if (const TSharedPtr<const FConvaiPolyphaseFilterTable, ESPMode::ThreadSafe>* Found = TableCache.Find(Key))
+	{
+		return *Found;
+	}
+
+	TSharedPtr<const FConvaiPolyphaseFilterTable, ESPMode::ThreadSafe> NewTable = BuildFilterTable(InSourceSampleRate, InTargetSampleRate);
+	TableCache.Add(Key, NewTable);
+	return NewTable;
+}
+
+void FConvaiResampler::Initialize(int32 InSourceSampleRate, int32 InTargetSampleRate, int32 InNumChannels)
+{
+	if (InSourceSampleRate <= 0 || InTargetSampleRate <= 0 || InNumChannels <= 0)
+	{
+		CONVAI_LOG(ConvaiResamplerLog, Warning, TEXT("Invalid resampler configuration: %d -> %d Hz, %d channels"), InSourceSampleRate, InTargetSampleRate, InNumChannels);
+		return;
+	}
+
+	if (IsInitialized() && InSourceSampleRate == SourceSampleRate && InTargetSampleRate == TargetSampleRate && InNumChannels == NumChannels)
+	{
+		return;
+	}
+
+	SourceSampleRate = InSourceSampleRate;
+	TargetSampleRate = InTargetSampleRate;
+	NumChannels = InNumChannels;
+	bPassthrough = SourceSampleRate == TargetSampleRate;
+	if (bPassthrough)
+	{
+		Table.Reset();
+	}
+	else
+	{
+		Table = GetFilterTable(SourceSampleRate, TargetSampleRate);
+	}
+
+	Reset();
+}
+
+void FConvaiResampler::Reset()
+{
+	PhaseAccumulator = 0;
+	History.Reset();
+
+	if (Table.IsValid())
+	{
+		// Prime with zeros so the first output is centered on the first input sample
+		History.AddZeroed(Table->NumTaps / 2 - 1);
+	}
+}
+
+int32 FConvaiResampler::Process(const int16* InSamples, int32 NumFrames, TArray<int16>& OutSamples)
+{
+	return ProcessInternal(InSamples, NumFrames, OutSamples);
+}
+
+int32 FConvaiResampler::Process(const float* InSamples, int32 NumFrames, TArray<int16>& OutSamples)
+{
+	return ProcessInternal(InSamples, NumFrames, OutSamples);
+}
+
+int32 FConvaiResampler::Process(const Audio::AlignedFloatBuffer& InBuffer, TArray<int16>& OutSamples)
+{
+	if (NumChannels <= 0)
+	{
+		return 0;
+	}
+	return ProcessInternal(InBuffer.GetData(), InBuffer.Num() / NumChannels, OutSamples);
+}
+
+template<typename SampleType>
+int32 FConvaiResampler::ProcessInternal(const SampleType* InSamples, int32 NumFrames, TArray<int16>& OutSamples)
+{
+	if (!InSamples || NumFrames <= 0 || !IsInitialized())
+	{
+		return 0;
+	}
+
+	if (bPassthrough)
+	{
+		// Same rate: downmix straight into the output
+		const int32 OutStart = OutSamples.Num();
+		OutSamples.AddUninitialized(NumFrames);
+		int16* Out = OutSamples.GetData() + OutStart;
+
+		if (NumChannels == 1)
+		{
+			for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+			{
+				Out[Frame] = FloatToInt16(SampleToFloat(InSamples[Frame]));
+			}
+		}
+		else
+		{
+			const float ChannelScale = 1.0f / NumChannels;
+			for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+			{
+				float Sum = 0.0f;
+				for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+				{
+					Sum += SampleToFloat(InSamples[Frame * NumChannels + Channel]);
+				}
+				Out[Frame] = FloatToInt16(Sum * ChannelScale);
+			}
+		}
+		return NumFrames;
+	}
+
+	const int32 HistoryStart = History.Num();
+	History.AddUninitialized(NumFrames);
+	DownmixToMono(InSamples, NumFrames, NumChannels, History.GetData() + HistoryStart);
+
+	return FilterHistory(OutSamples);
+}
+
+int32 FConvaiResampler::FilterHistory(TArray<int16>& OutSamples)
+{
+	const FConvaiPolyphaseFilterTable& Filter = *Table;
+	const int32 NumTaps = Filter.NumTaps;
+	const int32 LastBase = History.Num() - NumTaps;
+	if (LastBase < 0)
+	{
+		return 0;
+	}
+
+	// Output k reads History from floor((PhaseAccumulator + k * Step) / Interpolation), which must be <= LastBase
+	const int64 Span = static_cast<int64>(LastBase + 1) * Filter.Interpolation - PhaseAccumulator;
+	const int32 NumOutputs = Span > 0 ? static_cast<int32>((Span + Filter.Step - 1) / Filter.Step) : 0;
+
+	const int32 OutStart = OutSamples.Num();
+	OutSamples.AddUninitialized(NumOutputs);
+	int16* Out = OutSamples.GetData() + OutStart;
+
+	const float* Input = History.GetData();
+	const bool bExactPhases = Filter.NumPhases == Filter.Interpolation;
+	int32 Base = 0;
+	int32 Phase = PhaseAccumulator;
+
+	for (int32 OutIndex = 0; OutIndex < NumOutputs; ++OutIndex)
+	{
+		const int32 PhaseIndex = bExactPhases ? Phase : static_cast<int32>(static_cast<int64>(Phase) * Filter.NumPhases / Filter.Interpolation);
+		Out[OutIndex] = FloatToInt16(DotProduct(Input + Base, Filter.GetPhase(PhaseIndex), NumTaps));
+
+		Phase += Filter.Step;
+		Base += Phase / Filter.Interpolation;
+		Phase %= Filter.Interpolation;
+	}
+
+	// Keep the unconsumed tail (at most NumTaps samples) for the next chunk
+	PhaseAccumulator = Phase;
+#if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 5
+	History.RemoveAt(0, Base, EAllowShrinking::No);
+#else
+	History.RemoveAt(0, Base, false);
+#endif
+
+	return NumOutputs;
+}
+
+#if !UE_BUILD_SHIPPING
+static FAutoConsoleCommand ConvaiBenchmarkResamplerCommand(
+	TEXT("Convai.Audio.BenchmarkResampler"),
+	TEXT("Compares FConvaiResampler with UConvaiUtils::ResampleAudio on 10ms stereo chunks. Usage: Convai.Audio.BenchmarkResampler [SourceRate] [Iterations]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic([](const TArray<FString>& Args)
+	{
+		const int32 SourceRate = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 48000;
+		const int32 Iterations = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 1000;
+		const int32 TargetRate = ConvaiConstants::VoiceCaptureSampleRate;
+		const int32 Channels = 2;
+		const int32 FramesPerChunk = SourceRate / 100;
+
+		if (SourceRate <= 0 || Iterations <= 0)
+		{
+			return;
+		}
+
+		TArray<int16> Input;
+		Input.SetNumUninitialized(FramesPerChunk * Channels);
+		for (int32 Frame = 0; Frame < FramesPerChunk; ++Frame)
+		{
+			const int16 Value = static_cast<int16>(16000.0f * FMath::Sin(2.0f * PI * 440.0f * Frame / SourceRate));
+			Input[Frame * Channels] = Value;
+			Input[Frame * Channels + 1] = Value;
+		}
+
+		TArray<int16> Output;
+		Output.Reserve(TargetRate);
+
+		const double LegacyStart = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			UConvaiUtils::ResampleAudio(SourceRate, TargetRate, Channels, true, Input, Input.Num(), Output);
+		}
+		const double LegacySeconds = FPlatformTime::Seconds() - LegacyStart;
+
+		FConvaiResampler Resampler;
+		Resampler.Initialize(SourceRate, TargetRate, Channels);
+		const double PolyphaseStart = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			Output.Reset();
+			Resampler.Process(Input.GetData(), FramesPerChunk, Output);
+		}
+		const double PolyphaseSeconds = FPlatformTime::Seconds() - PolyphaseStart;
+
+		CONVAI_LOG(ConvaiResamplerLog, Display, TEXT("Resampler benchmark %d -> %d Hz, %d chunks of 10ms stereo: ResampleAudio %.3f us/chunk, FConvaiResampler %.3f us/chunk"),
+			SourceRate, TargetRate, Iterations, LegacySeconds * 1e6 / Iterations, PolyphaseSeconds * 1e6 / Iterations);
+	}));
+#endif
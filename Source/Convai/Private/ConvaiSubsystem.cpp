@@ -7,7 +7,8 @@
 #include "ConvaiAndroid.h"
 #include "ConvaiChatbotComponent.h"
 #include "ConvaiPlayerComponent.h"
-#include "ConvaiReferenceAudioThread.h"
+#include "ConvaiReferenceAudioCapture.h"
+#include "ConvaiDataPacketParser.h"
 #include "HttpModule.h"
 #include "convai/convai_client.h"
 #include "../Convai.h"
@@ -20,171 +21,20 @@ DEFINE_LOG_CATEGORY(ConvaiClientLog);
 
 namespace
 {
-    enum class EC_PacketType : uint8
-    {
-        UserStartedSpeaking,
-        UserStoppedSpeaking,
-        UserTranscription,
-        BotLLMStarted,
-        BotLLMStopped,
-        BotStartedSpeaking,
-        BotStoppedSpeaking,
-        BotTranscription,
-        ServerMessage,
-        BotReady,
-        BotLLMText,
-        UserLLMText,
-        BotTTSStarted,
-        BotTTSStopped,
-        BotTTSText,
-        Error,
-        Unknown
-    };
-
-    enum class EC_ServerPacketType : uint8
+    // Helper function to convert decoded viseme weights to FAnimationSequence
+    inline void ConvertVisemeDataToAnimationSequence(const float (&Visemes)[FConvaiDataPacket::NumVisemes], FAnimationSequence& OutAnimationSequence) noexcept
     {
-        BotEmotion,
-        ActionResponse,
-        BTResponse,
-        ModerationResponse,
-        Visemes,
-        Unknown
-    };
-
-    inline EC_PacketType ToPacketType(const FString& In) noexcept
-    {
-        if (In == TEXT("user-started-speaking"))   return EC_PacketType::UserStartedSpeaking;
-        if (In == TEXT("user-stopped-speaking"))   return EC_PacketType::UserStoppedSpeaking;
-        if (In == TEXT("user-transcription"))      return EC_PacketType::UserTranscription;
-        if (In == TEXT("bot-llm-started"))         return EC_PacketType::BotLLMStarted;
-        if (In == TEXT("bot-llm-stopped"))         return EC_PacketType::BotLLMStopped;
-        if (In == TEXT("bot-started-speaking"))    return EC_PacketType::BotStartedSpeaking;
-        if (In == TEXT("bot-stopped-speaking"))    return EC_PacketType::BotStoppedSpeaking;
-        if (In == TEXT("bot-transcription"))       return EC_PacketType::BotTranscription;
-        if (In == TEXT("server-message"))          return EC_PacketType::ServerMessage;
-        if (In == TEXT("bot-ready"))               return EC_PacketType::BotReady;
-        if (In == TEXT("bot-llm-text"))            return EC_PacketType::BotLLMText;
-        if (In == TEXT("user-llm-text"))           return EC_PacketType::UserLLMText;
-        if (In == TEXT("bot-tts-started"))         return EC_PacketType::BotTTSStarted;
-        if (In == TEXT("bot-tts-stopped"))         return EC_PacketType::BotTTSStopped;
-        if (In == TEXT("bot-tts-text"))            return EC_PacketType::BotTTSText;
-        if (In == TEXT("error"))                   return EC_PacketType::Error;
-        return EC_PacketType::Unknown;
-    }
-
-    inline EC_ServerPacketType ToServerPacketType(const FString& In) noexcept
-    {
-        if (In == TEXT("bot-emotion"))             return EC_ServerPacketType::BotEmotion;        
-        if (In == TEXT("action-response"))         return EC_ServerPacketType::ActionResponse;    
-        if (In == TEXT("behavior-tree-response"))  return EC_ServerPacketType::BTResponse;        
-        if (In == TEXT("moderation-response"))     return EC_ServerPacketType::ModerationResponse;
-        if (In == TEXT("visemes"))                 return EC_ServerPacketType::Visemes;
-        return EC_ServerPacketType::Unknown;
-    }
-
-    // Helper function to convert server viseme data to FAnimationSequence
-    inline void ConvertVisemeDataToAnimationSequence(const TSharedPtr<FJsonObject>& VisemeDataObj, FAnimationSequence& OutAnimationSequence) noexcept
-    {
-        // Clear any existing data
+        // A single packed frame, weights are already in VisemeNames order and clamped by the parser
+        checkSlow(FConvaiPackedFrames::GetNumCurves(EConvaiCurveSet::Visemes) == FConvaiDataPacket::NumVisemes);
         OutAnimationSequence.AnimationFrames.Empty();
-        OutAnimationSequence.Duration = 0.0f;
-        OutAnimationSequence.FrameRate = 0;
-        
-        if (!VisemeDataObj.IsValid())
-        {
-            return;
-        }
-        
-        // Get the visemes object from the data
-        const TSharedPtr<FJsonObject>* VisemesObj;
-        if (!VisemeDataObj->TryGetObjectField(TEXT("visemes"), VisemesObj) || !VisemesObj->IsValid())
-        {
-            return;
-        }
-        
-        // Create a single animation frame
-        FAnimationFrame AnimationFrame;
-        AnimationFrame.FrameIndex = 0;
-        
-        // Map server viseme names to expected names and extract values
-        const TMap<FString, FString> VisemeNameMapping = {
-            {TEXT("sil"), TEXT("sil")},
-            {TEXT("pp"), TEXT("PP")},
-            {TEXT("ff"), TEXT("FF")},
-            {TEXT("th"), TEXT("TH")},
-            {TEXT("dd"), TEXT("DD")},
-            {TEXT("kk"), TEXT("kk")},
-            {TEXT("ch"), TEXT("CH")},
-            {TEXT("ss"), TEXT("SS")},
-            {TEXT("nn"), TEXT("nn")},
-            {TEXT("rr"), TEXT("RR")},
-            {TEXT("aa"), TEXT("aa")},
-            {TEXT("e"), TEXT("E")},
-            {TEXT("ih"), TEXT("ih")},
-            {TEXT("oh"), TEXT("oh")},
-            {TEXT("ou"), TEXT("ou")}
-        };
-        
-        // Initialize all visemes to 0
-        for (const FString& VisemeName : ConvaiConstants::VisemeNames)
-        {
-            AnimationFrame.BlendShapes.Add(*VisemeName, 0.0f);
-        }
-        
-        // Extract viseme values from server data
-        for (const auto& Mapping : VisemeNameMapping)
-        {
-            double VisemeValue = 0.0;
-            if ((*VisemesObj)->TryGetNumberField(Mapping.Key, VisemeValue))
-            {
-                // Clamp values between 0 and 1
-                float ClampedValue = FMath::Clamp(static_cast<float>(VisemeValue), 0.0f, 1.0f);
-                AnimationFrame.BlendShapes[*Mapping.Value] = ClampedValue;
-            }
-        }
-        
-        // Add the frame to the sequence
-        OutAnimationSequence.AnimationFrames.Add(AnimationFrame);
+        OutAnimationSequence.PackedFrames.Reset(EConvaiCurveSet::Visemes);
+        FMemory::Memcpy(OutAnimationSequence.PackedFrames.AddFrame(), Visemes, sizeof(Visemes));
+
         OutAnimationSequence.Duration = 0.01f; // Short duration for real-time visemes
         OutAnimationSequence.FrameRate = 100; // 100 FPS for real-time updates
+        OutAnimationSequence.PackedFrames.FrameRate = OutAnimationSequence.FrameRate;
     }
     
-    inline TSharedPtr<FJsonObject> ParseJsonObject(const FString& JsonStr) noexcept
-    {
-        TSharedPtr<FJsonObject> Root;
-        const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonStr);
-        if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid())
-        {
-            return nullptr;
-        }
-        return Root;
-    }
-
-    inline bool GetStringSafe(const TSharedPtr<FJsonObject>& Obj, const TCHAR* Field, FString& Out) noexcept
-    {
-        Out.Reset();
-        return Obj.IsValid() && Obj->TryGetStringField(Field, Out);
-    }
-
-    inline bool GetBoolSafe(const TSharedPtr<FJsonObject>& Obj, const TCHAR* Field, bool& Out) noexcept
-    {
-        Out = false;
-        return Obj.IsValid() && Obj->TryGetBoolField(Field, Out);
-    }
-
-    inline bool GetNumberSafe(const TSharedPtr<FJsonObject>& Obj, const TCHAR* Field, double& Out) noexcept
-    {
-        Out = 0.0;
-        return Obj.IsValid() && Obj->TryGetNumberField(Field, Out);
-    }
-
-    // Handy extractor for the "data" object.
-    inline TSharedPtr<FJsonObject> GetDataObject(const TSharedPtr<FJsonObject>& Root) noexcept
-    {
-        const TSharedPtr<FJsonObject>* DataObjPtr = nullptr;
-        return (Root.IsValid() && Root->TryGetObjectField(TEXT("data"), DataObjPtr)) ? *DataObjPtr : nullptr;
-    }
-
     static UConvaiSubsystem* GetConvaiSubsystemInstance()
     {
         UConvaiSubsystem* Subsystem = nullptr;
@@ -289,39 +139,8 @@ uint32 FConvaiConnectionThread::Run()
 {
     if (ConnectionParams.Client)
     {
-        convai::ConvaiAECConfig Config;
-        
-        // Set AEC type
-        const FString AECTypeStr = UConvaiUtils::GetAECType();
-        if (AECTypeStr.Equals(TEXT("Internal"), ESearchCase::IgnoreCase))
-        {
-            Config.aec_type = convai::AECType::Internal;
-        }
-        else if (AECTypeStr.Equals(TEXT("None"), ESearchCase::IgnoreCase))
-        {
-            Config.aec_type = convai::AECType::None;
-        }
-        else // Default to External
-        {
-            Config.aec_type = convai::AECType::External;
-        }
-        
-        // Common settings
-        Config.aec_enabled = UConvaiUtils::IsAECEnabled();
-        Config.noise_suppression_enabled = UConvaiUtils::IsNoiseSuppressionEnabled();
-        Config.gain_control_enabled = UConvaiUtils::IsGainControlEnabled();
-        
-        // WebRTC AEC specific settings
-        Config.vad_enabled = UConvaiUtils::IsVADEnabled();
-        Config.vad_mode = UConvaiUtils::GetVADMode();
-        
-        // Core AEC specific settings
-        Config.high_pass_filter_enabled = UConvaiUtils::IsHighPassFilterEnabled();
-        
-        // Audio settings
-        Config.sample_rate = ConvaiConstants::WebRTCAudioSampleRate;
-        
-        if (!ConnectionParams.Client->Initialize(Config))
+        // Pooled clients were initialized ahead of time
+        if (!ConnectionParams.bIsClientInitialized && !FConvaiClientPool::InitializeClient(*ConnectionParams.Client))
         {
             CONVAI_LOG(ConvaiSubsystemLog, Error, TEXT("Failed to Initialize client"));
             return 1;
@@ -338,52 +157,27 @@ uint32 FConvaiConnectionThread::Run()
         const FString StreamURLString = UConvaiUtils::GetStreamURL();
         FString AuthKeyHeader = AuthHeaderAndKey.Key;
         const FString AuthKeyValue = AuthHeaderAndKey.Value;
+        const FString BlendshapeProvider = ConnectionParams.GetNegotiatedBlendshapeProvider();
 
         if (ConvaiConstants::API_Key_Header == AuthKeyHeader)
         {
             AuthKeyHeader = TEXT("X-API-KEY");
         }
         
-        // Safe UTF8 conversion with explicit null termination
-        constexpr int32 BUFFER_SIZE = 512;
-        auto SafeConvertToUTF8 = [](char* Buffer, int32 BufferSize, const TCHAR* Source) -> int32
-        {
-            FTCHARToUTF8 UTF8Converter(Source);
-            const char* UTF8Source = UTF8Converter.Get();
-            const int32 UTF8Len = FCStringAnsi::Strlen(UTF8Source);
-            
-            if (UTF8Len < BufferSize) {
-                FCStringAnsi::Strncpy(Buffer, UTF8Source, BufferSize - 1);
-                Buffer[UTF8Len] = '\0'; // Explicit null termination
-                return UTF8Len;
-            }
-            return -1;
+        // Convert all connection parameters into one null-separated UTF8 block, the config points into it
+        const FString* const Sources[] = {
+            &StreamURLString, &AuthKeyHeader, &AuthKeyValue, &ConnectionParams.CharacterID,
+            &ConnectionParams.ConnectionType, &ConnectionParams.LLMProvider, &BlendshapeProvider, &ConnectionParams.SpeakerID
         };
-        
-        // Convert all connection parameters to UTF8
-        char StreamURLBuffer[BUFFER_SIZE];
-        char AuthKeyHeaderBuffer[BUFFER_SIZE];
-        char AuthKeyValueBuffer[BUFFER_SIZE];
-        char CharIDBuffer[BUFFER_SIZE];
-        char ConnectionTypeBuffer[BUFFER_SIZE];
-        char LLMProviderBuffer[BUFFER_SIZE];
-        char BlendshapeProviderBuffer[BUFFER_SIZE];
-        char SpeakerIDBuffer[BUFFER_SIZE];
-
-        const int32 StreamURLLen = SafeConvertToUTF8(StreamURLBuffer, BUFFER_SIZE, *StreamURLString);
-        const int32 AuthKeyHeaderLen = SafeConvertToUTF8(AuthKeyHeaderBuffer, BUFFER_SIZE, *AuthKeyHeader);
-        const int32 AuthKeyValueLen = SafeConvertToUTF8(AuthKeyValueBuffer, BUFFER_SIZE, *AuthKeyValue);
-        const int32 CharIDLen = SafeConvertToUTF8(CharIDBuffer, BUFFER_SIZE, *ConnectionParams.CharacterID);
-        const int32 ConnectionTypeLen = SafeConvertToUTF8(ConnectionTypeBuffer, BUFFER_SIZE, *ConnectionParams.ConnectionType);
-        const int32 LLMProviderLen = SafeConvertToUTF8(LLMProviderBuffer, BUFFER_SIZE, *ConnectionParams.LLMProvider);
-        const int32 BlendshapeProviderLen = SafeConvertToUTF8(BlendshapeProviderBuffer, BUFFER_SIZE, *ConnectionParams.BlendshapeProvider);
-        const int32 SpeakerIDLen = SafeConvertToUTF8(SpeakerIDBuffer, BUFFER_SIZE, *ConnectionParams.SpeakerID);
-        
-        // Validate all conversions succeeded
-        if (StreamURLLen < 0 || AuthKeyHeaderLen < 0 || AuthKeyValueLen < 0 || CharIDLen < 0 || ConnectionTypeLen < 0 || LLMProviderLen < 0 || BlendshapeProviderLen < 0 || SpeakerIDLen < 0)
+        constexpr int32 NumSources = UE_ARRAY_COUNT(Sources);
+        int32 Offsets[NumSources];
+        TArray<ANSICHAR, TInlineAllocator<1024>> UTF8Block;
+        for (int32 Index = 0; Index < NumSources; ++Index)
         {
-            CONVAI_LOG(ConvaiSubsystemLog, Error, TEXT("Failed to convert one or more strings to UTF8"));
-            return 1;
+            const FTCHARToUTF8 UTF8Converter(**Sources[Index]);
+            Offsets[Index] = UTF8Block.Num();
+            UTF8Block.Append(UTF8Converter.Get(), UTF8Converter.Length());
+            UTF8Block.Add('\0');
         }
         
         // Log connection parameters
@@ -392,23 +186,24 @@ uint32 FConvaiConnectionThread::Run()
         CONVAI_LOG(ConvaiSubsystemLog, Log, TEXT("CharacterID: %s"), *ConnectionParams.CharacterID);
         CONVAI_LOG(ConvaiSubsystemLog, Log, TEXT("ConnectionType: %s"), *ConnectionParams.ConnectionType);
         CONVAI_LOG(ConvaiSubsystemLog, Log, TEXT("LLMProvider: %s"), *ConnectionParams.LLMProvider);
-        CONVAI_LOG(ConvaiSubsystemLog, Log, TEXT("BlendshapeProvider: %s"), *ConnectionParams.BlendshapeProvider);
+        CONVAI_LOG(ConvaiSubsystemLog, Log, TEXT("BlendshapeProvider: %s"), *BlendshapeProvider);
         CONVAI_LOG(ConvaiSubsystemLog, Log, TEXT("SpeakerID: %s"), *ConnectionParams.SpeakerID);
         
         // Create connection config struct for the new Connect API
+        const ANSICHAR* UTF8Data = UTF8Block.GetData();
         convai::ConvaiConnectionConfig config;
-        config.url = StreamURLBuffer;
-        config.auth_value = AuthKeyValueBuffer;
-        config.auth_header = AuthKeyHeaderBuffer;
-        config.character_id = CharIDBuffer;
-        config.connection_type = ConnectionTypeBuffer;
-        config.llm_provider = LLMProviderBuffer;
-        config.blendshape_provider = BlendshapeProviderBuffer;
-        config.speaker_id = SpeakerIDBuffer;
+        config.url = UTF8Data + Offsets[0];
+        config.auth_header = UTF8Data + Offsets[1];
+        config.auth_value = UTF8Data + Offsets[2];
+        config.character_id = UTF8Data + Offsets[3];
+        config.connection_type = UTF8Data + Offsets[4];
+        config.llm_provider = UTF8Data + Offsets[5];
+        config.blendshape_provider = UTF8Data + Offsets[6];
+        config.speaker_id = UTF8Data + Offsets[7];
         
         if (!ConnectionParams.Client->Connect(config))
         {
-            UConvaiSubsystem::OnConnectionFailed();
+            UConvaiSubsystem::OnConnectionFailed(ConnectionParams.Client);
             CONVAI_LOG(ConvaiSubsystemLog, Error, TEXT("Failed to connect to Convai service"));
             return 2;
         }
@@ -422,872 +217,1638 @@ uint32 FConvaiConnectionThread::Run()
     return 0;
 }
 
-// Convai Subsystem Implementation
-UConvaiSubsystem::UConvaiSubsystem()
-    : bIsConnected(false)
-    , bStartedPublishingVideo(false)
-    , CurrentCharacterSession(nullptr)
-    , CurrentPlayerSession(nullptr)
+// Client Pool Implementation
+FConvaiClientPool::FConvaiClientPool(const int32 InMaxIdleClients)
+    : TargetIdleClients(0)
+    , MaxIdleClients(FMath::Max(1, InMaxIdleClients))
+    , bIsEmptied(false)
 {
 }
 
-void UConvaiSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+FConvaiClientPool::~FConvaiClientPool()
 {
-    Super::Initialize(Collection);
+    Empty();
 }
 
-void UConvaiSubsystem::Deinitialize()
+bool FConvaiClientPool::InitializeClient(convai::ConvaiClient& Client)
 {
-    // Cleanup the Client client
-    CleanupConvaiClient();
+    convai::ConvaiAECConfig Config;
     
-    Super::Deinitialize();
+    // Set AEC type
+    const FString AECTypeStr = UConvaiUtils::GetAECType();
+    if (AECTypeStr.Equals(TEXT("Internal"), ESearchCase::IgnoreCase))
+    {
+        Config.aec_type = convai::AECType::Internal;
+    }
+    else if (AECTypeStr.Equals(TEXT("None"), ESearchCase::IgnoreCase))
+    {
+        Config.aec_type = convai::AECType::None;
+    }
+    else // Default to External
+    {
+        Config.aec_type = convai::AECType::External;
+    }
+    
+    // Common settings
+    Config.aec_enabled = UConvaiUtils::IsAECEnabled();
+    Config.noise_suppression_enabled = UConvaiUtils::IsNoiseSuppressionEnabled();
+    Config.gain_control_enabled = UConvaiUtils::IsGainControlEnabled();
+    
+    // WebRTC AEC specific settings
+    Config.vad_enabled = UConvaiUtils::IsVADEnabled();
+    Config.vad_mode = UConvaiUtils::GetVADMode();
+    
+    // Core AEC specific settings
+    Config.high_pass_filter_enabled = UConvaiUtils::IsHighPassFilterEnabled();
+    
+    // Audio settings
+    Config.sample_rate = ConvaiConstants::WebRTCAudioSampleRate;
+    
+    return Client.Initialize(Config);
 }
 
-void UConvaiSubsystem::RegisterChatbotComponent(UConvaiChatbotComponent* ChatbotComponent)
+void FConvaiClientPool::Prewarm(const int32 NumClients)
 {
-    if (ChatbotComponent && !RegisteredChatbotComponents.Contains(ChatbotComponent))
     {
-        RegisteredChatbotComponents.Add(ChatbotComponent);
+        FScopeLock Lock(&Mutex);
+        TargetIdleClients = FMath::Max(0, NumClients);
+        MaxIdleClients = FMath::Max(MaxIdleClients, TargetIdleClients);
     }
+    Refill();
 }
 
-void UConvaiSubsystem::UnregisterChatbotComponent(UConvaiChatbotComponent* ChatbotComponent)
+TUniquePtr<convai::ConvaiClient> FConvaiClientPool::Acquire()
 {
-    if (RegisteredChatbotComponents.Contains(ChatbotComponent))
+    TUniquePtr<convai::ConvaiClient> Client;
     {
-        ChatbotComponent->StopSession();
-        RegisteredChatbotComponents.Remove(ChatbotComponent);
+        FScopeLock Lock(&Mutex);
+        if (IdleClients.Num() > 0)
+        {
+#if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 5
+            Client = IdleClients.Pop(EAllowShrinking::No);
+#else
+            Client = IdleClients.Pop(false);
+#endif
+            ++Stats.NumHits;
+        }
+        else
+        {
+            ++Stats.NumMisses;
+        }
     }
-}
 
-TArray<UConvaiChatbotComponent*> UConvaiSubsystem::GetAllChatbotComponents() const
-{
-    return RegisteredChatbotComponents;
+    // Top the pool back up for the next connection
+    Refill();
+    return Client;
 }
 
-void UConvaiSubsystem::RegisterPlayerComponent(UConvaiPlayerComponent* PlayerComponent)
+void FConvaiClientPool::Return(TUniquePtr<convai::ConvaiClient> Client)
 {
-    if (PlayerComponent && !RegisteredPlayerComponents.Contains(PlayerComponent))
+    if (!Client)
     {
-        RegisteredPlayerComponents.Add(PlayerComponent);
-        CONVAI_LOG(ConvaiSubsystemLog, Verbose, TEXT("Registered player component: %s"), *PlayerComponent->GetName());
+        return;
     }
-}
 
-void UConvaiSubsystem::UnregisterPlayerComponent(UConvaiPlayerComponent* PlayerComponent)
-{
-    if (RegisteredPlayerComponents.Contains(PlayerComponent))
+    FScopeLock Lock(&Mutex);
+    if (!bIsEmptied && IdleClients.Num() < MaxIdleClients)
     {
-        PlayerComponent->StopSession();
-        RegisteredPlayerComponents.Remove(PlayerComponent);
-        CONVAI_LOG(ConvaiSubsystemLog, Verbose, TEXT("Unregistered player component: %s"), *PlayerComponent->GetName());
+        IdleClients.Add(MoveTemp(Client));
+        ++Stats.NumRecycled;
     }
+    // Otherwise the client is destroyed when it goes out of scope
 }
 
-TArray<UConvaiPlayerComponent*> UConvaiSubsystem::GetAllPlayerComponents() const
+void FConvaiClientPool::Empty()
 {
-    return RegisteredPlayerComponents;
+    TArray<TUniquePtr<convai::ConvaiClient>> ClientsToDestroy;
+    {
+        FScopeLock Lock(&Mutex);
+        bIsEmptied = true;
+        TargetIdleClients = 0;
+        ClientsToDestroy = MoveTemp(IdleClients);
+    }
+
+    // Destroyed outside the lock, tearing a client down can take a while
 }
 
-void UConvaiSubsystem::GetAndroidMicPermission()
+FConvaiClientPool::FStats FConvaiClientPool::GetStats() const
 {
-	if (!UConvaiAndroid::ConvaiAndroidHasMicrophonePermission())
-		UConvaiAndroid::ConvaiAndroidAskMicrophonePermission();
+    FScopeLock Lock(&Mutex);
+    FStats Result = Stats;
+    Result.NumIdle = IdleClients.Num();
+    return Result;
 }
 
-bool UConvaiSubsystem::ConnectSession(UConvaiConnectionSessionProxy* SessionProxy, const FString& CharacterID)
+void FConvaiClientPool::Refill()
 {
-    if (!IsValid(SessionProxy))
-    {
-        CONVAI_LOG(ConvaiSubsystemLog, Error, TEXT("Failed to connect session: Invalid session proxy"));
-        return false;
-    }
-    
-    // For player sessions, handle replacement properly
-    if (SessionProxy->IsPlayerSession())
+    int32 NumToInitialize = 0;
     {
-        const UConvaiConnectionSessionProxy* OldSession = nullptr;
-        
-        // Acquire lock, check and swap sessions
+        FScopeLock Lock(&Mutex);
+        if (bIsEmptied)
         {
-            FScopeLock SessionLock(&SessionMutex);
-            
-            // If there's an existing player session, store it for notification
-            if (IsValid(CurrentPlayerSession) && CurrentPlayerSession != SessionProxy)
-            {
-                CONVAI_LOG(ConvaiSubsystemLog, Warning, TEXT("Replacing existing player session"));
-                OldSession = CurrentPlayerSession;
-            }
-            
-            // Store the new player session
-            CurrentPlayerSession = SessionProxy;
+            return;
         }
-        // Lock released here
-        
-        // Notify old session outside the lock to avoid deadlock
-        if (IsValid(OldSession))
+        NumToInitialize = TargetIdleClients - IdleClients.Num() - Stats.NumInitializing;
+        if (NumToInitialize <= 0)
         {
-            if (const TScriptInterface<IConvaiConnectionInterface> Interface = OldSession->GetConnectionInterface(); Interface.GetObject())
-            {
-                Interface->OnDisconnectedFromServer();
-            }
+            return;
         }
-        
-        return true;
+        Stats.NumInitializing += NumToInitialize;
     }
-    
-    if (CharacterID.IsEmpty())
+
+    TWeakPtr<FConvaiClientPool, ESPMode::ThreadSafe> WeakPool = AsShared();
+    for (int32 Index = 0; Index < NumToInitialize; ++Index)
     {
-        CONVAI_LOG(ConvaiSubsystemLog, Error, TEXT("Failed to connect session: Character ID is empty"))
-        return false;
+        AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [WeakPool]()
+        {
+            TUniquePtr<convai::ConvaiClient> Client = MakeUnique<convai::ConvaiClient>();
+            const bool bInitialized = InitializeClient(*Client);
+            if (const TSharedPtr<FConvaiClientPool, ESPMode::ThreadSafe> Pool = WeakPool.Pin())
+            {
+                Pool->OnClientInitialized(MoveTemp(Client), bInitialized);
+            }
+        });
     }
-    
-    // If we already have a character session, just log it
-    // No need to notify - CleanupConvaiClient() handles full disconnection
-    if (IsValid(CurrentCharacterSession) && CurrentCharacterSession != SessionProxy)
+}
+
+void FConvaiClientPool::OnClientInitialized(TUniquePtr<convai::ConvaiClient> Client, const bool bInitialized)
+{
+    if (!bInitialized)
     {
-        CONVAI_LOG(ConvaiSubsystemLog, Warning, TEXT("Replacing existing character session"));
+        CONVAI_LOG(ConvaiSubsystemLog, Warning, TEXT("Failed to initialize a pooled client"));
     }
-    
-    // Clean up and reinitialize the Client (this handles all cleanup and disconnection)
-    CleanupConvaiClient();
-    
-    if (!InitializeConvaiClient())
+
+    FScopeLock Lock(&Mutex);
+    --Stats.NumInitializing;
+    if (bInitialized && !bIsEmptied && IdleClients.Num() < MaxIdleClients)
     {
-        CONVAI_LOG(ConvaiSubsystemLog, Error, TEXT("Failed to initialize Client client"));
-        return false;
+        IdleClients.Add(MoveTemp(Client));
     }
+}
 
-    if (ConvaiClient)
+// Character Connection Implementation
+FConvaiCharacterConnection::FConvaiCharacterConnection(UConvaiSubsystem* InSubsystem, const FString& InCharacterID, const TSharedPtr<FConvaiClientPool, ESPMode::ThreadSafe>& InClientPool)
+    : Subsystem(InSubsystem)
+    , CharacterID(InCharacterID)
+    , ClientPool(InClientPool)
+    , bUsedPooledClient(false)
+    , bCanRecycleClient(false)
+    , bIsConnected(false)
+    , bStartedPublishingVideo(false)
+    , bIsShutdown(false)
+    , LastUsedTime(FPlatformTime::Seconds())
+    , ConnectStartTime(LastUsedTime)
+    , SessionAttachTime(LastUsedTime)
+{
+}
+
+FConvaiCharacterConnection::~FConvaiCharacterConnection()
+{
+    Shutdown();
+
+    // Only clients that proved they can connect are handed to the next connection
+    if (Client && bCanRecycleClient && ClientPool.IsValid())
     {
-        FScopeLock SessionLock(&SessionMutex);
-        CurrentCharacterSession = SessionProxy;
-        
-        // Get raw pointer for connection params
-        convai::ConvaiClient* ClientPtr = ConvaiClient.Get();
-        FConvaiConnectionParams ConnectionParams = FConvaiConnectionParams::Create(ClientPtr, CharacterID, SessionProxy);
-        ConnectionThread = MakeUnique<FConvaiConnectionThread>(MoveTemp(ConnectionParams));
-        
-        // Broadcast that we're starting to connect
-        OnServerConnectionStateChangedEvent.Broadcast(EC_ConnectionState::Connecting);
-        
-        return true;
+        ClientPool->Return(MoveTemp(Client));
     }
-    
-    return false;
+    Client.Reset();
 }
 
-void UConvaiSubsystem::DisconnectSession(const UConvaiConnectionSessionProxy* SessionProxy)
+bool FConvaiCharacterConnection::Connect(const FConvaiConnectionParams& InConnectionParams)
 {
-    if (!IsValid(SessionProxy))
+    if (ClientPool.IsValid())
     {
-        CONVAI_LOG(ConvaiSubsystemLog, Warning, TEXT("DisconnectSession: Invalid session proxy"));
-        return;
+        Client = ClientPool->Acquire();
     }
-    
-    // If this is a player session, and it's the current one, clear it
-    if (SessionProxy->IsPlayerSession())
+    bUsedPooledClient = Client.IsValid();
+
+    if (!Client)
+    {
+        Client = MakeUnique<convai::ConvaiClient>();
+    }
+    if (!Client)
+    {
+        return false;
+    }
+    Client->SetConvaiClientListner(this);
+
+    ConnectionParams = InConnectionParams;
+    ConnectionParams.Client = Client.Get();
+    ConnectionParams.bIsClientInitialized = bUsedPooledClient;
+    ConnectStartTime = FPlatformTime::Seconds();
+
+    ConnectionThread = MakeUnique<FConvaiConnectionThread>(ConnectionParams);
+    return true;
+}
+
+void FConvaiCharacterConnection::Shutdown()
+{
+    if (bIsShutdown)
     {
-        FScopeLock SessionLock(&SessionMutex);
-        if (SessionProxy == CurrentPlayerSession)
-        {
-            CONVAI_LOG(ConvaiSubsystemLog, Log, TEXT("Disconnecting player session"));
-            CurrentPlayerSession = nullptr;
-        }
-        else
-        {
-            CONVAI_LOG(ConvaiSubsystemLog, Warning, TEXT("DisconnectSession: Player session is not the current active session"));
-        }
         return;
     }
-    
-    // If this is a character session, and it's the current one, disconnect the client
+    bIsShutdown = true;
+    bIsConnected = false;
+    bStartedPublishingVideo = false;
+
+    if (ConnectionThread.IsValid())
     {
-        FScopeLock SessionLock(&SessionMutex);
-        if (SessionProxy != CurrentCharacterSession)
-        {
-            CONVAI_LOG(ConvaiSubsystemLog, Warning, TEXT("DisconnectSession: Character session is not the current active session"));
-            return;
-        }
+        ConnectionThread->Stop();
+        ConnectionThread.Reset();
     }
-    
-    CONVAI_LOG(ConvaiSubsystemLog, Log, TEXT("Disconnecting character session"));
-    
-    // Disconnect the client with mutex protection
+
+    // Stop and cleanup reference audio capture
+    if (ReferenceAudioCapture.IsValid())
     {
-        FScopeLock ClientLock(&ConvaiClientMutex);
-        if (ConvaiClient)
+        if (ReferenceAudioCapture->IsCapturing())
         {
-            ConvaiClient->Disconnect();
-            bIsConnected = false;
+            ReferenceAudioCapture->StopCapture();
         }
+        ReferenceAudioCapture.Reset();
     }
-    
-    // Clear the current character session
+
+    if (Client)
     {
-        FScopeLock SessionLock(&SessionMutex);
-        CurrentCharacterSession = nullptr;
+        Client->Disconnect();
+        Client->SetConvaiClientListner(nullptr);
     }
 }
 
-int32 UConvaiSubsystem::SendAudio(const UConvaiConnectionSessionProxy* SessionProxy, const int16_t* AudioData, const size_t NumFrames) const
+void FConvaiCharacterConnection::OnConnectedToServer()
 {
-    if (!IsValid(SessionProxy) || !ConvaiClient || !bIsConnected)
-    {
-        return -1;
-    }
+    Subsystem->OnConnectedToServer(*this);
+}
 
-    ConvaiClient->SendAudio(AudioData, NumFrames);
-    
-    return 0;
+void FConvaiCharacterConnection::OnDisconnectedFromServer()
+{
+    Subsystem->OnDisconnectedFromServer(*this);
 }
 
-void UConvaiSubsystem::SendImage(const UConvaiConnectionSessionProxy* SessionProxy, const uint32 Width, const uint32 Height,
-                                 TArray<uint8>& Data)
+void FConvaiCharacterConnection::OnAudioData(const char* attendee_id, const int16_t* audio_data, size_t num_frames,
+                                             uint32_t sample_rate, uint32_t bits_per_sample, uint32_t num_channels)
 {
-    if (!IsValid(SessionProxy) || !ConvaiClient || !bIsConnected)
-    {
-        return;
-    }
-    
-    if (!bStartedPublishingVideo)
-    {
-        bStartedPublishingVideo = ConvaiClient->StartVideoPublishing(Width, Height);
-    }
-    else
-    {        
-        ConvaiClient->SendImage(Width, Height, Data.GetData());
-    }
+    Subsystem->OnAudioData(*this, attendee_id, audio_data, num_frames, sample_rate, bits_per_sample, num_channels);
 }
 
-void UConvaiSubsystem::SendTextMessage(const UConvaiConnectionSessionProxy* SessionProxy,const FString& Message) const
+void FConvaiCharacterConnection::OnAttendeeConnected(const char* attendee_id)
 {
-    if (!IsValid(SessionProxy) || !ConvaiClient || !bIsConnected)
-    {
-        return;
-    }
-    
-    ConvaiClient->SendTextMessage(TCHAR_TO_ANSI(*Message));
+    Subsystem->OnAttendeeConnected(*this, attendee_id);
 }
 
-void UConvaiSubsystem::SendTriggerMessage(const UConvaiConnectionSessionProxy* SessionProxy,const FString& Trigger_Name, const FString& Trigger_Message) const
+void FConvaiCharacterConnection::OnAttendeeDisconnected(const char* attendee_id)
 {
-    if (!IsValid(SessionProxy) || !ConvaiClient || !bIsConnected)
-    {
-        return;
-    }
-    
-    ConvaiClient->SendTriggerMessage(TCHAR_TO_ANSI(*Trigger_Name), TCHAR_TO_ANSI(*Trigger_Message));
+    Subsystem->OnAttendeeDisconnected(*this, attendee_id);
 }
 
-void UConvaiSubsystem::UpdateTemplateKeys(const UConvaiConnectionSessionProxy* SessionProxy,TMap<FString, FString> Template_Keys) const
+void FConvaiCharacterConnection::OnActiveSpeakerChanged(const char* Speaker)
 {
-    if (!IsValid(SessionProxy) || !ConvaiClient || !bIsConnected)
-    {
-        return;
+    const FString SpeakerStr  = UTF8_TO_TCHAR(Speaker);
+    CONVAI_LOG(ConvaiSubsystemLog, Log, TEXT("🎤 Active speaker changed: %s"), *SpeakerStr);
+}
+
+void FConvaiCharacterConnection::OnDataPacketReceived(const char* JsonData, const char* attendee_id)
+{
+    Subsystem->OnDataPacketReceived(*this, JsonData, attendee_id);
+}
+
+void FConvaiCharacterConnection::OnLog(const char* log_message)
+{
+    const FString LogStr      = UTF8_TO_TCHAR(log_message);
+    CONVAI_LOG(ConvaiClientLog, Verbose, TEXT("%s"), *LogStr);
+}
+
+void FConvaiCharacterConnection::QueueDataPacket(const char* JsonData, const int32 Length, const bool bSpeakingStateDelivered)
+{
+    FConvaiRawDataPacket RawPacket;
+    RawPacket.Json.Append(JsonData, Length);
+    RawPacket.bSpeakingStateDelivered = bSpeakingStateDelivered;
+    PacketInbox.Enqueue(MoveTemp(RawPacket));
+    NumPacketsReceived.fetch_add(1, std::memory_order_relaxed);
+
+    ScheduleDecodeTask();
+}
+
+void FConvaiCharacterConnection::TakeDecodedEvents(TArray<FConvaiDataPacketEvent>& OutEvents)
+{
+    // Backstop for a wake-up lost to the relaxed queue count in DecodePendingPackets
+    if (PacketInbox.Num() > 0 && !bDecodeTaskScheduled.load())
+    {
+        ScheduleDecodeTask();
+    }
+
+    // Swapping hands the drained array's allocation back to the decode stage
+    FScopeLock Lock(&DecodedEventsMutex);
+    Swap(OutEvents, DecodedEvents);
+}
+
+void FConvaiCharacterConnection::ScheduleDecodeTask()
+{
+    bool bExpected = false;
+    if (!bDecodeTaskScheduled.compare_exchange_strong(bExpected, true))
+    {
+        // A decode task is already pending and will pick up the new packet
+        return;
+    }
+
+    NumDecodeTasks.fetch_add(1, std::memory_order_relaxed);
+
+    TWeakPtr<FConvaiCharacterConnection, ESPMode::ThreadSafe> WeakSelf = AsShared();
+    AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [WeakSelf]()
+    {
+        if (const FConvaiCharacterConnectionPtr SharedThis = WeakSelf.Pin())
+        {
+            SharedThis->DecodePendingPackets();
+        }
+    });
+}
+
+void FConvaiCharacterConnection::DecodePendingPackets()
+{
+    FConvaiRawDataPacket RawPacket;
+    for (;;)
+    {
+        while (PacketInbox.Dequeue(RawPacket))
+        {
+            FConvaiDataPacketEvent Event;
+            if (!FConvaiDataPacketParser::Parse(RawPacket.Json.GetData(), RawPacket.Json.Num(), Event.Packet))
+            {
+                CONVAI_LOG(ConvaiSubsystemLog, Warning, TEXT("OnDataPacketReceived: Failed to parse packet or type field missing."));
+                continue;
+            }
+            Event.bSpeakingStateDelivered = RawPacket.bSpeakingStateDelivered;
+
+            const bool bIsServerMessage = Event.Packet.Type == EConvaiDataPacketType::ServerMessage;
+            const bool bIsVisemes = bIsServerMessage && Event.Packet.ServerType == EConvaiServerPacketType::Visemes;
+            const bool bIsPackedFrames = bIsServerMessage && Event.Packet.ServerType == EConvaiServerPacketType::PackedFrames;
+            if (bIsVisemes && Event.Packet.bHasVisemes)
+            {
+                ConvertVisemeDataToAnimationSequence(Event.Packet.Visemes, Event.FaceData);
+            }
+            else if (bIsPackedFrames && Event.Packet.bHasPackedFrames)
+            {
+                FConvaiPackedFrames& Frames = Event.Packet.PackedFrames;
+                Event.FaceData.Duration = Frames.FrameRate > 0 ? static_cast<float>(Frames.NumFrames) / Frames.FrameRate : 0.0f;
+                Event.FaceData.FrameRate = Frames.FrameRate;
+                Event.FaceData.PackedFrames = MoveTemp(Frames);
+            }
+
+            FScopeLock Lock(&DecodedEventsMutex);
+            FConvaiDataPacketEvent* Last = DecodedEvents.Num() > 0 ? &DecodedEvents.Last() : nullptr;
+            if ((bIsVisemes || bIsPackedFrames) && Last && Last->Packet.Type == EConvaiDataPacketType::ServerMessage && Last->Packet.ServerType == Event.Packet.ServerType
+                && Last->FaceData.PackedFrames.CurveSet == Event.FaceData.PackedFrames.CurveSet)
+            {
+                // Several face packets per frame become one multi-frame sequence
+                Last->FaceData.AppendFrames(Event.FaceData);
+                Last->FaceData.Duration += Event.FaceData.Duration;
+                NumVisemePacketsCoalesced.fetch_add(1, std::memory_order_relaxed);
+            }
+            else
+            {
+                DecodedEvents.Add(MoveTemp(Event));
+            }
+        }
+
+        bDecodeTaskScheduled.store(false);
+
+        // A packet may have arrived between the last dequeue and clearing the flag.
+        // Num is safe to read once another task may be consuming, IsEmpty is not.
+        if (PacketInbox.Num() == 0)
+        {
+            return;
+        }
+
+        bool bExpected = false;
+        if (!bDecodeTaskScheduled.compare_exchange_strong(bExpected, true))
+        {
+            return;
+        }
+    }
+}
+
+// Convai Subsystem Implementation
+UConvaiSubsystem::UConvaiSubsystem()
+    : MaxCharacterConnections(3)
+    , WarmConnectionTimeout(30.0f)
+    , CurrentPlayerSession(nullptr)
+{
+}
+
+void UConvaiSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    int32 MaxConnectionsSetting;
+    if (UConvaiSettingsUtils::GetParamValueAsInt("MaxCharacterConnections", MaxConnectionsSetting))
+    {
+        MaxCharacterConnections = FMath::Max(1, MaxConnectionsSetting);
+    }
+
+    float WarmTimeoutSetting;
+    if (UConvaiSettingsUtils::GetParamValueAsFloat("WarmConnectionTimeout", WarmTimeoutSetting))
+    {
+        WarmConnectionTimeout = FMath::Max(0.0f, WarmTimeoutSetting);
+    }
+
+    ClientPool = MakeShared<FConvaiClientPool, ESPMode::ThreadSafe>(MaxCharacterConnections);
+
+    int32 PrewarmedClientsSetting;
+    if (UConvaiSettingsUtils::GetParamValueAsInt("PrewarmedClients", PrewarmedClientsSetting) && PrewarmedClientsSetting > 0)
+    {
+        ClientPool->Prewarm(PrewarmedClientsSetting);
+    }
+
+    // The core ticker keeps running while the game is paused, unlike component ticks
+#if ENGINE_MAJOR_VERSION >= 5
+    GameThreadTasksTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UConvaiSubsystem::ProcessGameThreadTasks));
+#else
+    GameThreadTasksTickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UConvaiSubsystem::ProcessGameThreadTasks));
+#endif
+}
+
+void UConvaiSubsystem::Deinitialize()
+{
+#if ENGINE_MAJOR_VERSION >= 5
+    FTSTicker::GetCoreTicker().RemoveTicker(GameThreadTasksTickerHandle);
+#else
+    FTicker::GetCoreTicker().RemoveTicker(GameThreadTasksTickerHandle);
+#endif
+    GameThreadTasks.Empty();
+
+    // Disconnect every character, warm or attached
+    ReleaseAllConnections();
+
+    if (ClientPool.IsValid())
+    {
+        const FConvaiClientPool::FStats PoolStats = ClientPool->GetStats();
+        CONVAI_LOG(ConvaiSubsystemLog, Log, TEXT("Client pool: %d hits, %d misses, %d recycled. Average time to connected: %.0f ms over %d connections"),
+            PoolStats.NumHits, PoolStats.NumMisses, PoolStats.NumRecycled, ConnectionMetrics.GetAverageTimeToConnected() * 1000.0, ConnectionMetrics.NumConnections);
+        ClientPool->Empty();
+        ClientPool.Reset();
+    }
+
+    CONVAI_LOG(ConvaiSubsystemLog, Log, TEXT("Data packets: %lld received, %lld decode tasks, %lld viseme packets coalesced, %lld events delivered. Average drain %.1f us over %lld frames, max %.1f us"),
+        PacketDeliveryStats.NumPacketsReceived, PacketDeliveryStats.NumDecodeTasks, PacketDeliveryStats.NumVisemePacketsCoalesced, PacketDeliveryStats.NumEventsDelivered,
+        PacketDeliveryStats.GetAverageDrainTime() * 1e6, PacketDeliveryStats.NumDrains, PacketDeliveryStats.MaxDrainTime * 1e6);
+    
+    Super::Deinitialize();
+}
+
+bool UConvaiSubsystem::ProcessGameThreadTasks(float DeltaTime)
+{
+    // Connection events first so a session is attached before its first packets arrive.
+    // The core ticker runs ahead of the world's tick groups, components see this frame's events in their tick.
+    GameThreadTasks.ProcessAll();
+    DeliverDataPacketEvents();
+    EvictExpiredWarmConnections();
+    return true;
+}
+
+void UConvaiSubsystem::RegisterChatbotComponent(UConvaiChatbotComponent* ChatbotComponent)
+{
+    if (ChatbotComponent && !RegisteredChatbotComponents.Contains(ChatbotComponent))
+    {
+        RegisteredChatbotComponents.Add(ChatbotComponent);
+    }
+}
+
+void UConvaiSubsystem::UnregisterChatbotComponent(UConvaiChatbotComponent* ChatbotComponent)
+{
+    if (RegisteredChatbotComponents.Contains(ChatbotComponent))
+    {
+        ChatbotComponent->StopSession();
+        RegisteredChatbotComponents.Remove(ChatbotComponent);
+    }
+}
+
+TArray<UConvaiChatbotComponent*> UConvaiSubsystem::GetAllChatbotComponents() const
+{
+    return RegisteredChatbotComponents;
+}
+
+void UConvaiSubsystem::RegisterPlayerComponent(UConvaiPlayerComponent* PlayerComponent)
+{
+    if (PlayerComponent && !RegisteredPlayerComponents.Contains(PlayerComponent))
+    {
+        RegisteredPlayerComponents.Add(PlayerComponent);
+        CONVAI_LOG(ConvaiSubsystemLog, Verbose, TEXT("Registered player component: %s"), *PlayerComponent->GetName());
+    }
+}
+
+void UConvaiSubsystem::UnregisterPlayerComponent(UConvaiPlayerComponent* PlayerComponent)
+{
+    if (RegisteredPlayerComponents.Contains(PlayerComponent))
+    {
+        PlayerComponent->StopSession();
+        RegisteredPlayerComponents.Remove(PlayerComponent);
+        CONVAI_LOG(ConvaiSubsystemLog, Verbose, TEXT("Unregistered player component: %s"), *PlayerComponent->GetName());
+    }
+}
+
+TArray<UConvaiPlayerComponent*> UConvaiSubsystem::GetAllPlayerComponents() const
+{
+    return RegisteredPlayerComponents;
+}
+
+void UConvaiSubsystem::GetAndroidMicPermission()
+{
+	if (!UConvaiAndroid::ConvaiAndroidHasMicrophonePermission())
+		UConvaiAndroid::ConvaiAndroidAskMicrophonePermission();
+}
+
+bool UConvaiSubsystem::ConnectSession(UConvaiConnectionSessionProxy* SessionProxy, const FString& CharacterID)
+{
+    if (!IsValid(SessionProxy))
+    {
+        CONVAI_LOG(ConvaiSubsystemLog, Error, TEXT("Failed to connect session: Invalid session proxy"));
+        return false;
+    }
+    
+    // For player sessions, handle replacement properly
+    if (SessionProxy->IsPlayerSession())
+    {
+        const UConvaiConnectionSessionProxy* OldSession = nullptr;
+        
+        // Acquire lock, check and swap sessions
+        {
+            FScopeLock SessionLock(&SessionMutex);
+            
+            // If there's an existing player session, store it for notification
+            if (IsValid(CurrentPlayerSession) && CurrentPlayerSession != SessionProxy)
+            {
+                CONVAI_LOG(ConvaiSubsystemLog, Warning, TEXT("Replacing existing player session"));
+                OldSession = CurrentPlayerSession;
+            }
+            
+            // Store the new player session
+            CurrentPlayerSession = SessionProxy;
+        }
+        // Lock released here
+        
+        // Notify old session outside the lock to avoid deadlock
+        if (IsValid(OldSession))
+        {
+            if (const TScriptInterface<IConvaiConnectionInterface> Interface = OldSession->GetConnectionInterface(); Interface.GetObject())
+            {
+                Interface->OnDisconnectedFromServer();
+            }
+        }
+        
+        return true;
+    }
+    
+    if (CharacterID.IsEmpty())
+    {
+        CONVAI_LOG(ConvaiSubsystemLog, Error, TEXT("Failed to connect session: Character ID is empty"))
+        return false;
+    }
+
+    FConvaiCharacterConnectionPtr Connection;
+    {
+        FScopeLock SessionLock(&SessionMutex);
+        if (const FConvaiCharacterConnectionPtr* ExistingConnection = CharacterConnections.Find(CharacterID))
+        {
+            Connection = *ExistingConnection;
+        }
+    }
+
+    // A session switching to another character leaves its previous connection warm
+    if (const FConvaiCharacterConnectionPtr PreviousConnection = FindConnectionForSession(SessionProxy); PreviousConnection.IsValid() && PreviousConnection != Connection)
+    {
+        DisconnectSession(SessionProxy);
+    }
+
+    const FConvaiConnectionParams ConnectionParams = FConvaiConnectionParams::Create(nullptr, CharacterID, SessionProxy);
+
+    // A connection opened for different settings, e.g. prewarmed without vision, cannot serve this session
+    if (Connection.IsValid() && !Connection->GetConnectionParams().IsCompatibleWith(ConnectionParams))
+    {
+        CONVAI_LOG(ConvaiSubsystemLog, Log, TEXT("Connection to character %s was opened with different settings, reconnecting"), *CharacterID);
+        ReleaseConnection(Connection, true);
+        Connection.Reset();
+    }
+
+    if (Connection.IsValid())
+    {
+        UConvaiConnectionSessionProxy* ReplacedSession = nullptr;
+        {
+            FScopeLock SessionLock(&SessionMutex);
+            ReplacedSession = Connection->Session.Get();
+            Connection->Session = SessionProxy;
+            Connection->LastUsedTime = FPlatformTime::Seconds();
+            Connection->SessionAttachTime = Connection->LastUsedTime;
+        }
+
+        if (IsValid(ReplacedSession) && ReplacedSession != SessionProxy)
+        {
+            CONVAI_LOG(ConvaiSubsystemLog, Warning, TEXT("Replacing existing session for character %s"), *CharacterID);
+            if (const TScriptInterface<IConvaiConnectionInterface> Interface = ReplacedSession->GetConnectionInterface(); Interface.GetObject())
+            {
+                Interface->OnDisconnectedFromServer();
+            }
+        }
+
+        SetActiveConnection(Connection);
+
+        if (!Connection->IsConnected())
+        {
+            // Still connecting, OnConnectedToServer notifies the new session
+            OnServerConnectionStateChangedEvent.Broadcast(EC_ConnectionState::Connecting);
+            return true;
+        }
+
+        CONVAI_LOG(ConvaiSubsystemLog, Log, TEXT("Reusing warm connection for character %s"), *CharacterID);
+
+        // Replay the connection events the new session missed, once the caller has finished setting it up
+        TWeakObjectPtr<UConvaiSubsystem> WeakThis(this);
+        TWeakPtr<FConvaiCharacterConnection, ESPMode::ThreadSafe> WeakConnection(Connection);
+        GameThreadTasks.Enqueue([WeakThis, WeakConnection]()
+        {
+            UConvaiSubsystem* Subsystem = WeakThis.Get();
+            const FConvaiCharacterConnectionPtr ValidConnection = WeakConnection.Pin();
+            if (Subsystem && ValidConnection.IsValid() && ValidConnection->IsConnected())
+            {
+                Subsystem->NotifyConnectionEstablished(*ValidConnection, true);
+            }
+        });
+        return true;
+    }
+
+    // New character, make room under the concurrency cap first
+    EvictConnectionsOverCap(true);
+
+    if (!CreateConnection(CharacterID, ConnectionParams, SessionProxy).IsValid())
+    {
+        return false;
+    }
+
+    // Broadcast that we're starting to connect
+    OnServerConnectionStateChangedEvent.Broadcast(EC_ConnectionState::Connecting);
+
+    return true;
+}
+
+void UConvaiSubsystem::DisconnectSession(const UConvaiConnectionSessionProxy* SessionProxy)
+{
+    if (!IsValid(SessionProxy))
+    {
+        CONVAI_LOG(ConvaiSubsystemLog, Warning, TEXT("DisconnectSession: Invalid session proxy"));
+        return;
+    }
+    
+    // If this is a player session, and it's the current one, clear it
+    if (SessionProxy->IsPlayerSession())
+    {
+        FScopeLock SessionLock(&SessionMutex);
+        if (SessionProxy == CurrentPlayerSession)
+        {
+            CONVAI_LOG(ConvaiSubsystemLog, Log, TEXT("Disconnecting player session"));
+            CurrentPlayerSession = nullptr;
+        }
+        else
+        {
+            CONVAI_LOG(ConvaiSubsystemLog, Warning, TEXT("DisconnectSession: Player session is not the current active session"));
+        }
+        return;
+    }
+
+    const FConvaiCharacterConnectionPtr Connection = FindConnectionForSession(SessionProxy);
+    if (!Connection.IsValid())
+    {
+        CONVAI_LOG(ConvaiSubsystemLog, Warning, TEXT("DisconnectSession: Character session is not attached to a connection"));
+        return;
+    }
+
+    if (WarmConnectionTimeout <= 0.0f)
+    {
+        CONVAI_LOG(ConvaiSubsystemLog, Log, TEXT("Disconnecting character session for %s"), *Connection->GetCharacterID());
+        ReleaseConnection(Connection, false);
+        return;
+    }
+
+    CONVAI_LOG(ConvaiSubsystemLog, Log, TEXT("Detaching character session for %s, keeping the connection warm for %.1fs"), *Connection->GetCharacterID(), WarmConnectionTimeout);
+
+    // Detach the session, the connection stays open until it is reused, expires or is evicted
+    bool bWasActive = false;
+    {
+        FScopeLock SessionLock(&SessionMutex);
+        Connection->Session = nullptr;
+        Connection->LastUsedTime = FPlatformTime::Seconds();
+        bWasActive = ActiveConnection.HasSameObject(Connection.Get());
+        if (bWasActive)
+        {
+            ActiveConnection.Reset();
+        }
+    }
+
+    if (bWasActive)
+    {
+        UpdateReferenceAudioCapture();
+
+        // The player has no character to talk to anymore
+        OnServerConnectionStateChangedEvent.Broadcast(EC_ConnectionState::Disconnected);
+    }
+}
+
+int32 UConvaiSubsystem::SendAudio(const UConvaiConnectionSessionProxy* SessionProxy, const int16_t* AudioData, const size_t NumFrames) const
+{
+    const FConvaiCharacterConnectionPtr Connection = FindConnectionForSession(SessionProxy);
+    if (!Connection.IsValid() || !Connection->IsConnected())
+    {
+        return -1;
+    }
+
+    Connection->GetClient()->SendAudio(AudioData, NumFrames);
+    
+    return 0;
+}
+
+FConvaiCharacterConnectionPtr UConvaiSubsystem::GetSessionConnection(const UConvaiConnectionSessionProxy* SessionProxy) const
+{
+    return FindConnectionForSession(SessionProxy);
+}
+
+bool UConvaiSubsystem::SendImage(const UConvaiConnectionSessionProxy* SessionProxy, const uint32 Width, const uint32 Height,
+                                 TArray<uint8>& Data)
+{
+    const FConvaiCharacterConnectionPtr Connection = FindConnectionForSession(SessionProxy);
+    if (!Connection.IsValid() || !Connection->IsConnected())
+    {
+        return false;
+    }
+
+    // The client reads Width * Height RGBA8 pixels, and may be handed a reused buffer larger than that
+    if (Data.Num() < static_cast<int64>(Width) * Height * 4)
+    {
+        return false;
+    }
+    
+    if (!Connection->bStartedPublishingVideo)
+    {
+        // This frame only sets up the track, it is not sent
+        Connection->bStartedPublishingVideo = Connection->GetClient()->StartVideoPublishing(Width, Height);
+        return false;
+    }
+
+    Connection->GetClient()->SendImage(Width, Height, Data.GetData());
+    return true;
+}
+
+void UConvaiSubsystem::SendTextMessage(const UConvaiConnectionSessionProxy* SessionProxy,const FString& Message) const
+{
+    const FConvaiCharacterConnectionPtr Connection = FindConnectionForSession(SessionProxy);
+    if (!Connection.IsValid() || !Connection->IsConnected())
+    {
+        return;
+    }
+    
+    Connection->GetClient()->SendTextMessage(TCHAR_TO_ANSI(*Message));
+}
+
+void UConvaiSubsystem::SendTriggerMessage(const UConvaiConnectionSessionProxy* SessionProxy,const FString& Trigger_Name, const FString& Trigger_Message) const
+{
+    const FConvaiCharacterConnectionPtr Connection = FindConnectionForSession(SessionProxy);
+    if (!Connection.IsValid() || !Connection->IsConnected())
+    {
+        return;
+    }
+    
+    Connection->GetClient()->SendTriggerMessage(TCHAR_TO_ANSI(*Trigger_Name), TCHAR_TO_ANSI(*Trigger_Message));
+}
+
+void UConvaiSubsystem::UpdateTemplateKeys(const UConvaiConnectionSessionProxy* SessionProxy,TMap<FString, FString> Template_Keys) const
+{
+    const FConvaiCharacterConnectionPtr Connection = FindConnectionForSession(SessionProxy);
+    if (!Connection.IsValid() || !Connection->IsConnected())
+    {
+        return;
+    }
+    
+    TSharedRef<FJsonObject> KeysJson = MakeShared<FJsonObject>();
+    for (const TPair<FString, FString>& Kv : Template_Keys)
+    {
+        KeysJson->SetStringField(Kv.Key, Kv.Value);
+    }
+
+    FString TemplateKeysJsonStr;
+    {
+        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&TemplateKeysJsonStr);
+        FJsonSerializer::Serialize(KeysJson, Writer);
+    }
+
+    FTCHARToUTF8 TempKeyJson(*TemplateKeysJsonStr);
+    Connection->GetClient()->UpdateTemplateKeys(TempKeyJson.Get());
+}
+
+void UConvaiSubsystem::UpdateDynamicInfo(const UConvaiConnectionSessionProxy* SessionProxy,const FString& Context_Text) const
+{
+    const FConvaiCharacterConnectionPtr Connection = FindConnectionForSession(SessionProxy);
+    if (!Connection.IsValid() || !Connection->IsConnected())
+    {
+        return;
+    }
+    
+    Connection->GetClient()->UpdateDynamicInfo(TCHAR_TO_ANSI(*Context_Text));
+}
+
+void UConvaiSubsystem::OnConnectionFailed(convai::ConvaiClient* Client)
+{
+    UConvaiSubsystem* Subsystem = GetConvaiSubsystemInstance();
+    if (!IsValid(Subsystem))
+    {
+        return;
+    }
+    
+    // Ensure delegate broadcast and cleanup happen on game thread since this callback may come from WebRTC thread
+    TWeakObjectPtr<UConvaiSubsystem> WeakSubsystem(Subsystem);
+    Subsystem->GameThreadTasks.Enqueue([WeakSubsystem, Client]()
+    {
+        if (UConvaiSubsystem* ValidSubsystem = WeakSubsystem.Get())
+        {
+            // Releasing the failed connection broadcasts Disconnected when it was the active one
+            if (const FConvaiCharacterConnectionPtr Connection = ValidSubsystem->FindConnectionForClient(Client))
+            {
+                ValidSubsystem->ReleaseConnection(Connection, false);
+            }
+        }
+    });
+}
+
+FConvaiCharacterConnectionPtr UConvaiSubsystem::CreateConnection(const FString& CharacterID, const FConvaiConnectionParams& ConnectionParams, UConvaiConnectionSessionProxy* SessionProxy)
+{
+    const FConvaiCharacterConnectionPtr Connection = MakeShared<FConvaiCharacterConnection, ESPMode::ThreadSafe>(this, CharacterID, ClientPool);
+    {
+        FScopeLock SessionLock(&SessionMutex);
+        Connection->Session = SessionProxy;
+        CharacterConnections.Add(CharacterID, Connection);
+    }
+
+    // Sessions talk to the character that connected last, prewarmed connections wait until one attaches
+    if (SessionProxy)
+    {
+        SetActiveConnection(Connection);
+    }
+
+    if (!Connection->Connect(ConnectionParams))
+    {
+        CONVAI_LOG(ConvaiSubsystemLog, Error, TEXT("Failed to initialize Client client"));
+        ReleaseConnection(Connection, false);
+        return nullptr;
+    }
+
+    return Connection;
+}
+
+void UConvaiSubsystem::PrewarmClients(const int32 NumClients)
+{
+    if (ClientPool.IsValid())
+    {
+        ClientPool->Prewarm(NumClients);
+    }
+}
+
+bool UConvaiSubsystem::PrewarmCharacterConnection(const FString& CharacterID, IConvaiConnectionInterface* Interface)
+{
+    if (CharacterID.IsEmpty())
+    {
+        CONVAI_LOG(ConvaiSubsystemLog, Warning, TEXT("PrewarmCharacterConnection: Character ID is empty"));
+        return false;
+    }
+
+    if (WarmConnectionTimeout <= 0.0f)
+    {
+        CONVAI_LOG(ConvaiSubsystemLog, Warning, TEXT("PrewarmCharacterConnection: Warm connections are disabled (WarmConnectionTimeout is 0)"));
+        return false;
+    }
+
+    {
+        FScopeLock SessionLock(&SessionMutex);
+        if (const FConvaiCharacterConnectionPtr* ExistingConnection = CharacterConnections.Find(CharacterID))
+        {
+            // Already open, keep it warm a while longer
+            (*ExistingConnection)->LastUsedTime = FPlatformTime::Seconds();
+            return true;
+        }
+    }
+
+    // Prewarming must never cost a conversation in progress
+    if (!EvictConnectionsOverCap(false))
+    {
+        CONVAI_LOG(ConvaiSubsystemLog, Log, TEXT("PrewarmCharacterConnection: All %d connections are in use, not prewarming %s"), MaxCharacterConnections, *CharacterID);
+        return false;
+    }
+
+    CONVAI_LOG(ConvaiSubsystemLog, Log, TEXT("Prewarming connection to character %s"), *CharacterID);
+    return CreateConnection(CharacterID, FConvaiConnectionParams::Create(nullptr, CharacterID, Interface), nullptr).IsValid();
+}
+
+float UConvaiSubsystem::GetLastTimeToConnected() const
+{
+    return static_cast<float>(ConnectionMetrics.LastTimeToConnected);
+}
+
+float UConvaiSubsystem::GetAverageTimeToConnected() const
+{
+    return static_cast<float>(ConnectionMetrics.GetAverageTimeToConnected());
+}
+
+FConvaiClientPool::FStats UConvaiSubsystem::GetClientPoolStats() const
+{
+    return ClientPool.IsValid() ? ClientPool->GetStats() : FConvaiClientPool::FStats();
+}
+
+int32 UConvaiSubsystem::GetNumCharacterConnections() const
+{
+    FScopeLock SessionLock(&SessionMutex);
+    return CharacterConnections.Num();
+}
+
+bool UConvaiSubsystem::HasCharacterConnection(const FString& CharacterID) const
+{
+    FScopeLock SessionLock(&SessionMutex);
+    return CharacterConnections.Contains(CharacterID);
+}
+
+FConvaiCharacterConnectionPtr UConvaiSubsystem::FindConnectionForSession(const UConvaiConnectionSessionProxy* SessionProxy) const
+{
+    if (!IsValid(SessionProxy))
+    {
+        return nullptr;
+    }
+
+    FScopeLock SessionLock(&SessionMutex);
+
+    // The player talks to whichever character connected last
+    if (SessionProxy->IsPlayerSession())
+    {
+        return ActiveConnection.Pin();
+    }
+
+    for (const TPair<FString, FConvaiCharacterConnectionPtr>& Pair : CharacterConnections)
+    {
+        if (Pair.Value->Session.Get() == SessionProxy)
+        {
+            return Pair.Value;
+        }
+    }
+    return nullptr;
+}
+
+FConvaiCharacterConnectionPtr UConvaiSubsystem::FindConnectionForClient(const convai::ConvaiClient* Client) const
+{
+    FScopeLock SessionLock(&SessionMutex);
+    for (const TPair<FString, FConvaiCharacterConnectionPtr>& Pair : CharacterConnections)
+    {
+        if (Pair.Value->GetClient() == Client)
+        {
+            return Pair.Value;
+        }
+    }
+    return nullptr;
+}
+
+void UConvaiSubsystem::SetActiveConnection(const FConvaiCharacterConnectionPtr& Connection)
+{
+    {
+        FScopeLock SessionLock(&SessionMutex);
+        ActiveConnection = Connection;
+    }
+    UpdateReferenceAudioCapture();
+}
+
+bool UConvaiSubsystem::IsActiveConnection(const FConvaiCharacterConnection& Connection) const
+{
+    FScopeLock SessionLock(&SessionMutex);
+    return ActiveConnection.HasSameObject(&Connection);
+}
+
+bool UConvaiSubsystem::EvictConnectionsOverCap(const bool bEvictAttached)
+{
+    for (;;)
+    {
+        FConvaiCharacterConnectionPtr Victim;
+        {
+            FScopeLock SessionLock(&SessionMutex);
+            if (CharacterConnections.Num() < MaxCharacterConnections)
+            {
+                return true;
+            }
+
+            // Prefer the least recently used warm connection, then the least recently used attached one
+            for (const TPair<FString, FConvaiCharacterConnectionPtr>& Pair : CharacterConnections)
+            {
+                const FConvaiCharacterConnectionPtr& Candidate = Pair.Value;
+                if (!bEvictAttached && Candidate->Session.IsValid())
+                {
+                    continue;
+                }
+                if (!Victim.IsValid())
+                {
+                    Victim = Candidate;
+                    continue;
+                }
+
+                const bool bCandidateWarm = !Candidate->Session.IsValid();
+                const bool bVictimWarm = !Victim->Session.IsValid();
+                if (bCandidateWarm != bVictimWarm ? bCandidateWarm : Candidate->LastUsedTime < Victim->LastUsedTime)
+                {
+                    Victim = Candidate;
+                }
+            }
+        }
+
+        if (!Victim.IsValid())
+        {
+            return false;
+        }
+
+        CONVAI_LOG(ConvaiSubsystemLog, Log, TEXT("Closing connection to character %s, %d connections is the limit"), *Victim->GetCharacterID(), MaxCharacterConnections);
+        ReleaseConnection(Victim, true);
+    }
+}
+
+void UConvaiSubsystem::EvictExpiredWarmConnections()
+{
+    if (WarmConnectionTimeout <= 0.0f)
+    {
+        return;
+    }
+
+    const double Now = FPlatformTime::Seconds();
+    TArray<FConvaiCharacterConnectionPtr> ExpiredConnections;
+    {
+        FScopeLock SessionLock(&SessionMutex);
+        for (const TPair<FString, FConvaiCharacterConnectionPtr>& Pair : CharacterConnections)
+        {
+            // A session that was garbage collected without disconnecting also leaves its connection warm
+            if (!Pair.Value->Session.IsValid() && Now - Pair.Value->LastUsedTime >= WarmConnectionTimeout)
+            {
+                ExpiredConnections.Add(Pair.Value);
+            }
+        }
+    }
+
+    for (const FConvaiCharacterConnectionPtr& Connection : ExpiredConnections)
+    {
+        CONVAI_LOG(ConvaiSubsystemLog, Log, TEXT("Closing warm connection to character %s"), *Connection->GetCharacterID());
+        ReleaseConnection(Connection, false);
+    }
+}
+
+void UConvaiSubsystem::ReleaseConnection(const FConvaiCharacterConnectionPtr& Connection, const bool bNotifySession)
+{
+    if (!Connection.IsValid())
+    {
+        return;
+    }
+
+    UConvaiConnectionSessionProxy* Session = nullptr;
+    UConvaiConnectionSessionProxy* PlayerSession = nullptr;
+    bool bWasActive = false;
+    {
+        FScopeLock SessionLock(&SessionMutex);
+        if (const FConvaiCharacterConnectionPtr* Found = CharacterConnections.Find(Connection->GetCharacterID()); Found && *Found == Connection)
+        {
+            CharacterConnections.Remove(Connection->GetCharacterID());
+        }
+
+        Session = Connection->Session.Get();
+        Connection->Session = nullptr;
+
+        bWasActive = ActiveConnection.HasSameObject(Connection.Get());
+        if (bWasActive)
+        {
+            ActiveConnection.Reset();
+            PlayerSession = CurrentPlayerSession;
+        }
     }
-    
-    TSharedRef<FJsonObject> KeysJson = MakeShared<FJsonObject>();
-    for (const TPair<FString, FString>& Kv : Template_Keys)
+
+    Connection->Shutdown();
+
+    if (bWasActive)
     {
-        KeysJson->SetStringField(Kv.Key, Kv.Value);
+        // Broadcast connection state change to subsystem level
+        OnServerConnectionStateChangedEvent.Broadcast(EC_ConnectionState::Disconnected);
     }
 
-    FString TemplateKeysJsonStr;
+    if (bNotifySession && IsValid(Session))
     {
-        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&TemplateKeysJsonStr);
-        FJsonSerializer::Serialize(KeysJson, Writer);
+        if (const TScriptInterface<IConvaiConnectionInterface> Interface = Session->GetConnectionInterface(); Interface.GetObject())
+        {
+            Interface->OnDisconnectedFromServer();
+        }
     }
 
-    FTCHARToUTF8 TempKeyJson(*TemplateKeysJsonStr);
-    ConvaiClient->UpdateTemplateKeys(TempKeyJson.Get());
+    if (bNotifySession && IsValid(PlayerSession))
+    {
+        if (const TScriptInterface<IConvaiConnectionInterface> Interface = PlayerSession->GetConnectionInterface(); Interface.GetObject())
+        {
+            Interface->OnDisconnectedFromServer();
+        }
+    }
 }
 
-void UConvaiSubsystem::UpdateDynamicInfo(const UConvaiConnectionSessionProxy* SessionProxy,const FString& Context_Text) const
+void UConvaiSubsystem::ReleaseAllConnections()
 {
-    if (!IsValid(SessionProxy) || !ConvaiClient || !bIsConnected)
+    TArray<FConvaiCharacterConnectionPtr> Connections;
     {
-        return;
+        FScopeLock SessionLock(&SessionMutex);
+        CharacterConnections.GenerateValueArray(Connections);
+    }
+
+    for (const FConvaiCharacterConnectionPtr& Connection : Connections)
+    {
+        ReleaseConnection(Connection, false);
     }
-    
-    ConvaiClient->UpdateDynamicInfo(TCHAR_TO_ANSI(*Context_Text));
 }
 
-void UConvaiSubsystem::OnConnectionFailed()
+void UConvaiSubsystem::UpdateReferenceAudioCapture()
 {
-    UConvaiSubsystem* Subsystem = GetConvaiSubsystemInstance();
-    if (!IsValid(Subsystem))
+    TArray<FConvaiCharacterConnectionPtr> Connections;
+    FConvaiCharacterConnectionPtr Active;
     {
-        return;
+        FScopeLock SessionLock(&SessionMutex);
+        CharacterConnections.GenerateValueArray(Connections);
+        Active = ActiveConnection.Pin();
     }
-    
-    // Ensure delegate broadcast and cleanup happen on game thread since this callback may come from WebRTC thread
-    TWeakObjectPtr<UConvaiSubsystem> WeakSubsystem(Subsystem);
-    AsyncTask(ENamedThreads::GameThread, [WeakSubsystem]()
+
+    const bool bAECEnabled = UConvaiUtils::IsAECEnabled();
+    for (const FConvaiCharacterConnectionPtr& Connection : Connections)
     {
-        if (UConvaiSubsystem* ValidSubsystem = WeakSubsystem.Get())
+        // Only the connection that receives the microphone needs the echo reference
+        const bool bWantsCapture = bAECEnabled && Connection == Active && Connection->IsConnected();
+        if (bWantsCapture)
         {
-            // Broadcast that connection failed (treat as disconnected)
-            ValidSubsystem->OnServerConnectionStateChangedEvent.Broadcast(EC_ConnectionState::Disconnected);
-            
-            // Cleanup on game thread to avoid race conditions
-            ValidSubsystem->CleanupConvaiClient();
+            // Submix listeners are registered from the game thread
+            UWorld* World = GetWorld();
+            if (!World)
+            {
+                CONVAI_LOG(ConvaiSubsystemLog, Warning, TEXT("Could not get World for reference audio capture"));
+                continue;
+            }
+
+            if (!Connection->ReferenceAudioCapture.IsValid())
+            {
+                Connection->ReferenceAudioCapture = MakeShared<FConvaiReferenceAudioCapture, ESPMode::ThreadSafe>(Connection->GetClient(), World);
+            }
+            if (!Connection->ReferenceAudioCapture->IsCapturing())
+            {
+                Connection->ReferenceAudioCapture->StartCapture();
+                CONVAI_LOG(ConvaiSubsystemLog, Log, TEXT("Started reference audio capture for character %s"), *Connection->GetCharacterID());
+            }
         }
-    });
+        else if (Connection->ReferenceAudioCapture.IsValid() && Connection->ReferenceAudioCapture->IsCapturing())
+        {
+            Connection->ReferenceAudioCapture->StopCapture();
+            CONVAI_LOG(ConvaiSubsystemLog, Log, TEXT("Stopped reference audio capture for character %s"), *Connection->GetCharacterID());
+        }
+    }
 }
 
-bool UConvaiSubsystem::InitializeConvaiClient()
+void UConvaiSubsystem::NotifyConnectionEstablished(const FConvaiCharacterConnection& Connection, const bool bReplayAttendees)
 {
-    FScopeLock ClientLock(&ConvaiClientMutex);
-    
-    ConvaiClient = MakeUnique<convai::ConvaiClient>();
-    
-    if (ConvaiClient)
+    UpdateReferenceAudioCapture();
+
+    TArray<FString> AttendeeIDs;
+    if (bReplayAttendees)
     {
-        // Setup callbacks
-        SetupClientCallbacks();        
-        return true;
+        FScopeLock SessionLock(&SessionMutex);
+        AttendeeIDs = Connection.AttendeeIDs;
     }
-    
-    return false;
-}
 
-void UConvaiSubsystem::CleanupConvaiClient()
-{
-    if (ConnectionThread.IsValid())
+    if (IsActiveConnection(Connection))
     {
-        ConnectionThread->Stop();
-        ConnectionThread.Reset();
+        // Broadcast connection state change to subsystem level
+        OnServerConnectionStateChangedEvent.Broadcast(EC_ConnectionState::Connected);
     }
-    
-    // Stop and cleanup reference audio thread
-    if (ReferenceAudioThread.IsValid())
+
+    if (const TScriptInterface<IConvaiConnectionInterface> Interface = GetCharacterInterface(Connection); Interface.GetObject())
     {
-        ReferenceAudioThread->StopCapture();
-        ReferenceAudioThread.Reset();
-        CONVAI_LOG(ConvaiSubsystemLog, Log, TEXT("Stopped and cleaned up reference audio capture thread"));
+        // How long the session waited, from the moment it attached to the connection
+        const double TimeToConnected = FPlatformTime::Seconds() - Connection.SessionAttachTime;
+        ++ConnectionMetrics.NumConnections;
+        ConnectionMetrics.NumWarmReuses += bReplayAttendees ? 1 : 0;
+        ConnectionMetrics.NumPooledClients += (!bReplayAttendees && Connection.bUsedPooledClient) ? 1 : 0;
+        ConnectionMetrics.LastTimeToConnected = TimeToConnected;
+        ConnectionMetrics.MaxTimeToConnected = FMath::Max(ConnectionMetrics.MaxTimeToConnected, TimeToConnected);
+        ConnectionMetrics.TotalTimeToConnected += TimeToConnected;
+
+        Interface->OnConnectedToServer();
+        for (const FString& Attendee : AttendeeIDs)
+        {
+            Interface->OnAttendeeConnected(Attendee);
+        }
     }
-    
-    // Cleanup ConvaiClient with mutex protection
+
+    if (const TScriptInterface<IConvaiConnectionInterface> Interface = GetPlayerInterface(Connection); Interface.GetObject())
     {
-        FScopeLock ClientLock(&ConvaiClientMutex);
-        if (ConvaiClient)
+        Interface->OnConnectedToServer();
+        for (const FString& Attendee : AttendeeIDs)
         {
-            ConvaiClient->Disconnect();
-            ConvaiClient->SetConvaiClientListner(nullptr);
-            ConvaiClient.Reset();  // Smart pointer cleanup
+            Interface->OnAttendeeConnected(Attendee);
         }
     }
-    
-    // Clear the current character session
+}
+
+TScriptInterface<IConvaiConnectionInterface> UConvaiSubsystem::GetCharacterInterface(const FConvaiCharacterConnection& Connection) const
+{
+    UConvaiConnectionSessionProxy* Session;
     {
         FScopeLock SessionLock(&SessionMutex);
-        CurrentCharacterSession = nullptr;
+        Session = Connection.Session.Get();
     }
-    
-    bIsConnected = false;
-    bStartedPublishingVideo = false;
+    return IsValid(Session) ? Session->GetConnectionInterface() : TScriptInterface<IConvaiConnectionInterface>();
 }
 
-void UConvaiSubsystem::SetupClientCallbacks()
+TScriptInterface<IConvaiConnectionInterface> UConvaiSubsystem::GetPlayerInterface(const FConvaiCharacterConnection& Connection) const
 {
-    if (!ConvaiClient)
+    UConvaiConnectionSessionProxy* Session = nullptr;
     {
-        return;
+        // Only the active connection's events concern the player
+        FScopeLock SessionLock(&SessionMutex);
+        if (ActiveConnection.HasSameObject(&Connection))
+        {
+            Session = CurrentPlayerSession;
+        }
     }
-    ConvaiClient->SetConvaiClientListner(this);
+    return IsValid(Session) ? Session->GetConnectionInterface() : TScriptInterface<IConvaiConnectionInterface>();
 }
 
-void UConvaiSubsystem::OnConnectedToServer()
+void UConvaiSubsystem::OnConnectedToServer(FConvaiCharacterConnection& Connection)
 {
-    CONVAI_LOG(ConvaiSubsystemLog, Log, TEXT("OnConnectedToServer called"));
+    CONVAI_LOG(ConvaiSubsystemLog, Log, TEXT("OnConnectedToServer called for character %s"), *Connection.GetCharacterID());
 
-    if (!ConvaiClient)
+    convai::ConvaiClient* Client = Connection.GetClient();
+    if (!Client)
     {
         CONVAI_LOG(ConvaiSubsystemLog, Warning, TEXT("OnConnectedToServer: ConvaiClient is null"));
         return;
     }
-
-    if (!IsValid(CurrentCharacterSession))
-    {
-        CONVAI_LOG(ConvaiSubsystemLog, Error, TEXT("OnConnectedToServer: CurrentCharacterSession is invalid"));
-        CleanupConvaiClient();
-        return;
-    }
-    
-    bIsConnected = true;
-    ConvaiClient->StartAudioPublishing();
     
-    // Start reference audio capture for echo cancellation
-    if (!ReferenceAudioThread.IsValid() && UConvaiUtils::IsAECEnabled())
-    {
-        if (UWorld* World = GetWorld())
-        {
-            ReferenceAudioThread = MakeShared<FConvaiReferenceAudioThread>(ConvaiClient.Get(), World);
-            ReferenceAudioThread->StartCapture();
-            CONVAI_LOG(ConvaiSubsystemLog, Log, TEXT("Started reference audio capture thread"));
-        }
-        else
-        {
-            CONVAI_LOG(ConvaiSubsystemLog, Warning, TEXT("Could not get World for reference audio capture"));
-        }
-    }
+    CONVAI_LOG(ConvaiSubsystemLog, Log, TEXT("Connected to character %s in %.0f ms (%s client)"), *Connection.GetCharacterID(),
+        (FPlatformTime::Seconds() - Connection.ConnectStartTime) * 1000.0, Connection.bUsedPooledClient ? TEXT("pooled") : TEXT("new"));
+
+    Connection.bCanRecycleClient = true;
+    Connection.bIsConnected = true;
+    Client->StartAudioPublishing();
     
     // Ensure delegate broadcast happens on game thread since this callback comes from WebRTC thread
     TWeakObjectPtr<UConvaiSubsystem> WeakThis(this);
-    AsyncTask(ENamedThreads::GameThread, [WeakThis]()
+    TWeakPtr<FConvaiCharacterConnection, ESPMode::ThreadSafe> WeakConnection(Connection.AsShared());
+    GameThreadTasks.Enqueue([WeakThis, WeakConnection]()
     {
-        if (UConvaiSubsystem* Subsystem = WeakThis.Get())
+        UConvaiSubsystem* Subsystem = WeakThis.Get();
+        const FConvaiCharacterConnectionPtr ValidConnection = WeakConnection.Pin();
+
+        // A connection detached while connecting simply stays warm
+        if (Subsystem && ValidConnection.IsValid() && ValidConnection->IsConnected())
         {
-            // Broadcast connection state change to subsystem level
-            Subsystem->OnServerConnectionStateChangedEvent.Broadcast(EC_ConnectionState::Connected);
-            
-            if (IsValid(Subsystem->CurrentCharacterSession))
-            {
-                if (const TScriptInterface<IConvaiConnectionInterface> Interface = Subsystem->CurrentCharacterSession->GetConnectionInterface(); Interface.GetObject())
-                {
-                    Interface->OnConnectedToServer();
-                }
-            }
-            
-            if (IsValid(Subsystem->CurrentPlayerSession))
-            {
-                if (const TScriptInterface<IConvaiConnectionInterface> Interface = Subsystem->CurrentPlayerSession->GetConnectionInterface(); Interface.GetObject())
-                {
-                    Interface->OnConnectedToServer();
-                }
-            }
+            Subsystem->NotifyConnectionEstablished(*ValidConnection, false);
         }
     });
 }
 
-void UConvaiSubsystem::OnDisconnectedFromServer()
+void UConvaiSubsystem::OnDisconnectedFromServer(FConvaiCharacterConnection& Connection)
 {
-    CONVAI_LOG(ConvaiSubsystemLog, Error, TEXT("Disconnected from Server"));
-    bIsConnected = false;
+    CONVAI_LOG(ConvaiSubsystemLog, Error, TEXT("Disconnected from Server (character %s)"), *Connection.GetCharacterID());
+    Connection.bIsConnected = false;
     
     // Ensure delegate broadcast and cleanup happen on game thread since this callback comes from WebRTC thread
     TWeakObjectPtr<UConvaiSubsystem> WeakThis(this);
-    AsyncTask(ENamedThreads::GameThread, [WeakThis]()
+    TWeakPtr<FConvaiCharacterConnection, ESPMode::ThreadSafe> WeakConnection(Connection.AsShared());
+    GameThreadTasks.Enqueue([WeakThis, WeakConnection]()
     {
-        if (UConvaiSubsystem* Subsystem = WeakThis.Get())
+        UConvaiSubsystem* Subsystem = WeakThis.Get();
+        if (const FConvaiCharacterConnectionPtr ValidConnection = WeakConnection.Pin(); Subsystem && ValidConnection.IsValid())
         {
-            // Stop reference audio capture when disconnected (must be on game thread)
-            if (Subsystem->ReferenceAudioThread.IsValid())
-            {
-                Subsystem->ReferenceAudioThread->StopCapture();
-                CONVAI_LOG(ConvaiSubsystemLog, Log, TEXT("Stopped reference audio capture on disconnect"));
-            }
-            
-            // Broadcast connection state change to subsystem level
-            Subsystem->OnServerConnectionStateChangedEvent.Broadcast(EC_ConnectionState::Disconnected);
-            
-            if (IsValid(Subsystem->CurrentCharacterSession))
-            {
-                if (const TScriptInterface<IConvaiConnectionInterface> Interface = Subsystem->CurrentCharacterSession->GetConnectionInterface(); Interface.GetObject())
-                {
-                    Interface->OnDisconnectedFromServer();
-                }
-            }
-
-            if (IsValid(Subsystem->CurrentPlayerSession))
-            {
-                if (const TScriptInterface<IConvaiConnectionInterface> Interface = Subsystem->CurrentPlayerSession->GetConnectionInterface(); Interface.GetObject())
-                {
-                    Interface->OnDisconnectedFromServer();
-                }
-            }
-            
-            // Cleanup on game thread to avoid race conditions with callbacks
-            Subsystem->CleanupConvaiClient();
+            // Notifies the character session, and the player session when this was the active connection
+            Subsystem->ReleaseConnection(ValidConnection, true);
         }
     });
 }
 
-void UConvaiSubsystem::OnAudioData(const char* attendee_id, const int16_t* audio_data, size_t num_frames,
-                                   uint32_t sample_rate, uint32_t bits_per_sample, uint32_t num_channels)
+void UConvaiSubsystem::OnAudioData(const FConvaiCharacterConnection& Connection, const char* attendee_id, const int16_t* audio_data, size_t num_frames,
+                                   uint32_t sample_rate, uint32_t bits_per_sample, uint32_t num_channels) const
 {
-    if (!IsValid(CurrentCharacterSession))
-    {
-        return;
-    }
-    
-    // Forward to the current character session
-    if (const TScriptInterface<IConvaiConnectionInterface> Interface = CurrentCharacterSession->GetConnectionInterface(); Interface.GetObject())
+    // Every character has its own connection, so the connection identifies the session the audio belongs to
+    if (const TScriptInterface<IConvaiConnectionInterface> Interface = GetCharacterInterface(Connection); Interface.GetObject())
     {
         Interface->OnAudioDataReceived(audio_data, num_frames, sample_rate, bits_per_sample, num_channels);
     }
 }
 
-void UConvaiSubsystem::OnAttendeeConnected(const char* attendee_id)
+void UConvaiSubsystem::OnAttendeeConnected(FConvaiCharacterConnection& Connection, const char* attendee_id)
 {
-    const FString Attendee  = UTF8_TO_TCHAR(attendee_id);
-    CONVAI_LOG(ConvaiSubsystemLog, Log, TEXT("🔌 Attendee connected: %s"), *Attendee);
+    const FString Attendee  = UTF8_TO_TCHAR(attendee_id ? attendee_id : "");
+    CONVAI_LOG(ConvaiSubsystemLog, Log, TEXT("🔌 Attendee connected: %s (character %s)"), *Attendee, *Connection.GetCharacterID());
+
+    // Remembered so a session reusing this warm connection can be told who is in the room
+    {
+        FScopeLock SessionLock(&SessionMutex);
+        Connection.AttendeeIDs.AddUnique(Attendee);
+    }
 
     // Forward to character session
-    if (IsValid(CurrentCharacterSession))
+    if (const TScriptInterface<IConvaiConnectionInterface> Interface = GetCharacterInterface(Connection); Interface.GetObject())
     {
-        if (const TScriptInterface<IConvaiConnectionInterface> Interface = CurrentCharacterSession->GetConnectionInterface(); Interface.GetObject())
-        {
-            Interface->OnAttendeeConnected(Attendee);
-        }
+        Interface->OnAttendeeConnected(Attendee);
     }
 
     // Forward to player session (if any)
-    if (IsValid(CurrentPlayerSession))
+    if (const TScriptInterface<IConvaiConnectionInterface> Interface = GetPlayerInterface(Connection); Interface.GetObject())
     {
-        if (const TScriptInterface<IConvaiConnectionInterface> Interface = CurrentPlayerSession->GetConnectionInterface(); Interface.GetObject())
-        {
-            Interface->OnAttendeeConnected(Attendee);
-        }
+        Interface->OnAttendeeConnected(Attendee);
     }
 }
 
-void UConvaiSubsystem::OnAttendeeDisconnected(const char* attendee_id)
+void UConvaiSubsystem::OnAttendeeDisconnected(FConvaiCharacterConnection& Connection, const char* attendee_id)
 {
     const FString Attendee = UTF8_TO_TCHAR(attendee_id ? attendee_id : "");
-    CONVAI_LOG(ConvaiSubsystemLog, Log, TEXT("🔌 Attendee disconnected: %s"), *Attendee);
+    CONVAI_LOG(ConvaiSubsystemLog, Log, TEXT("🔌 Attendee disconnected: %s (character %s)"), *Attendee, *Connection.GetCharacterID());
+
+    {
+        FScopeLock SessionLock(&SessionMutex);
+        Connection.AttendeeIDs.Remove(Attendee);
+    }
 
     // Forward to character session
-    if (IsValid(CurrentCharacterSession))
+    if (const TScriptInterface<IConvaiConnectionInterface> Interface = GetCharacterInterface(Connection); Interface.GetObject())
     {
-        if (const TScriptInterface<IConvaiConnectionInterface> Interface = CurrentCharacterSession->GetConnectionInterface(); Interface.GetObject())
-        {
-            Interface->OnAttendeeDisconnected(Attendee);
-        }
+        Interface->OnAttendeeDisconnected(Attendee);
     }
 
     // Forward to player session (if any)
-    if (IsValid(CurrentPlayerSession))
+    if (const TScriptInterface<IConvaiConnectionInterface> Interface = GetPlayerInterface(Connection); Interface.GetObject())
     {
-        if (const TScriptInterface<IConvaiConnectionInterface> Interface = CurrentPlayerSession->GetConnectionInterface(); Interface.GetObject())
-        {
-            Interface->OnAttendeeDisconnected(Attendee);
-        }
+        Interface->OnAttendeeDisconnected(Attendee);
     }
 }
 
-void UConvaiSubsystem::OnActiveSpeakerChanged(const char* Speaker)
+void UConvaiSubsystem::OnDataPacketReceived(FConvaiCharacterConnection& Connection, const char* JsonData, const char* attendee_id) const
 {
-    const FString SpeakerStr  = UTF8_TO_TCHAR(Speaker);
-    CONVAI_LOG(ConvaiSubsystemLog, Log, TEXT("🎤 Active speaker changed: %s"), *SpeakerStr);
+    if (!JsonData)
+    {
+        return;
+    }
+
+    // Visemes alone arrive ~100 times a second per character, only pay for the payload log when it is enabled
+    if (UE_LOG_ACTIVE(ConvaiSubsystemLog, VeryVerbose))
+    {
+        CONVAI_LOG(ConvaiSubsystemLog, VeryVerbose, TEXT("Data packet received from %s: %s"), UTF8_TO_TCHAR(attendee_id ? attendee_id : ""), UTF8_TO_TCHAR(JsonData));
+    }
+
+    // The bot speaking state gates the audio callbacks on this thread, so it can't wait for the next frame
+    const int32 Length = FCStringAnsi::Strlen(JsonData);
+    bool bSpeakingStateDelivered = false;
+    switch (FConvaiDataPacketParser::PeekType(JsonData, Length))
+    {
+        case EConvaiDataPacketType::BotStartedSpeaking:
+            OnBotStartedSpeaking(Connection, attendee_id);
+            bSpeakingStateDelivered = true;
+            break;
+
+        case EConvaiDataPacketType::BotStoppedSpeaking:
+            OnBotStoppedSpeaking(Connection, attendee_id);
+            bSpeakingStateDelivered = true;
+            break;
+
+        default:
+            break;
+    }
+
+    // Everything else is decoded on a worker and delivered by DeliverDataPacketEvents
+    Connection.QueueDataPacket(JsonData, Length, bSpeakingStateDelivered);
 }
 
-void UConvaiSubsystem::OnDataPacketReceived(const char* JsonData, const char* attendee_id)
+void UConvaiSubsystem::DeliverDataPacketEvents()
 {
-    const FString JsonStr      = UTF8_TO_TCHAR(JsonData);
-    const FString Attendee  = UTF8_TO_TCHAR(attendee_id);
-    
-    CONVAI_LOG(ConvaiSubsystemLog, Log, TEXT("Attendee ID: %s, Data: %s"), *Attendee, *JsonStr);
-    
-    const TSharedPtr<FJsonObject> Root = ParseJsonObject(JsonStr);
-    if (!Root.IsValid())
+    const double DeliveryStart = FPlatformTime::Seconds();
+    int32 NumDelivered = 0;
+
     {
-        CONVAI_LOG(ConvaiSubsystemLog, Warning, TEXT("OnDataPacketReceived: Failed to parse Root JSON."));
-        return;
+        FScopeLock SessionLock(&SessionMutex);
+        CharacterConnections.GenerateValueArray(DeliveryConnections);
     }
 
-    FString DataPacketTypeStr;
-    if (!Root->TryGetStringField(TEXT("type"), DataPacketTypeStr))
+    for (const FConvaiCharacterConnectionPtr& Connection : DeliveryConnections)
     {
-        CONVAI_LOG(ConvaiSubsystemLog, Warning, TEXT("OnDataPacketReceived: type filed missing in root json"));
-        return;
+        PacketDeliveryStats.NumPacketsReceived += Connection->NumPacketsReceived.exchange(0, std::memory_order_relaxed);
+        PacketDeliveryStats.NumDecodeTasks += Connection->NumDecodeTasks.exchange(0, std::memory_order_relaxed);
+        PacketDeliveryStats.NumVisemePacketsCoalesced += Connection->NumVisemePacketsCoalesced.exchange(0, std::memory_order_relaxed);
+
+        Connection->TakeDecodedEvents(DeliveryEvents);
+        for (FConvaiDataPacketEvent& Event : DeliveryEvents)
+        {
+            DispatchDataPacketEvent(*Connection, Event);
+        }
+        NumDelivered += DeliveryEvents.Num();
+        DeliveryEvents.Reset();
+    }
+    DeliveryConnections.Reset();
+
+    if (NumDelivered > 0)
+    {
+        const double DeliveryTime = FPlatformTime::Seconds() - DeliveryStart;
+        PacketDeliveryStats.NumEventsDelivered += NumDelivered;
+        ++PacketDeliveryStats.NumDrains;
+        PacketDeliveryStats.LastDrainTime = DeliveryTime;
+        PacketDeliveryStats.MaxDrainTime = FMath::Max(PacketDeliveryStats.MaxDrainTime, DeliveryTime);
+        PacketDeliveryStats.TotalDrainTime += DeliveryTime;
     }
+}
 
-    const EC_PacketType DataPacketType = ToPacketType(DataPacketTypeStr);
-    const TSharedPtr<FJsonObject> DataObj = GetDataObject(Root);
+void UConvaiSubsystem::DispatchDataPacketEvent(FConvaiCharacterConnection& Connection, FConvaiDataPacketEvent& Event) const
+{
+    FConvaiDataPacket& Packet = Event.Packet;
 
-    switch (DataPacketType)
+    // The attendee is not carried through the decode stage, none of the handlers use it
+    switch (Packet.Type)
     {
-        case EC_PacketType::UserStartedSpeaking:
-            {
-                OnUserStartedSpeaking(TCHAR_TO_ANSI(*Attendee));
-            }
+        case EConvaiDataPacketType::UserStartedSpeaking:
+            OnUserStartedSpeaking(Connection, nullptr);
             break;
 
-        case EC_PacketType::UserStoppedSpeaking:
-            {
-                OnUserStoppedSpeaking(TCHAR_TO_ANSI(*Attendee));
-            }
+        case EConvaiDataPacketType::UserStoppedSpeaking:
+            OnUserStoppedSpeaking(Connection, nullptr);
             break;
 
-        case EC_PacketType::UserTranscription:
-        {
-            if (DataObj.IsValid())
-            {
-                FString Text, Timestamp;
-                bool bFinal = false;
-
-                GetStringSafe(DataObj, TEXT("text"),      Text);
-                GetStringSafe(DataObj, TEXT("timestamp"), Timestamp);
-                GetBoolSafe  (DataObj, TEXT("final"),     bFinal);
-
-                OnUserTranscript(
-                    TCHAR_TO_ANSI(*Text),
-                    TCHAR_TO_ANSI(*Attendee),
-                    bFinal,
-                    TCHAR_TO_ANSI(*Timestamp)
-                );
-            }
-        }
+        case EConvaiDataPacketType::UserTranscription:
+            OnUserTranscript(Connection, Packet.Text, nullptr, Packet.bFinal, Packet.Timestamp);
             break;
 
-        case EC_PacketType::BotLLMStarted:
+        case EConvaiDataPacketType::BotLLMStarted:
             //CONVAI_LOG(ConvaiSubsystemLog, Log, TEXT("OnDataPacketReceived: BotLLMStarted "));
             break;
 
-        case EC_PacketType::BotLLMStopped:
+        case EConvaiDataPacketType::BotLLMStopped:
+            OnBotLLMStopped(Connection, nullptr);
+            break;
+
+        case EConvaiDataPacketType::BotStartedSpeaking:
+            if (!Event.bSpeakingStateDelivered)
             {
-                OnBotLLMStopped(TCHAR_TO_ANSI(*Attendee));
+                OnBotStartedSpeaking(Connection, nullptr);
             }
             break;
 
-        case EC_PacketType::BotStartedSpeaking:
+        case EConvaiDataPacketType::BotStoppedSpeaking:
+            if (!Event.bSpeakingStateDelivered)
             {
-                OnBotStartedSpeaking(TCHAR_TO_ANSI(*Attendee));
+                OnBotStoppedSpeaking(Connection, nullptr);
             }
+            // Closes the bot transcript, in order with the transcription packets before it
+            OnBotLLMStopped(Connection, nullptr);
             break;
 
-        case EC_PacketType::BotStoppedSpeaking:
+        case EConvaiDataPacketType::BotTranscription:
+            if (!Packet.Text.IsEmpty())
             {
-                OnBotStoppedSpeaking(TCHAR_TO_ANSI(*Attendee));
+                OnBotTranscript(Connection, Packet.Text, nullptr);
             }
             break;
 
-        case EC_PacketType::BotTranscription:
-        {
-            if (DataObj.IsValid())
+        case EConvaiDataPacketType::ServerMessage:
+            switch (Packet.ServerType)
             {
-                FString Text;
-                if (GetStringSafe(DataObj, TEXT("text"), Text) && !Text.IsEmpty())
+            case EConvaiServerPacketType::BotEmotion:
                 {
-                    OnBotTranscript(TCHAR_TO_ANSI(*Text), TCHAR_TO_ANSI(*Attendee));
+                    const FString EmotionResponse = FString::Printf(TEXT("%s %d"), *Packet.Emotion, Packet.EmotionScale);
+                    OnEmotionReceived(Connection, EmotionResponse, FAnimationFrame(), false);
                 }
-            }
-        }
-            break;
+                break;
 
-        case EC_PacketType::ServerMessage:
-            {
-                if (DataObj.IsValid())
+            case EConvaiServerPacketType::ActionResponse:
+                OnActionsReceived(Connection, Packet.Actions);
+                break;
+
+            case EConvaiServerPacketType::BTResponse:
+                OnNarrativeSectionReceived(Connection, Packet.BTCode, Packet.BTConstants, Packet.NarrativeSectionID);
+                break;
+
+            case EConvaiServerPacketType::ModerationResponse:
+                CONVAI_LOG(ConvaiSubsystemLog, Warning, TEXT("OnDataPacketReceived: ModerationResponse"));
+                break;
+
+            case EConvaiServerPacketType::Visemes:
+            case EConvaiServerPacketType::PackedFrames:
+                if (!Connection.bFrameFormatChecked)
                 {
-                    FString ServerPacketTypeStr;
-                    DataObj->TryGetStringField(TEXT("type"), ServerPacketTypeStr);
-                    
-                    switch (const EC_ServerPacketType ServerPacketType = ToServerPacketType(ServerPacketTypeStr))
+                    // JSON frames answering a packed request show the server ignored it. They are still played,
+                    // only later connections to this character stop asking for packed ones
+                    Connection.bFrameFormatChecked = true;
+                    if (Connection.ConnectionParams.FrameFormat != EConvaiFrameFormat::Json && Packet.ServerType == EConvaiServerPacketType::Visemes)
                     {
-                    case EC_ServerPacketType::BotEmotion:
-                        {
-                            if (DataObj.IsValid())
-                            {                    
-                                FString EmotionType;
-                                int32 EmotionScale;
-                                GetStringSafe(DataObj, TEXT("emotion"),      EmotionType);
-                                DataObj->TryGetNumberField(TEXT("scale"), EmotionScale);
-                                const FString EmotionResponse = FString::Printf(TEXT("%s %d"), *EmotionType, EmotionScale);
-                                OnEmotionReceived(EmotionResponse, FAnimationFrame(), false);
-                            }
-                        }
-                        break;
-                        
-                    case EC_ServerPacketType::ActionResponse:
-                        {
-                            if (DataObj.IsValid())
-                            {
-                                TArray<FString> Actions;
-                                DataObj->TryGetStringArrayField(TEXT("actions"), Actions);
-                                OnActionsReceived(Actions);
-                            }
-                        }
-                        break;
-
-                    case EC_ServerPacketType::BTResponse:
-                        {
-                            if (DataObj.IsValid())
-                            {
-                                FString BT_Code, BT_Constants, NarrativeSectionID;
-                                GetStringSafe(DataObj, TEXT("bt_code"),      BT_Code);
-                                GetStringSafe(DataObj, TEXT("bt_constants"),      BT_Constants);
-                                GetStringSafe(DataObj, TEXT("narrative_section_id"),      NarrativeSectionID);
-                                OnNarrativeSectionReceived(BT_Code, BT_Constants, NarrativeSectionID);
-                            }
-                        }
-                        break;
-                        
-                    case EC_ServerPacketType::ModerationResponse:
-                        {
-                            CONVAI_LOG(ConvaiSubsystemLog, Warning, TEXT("OnDataPacketReceived: ModerationResponse"));
-                        }
-                        break;
-                        
-                    case EC_ServerPacketType::Visemes:
-                        {
-                            if (DataObj.IsValid())
-                            {
-                                FAnimationSequence VisemeAnimationSequence;
-                                ConvertVisemeDataToAnimationSequence(DataObj, VisemeAnimationSequence);
-                                OnFaceDataReceived(VisemeAnimationSequence);
-                            }
-                        }
-                        break;
-                        
-                    case EC_ServerPacketType::Unknown:
-                        {
-                            CONVAI_LOG(ConvaiSubsystemLog, Warning, TEXT("OnDataPacketReceived: Unknown server type '%s'."), *ServerPacketTypeStr);
-                        }
-                        break;
-                        
-                    default:
-                        CONVAI_LOG(ConvaiSubsystemLog, Warning, TEXT("OnDataPacketReceived: Unhandled type '%s'."), *ServerPacketTypeStr);
+                        FConvaiConnectionParams::DisablePackedFrames(Connection.GetCharacterID(), Connection.ConnectionParams.FrameFormat);
                     }
                 }
+                if (Event.FaceData.GetNumFrames() > 0)
+                {
+                    OnFaceDataReceived(Connection, Event.FaceData);
+                }
+                break;
+
+            case EConvaiServerPacketType::Unknown:
+                CONVAI_LOG(ConvaiSubsystemLog, Warning, TEXT("OnDataPacketReceived: Unknown server type '%s'."), *Packet.UnknownTypeName);
+                break;
+
+            default:
+                CONVAI_LOG(ConvaiSubsystemLog, Warning, TEXT("OnDataPacketReceived: Unhandled server type %d."), static_cast<int32>(Packet.ServerType));
             }
             break;
 
-        case EC_PacketType::BotReady:
+        case EConvaiDataPacketType::BotReady:
             //CONVAI_LOG(ConvaiSubsystemLog, Log, TEXT("OnDataPacketReceived: BotReady"));
             break;
         
-        case EC_PacketType::BotLLMText:
+        case EConvaiDataPacketType::BotLLMText:
             //CONVAI_LOG(ConvaiSubsystemLog, Log, TEXT("OnDataPacketReceived: BotLLMText"));
             break;
     
-        case EC_PacketType::UserLLMText:
+        case EConvaiDataPacketType::UserLLMText:
             //CONVAI_LOG(ConvaiSubsystemLog, Log, TEXT("OnDataPacketReceived: UserLLMText"));  
             break;
-        case EC_PacketType::BotTTSStarted:
+        case EConvaiDataPacketType::BotTTSStarted:
             //CONVAI_LOG(ConvaiSubsystemLog, Log, TEXT("OnDataPacketReceived: BotTTSStarted"));
             break;
-        case EC_PacketType::BotTTSStopped:
+        case EConvaiDataPacketType::BotTTSStopped:
             //CONVAI_LOG(ConvaiSubsystemLog, Log, TEXT("OnDataPacketReceived: BotTTSStopped"));
             break;
-        case EC_PacketType::BotTTSText:
+        case EConvaiDataPacketType::BotTTSText:
             //CONVAI_LOG(ConvaiSubsystemLog, Log, TEXT("OnDataPacketReceived: BotTTSText"));
             break;
         
-        case EC_PacketType::Error:
-            {
-                if (DataObj.IsValid())
-                {                    
-                    FString ErrorStr;
-                    GetStringSafe(DataObj, TEXT("error"),ErrorStr);
-                    OnError(ErrorStr);
-                }
-            }
+        case EConvaiDataPacketType::Error:
+            OnError(Packet.Text);
             break;
             
-        case EC_PacketType::Unknown:
-            CONVAI_LOG(ConvaiSubsystemLog, Warning, TEXT("OnDataPacketReceived: Unknown packet type '%s'."), *DataPacketTypeStr);
+        case EConvaiDataPacketType::Unknown:
+            CONVAI_LOG(ConvaiSubsystemLog, Warning, TEXT("OnDataPacketReceived: Unknown packet type '%s'."), *Packet.UnknownTypeName);
             break;
             
         default:
-            CONVAI_LOG(ConvaiSubsystemLog, Warning, TEXT("OnDataPacketReceived: Unhandled type '%s'."), *DataPacketTypeStr);
+            CONVAI_LOG(ConvaiSubsystemLog, Warning, TEXT("OnDataPacketReceived: Unhandled packet type %d."), static_cast<int32>(Packet.Type));
     }    
 }
 
-void UConvaiSubsystem::OnLog(const char* log_message)
-{
-    const FString LogStr      = UTF8_TO_TCHAR(log_message);
-    CONVAI_LOG(ConvaiClientLog, Verbose, TEXT("%s"), *LogStr);
-}
-
-void UConvaiSubsystem::OnBotStartedSpeaking(const char* attendee_id) const
+void UConvaiSubsystem::OnBotStartedSpeaking(const FConvaiCharacterConnection& Connection, const char* attendee_id) const
 {
-    if (!IsValid(CurrentCharacterSession))
-    {
-        return;
-    }
-    
-    // Forward to the current character session
-    if (const TScriptInterface<IConvaiConnectionInterface> Interface = CurrentCharacterSession->GetConnectionInterface(); Interface.GetObject())
+    // Forward to the session attached to this character
+    if (const TScriptInterface<IConvaiConnectionInterface> Interface = GetCharacterInterface(Connection); Interface.GetObject())
     {
         Interface->OnStartedTalking();
     }
 }
 
-void UConvaiSubsystem::OnBotStoppedSpeaking(const char* attendee_id) const
+void UConvaiSubsystem::OnBotStoppedSpeaking(const FConvaiCharacterConnection& Connection, const char* attendee_id) const
 {
-    if (!IsValid(CurrentCharacterSession))
-    {
-        return;
-    }
-    
-    // Forward to the current character session
-    if (const TScriptInterface<IConvaiConnectionInterface> Interface = CurrentCharacterSession->GetConnectionInterface(); Interface.GetObject())
+    // Forward to the session attached to this character
+    if (const TScriptInterface<IConvaiConnectionInterface> Interface = GetCharacterInterface(Connection); Interface.GetObject())
     {
         Interface->OnFinishedTalking();
-		Interface->OnTranscriptionReceived("", true, true);
     }
 }
 
-void UConvaiSubsystem::OnBotTranscript(const char* text, const char* attendee_id) const
+void UConvaiSubsystem::OnBotTranscript(const FConvaiCharacterConnection& Connection, const FString& Text, const char* attendee_id) const
 {
-    if (!IsValid(CurrentCharacterSession))
-    {
-        return;
-    }
-    
-    // Forward to the current character session
-    if (const TScriptInterface<IConvaiConnectionInterface> Interface = CurrentCharacterSession->GetConnectionInterface(); Interface.GetObject())
+    // Forward to the session attached to this character
+    if (const TScriptInterface<IConvaiConnectionInterface> Interface = GetCharacterInterface(Connection); Interface.GetObject())
     {
-        Interface->OnTranscriptionReceived(UTF8_TO_TCHAR(text), true, false);
+        Interface->OnTranscriptionReceived(Text, true, false);
     }
 }
 
-void UConvaiSubsystem::OnNarrativeSectionReceived(const FString& BT_Code, const FString& BT_Constants,
+void UConvaiSubsystem::OnNarrativeSectionReceived(const FConvaiCharacterConnection& Connection, const FString& BT_Code, const FString& BT_Constants,
     const FString& ReceivedNarrativeSectionID) const
 {
-    if (!IsValid(CurrentCharacterSession))
-    {
-        return;
-    }
-    
-    // Forward to the current character session
-    if (const TScriptInterface<IConvaiConnectionInterface> Interface = CurrentCharacterSession->GetConnectionInterface(); Interface.GetObject())
+    // Forward to the session attached to this character
+    if (const TScriptInterface<IConvaiConnectionInterface> Interface = GetCharacterInterface(Connection); Interface.GetObject())
     {
         Interface->OnNarrativeSectionReceived(BT_Code, BT_Constants, ReceivedNarrativeSectionID);
     }
 }
 
-void UConvaiSubsystem::OnEmotionReceived(const FString& ReceivedEmotionResponse, const FAnimationFrame& EmotionBlendshapesFrame,
+void UConvaiSubsystem::OnEmotionReceived(const FConvaiCharacterConnection& Connection, const FString& ReceivedEmotionResponse, const FAnimationFrame& EmotionBlendshapesFrame,
     const bool MultipleEmotions) const
 {
-    if (!IsValid(CurrentCharacterSession))
-    {
-        return;
-    }
-    
-    // Forward to the current character session
-    if (const TScriptInterface<IConvaiConnectionInterface> Interface = CurrentCharacterSession->GetConnectionInterface(); Interface.GetObject())
+    // Forward to the session attached to this character
+    if (const TScriptInterface<IConvaiConnectionInterface> Interface = GetCharacterInterface(Connection); Interface.GetObject())
     {
         Interface->OnEmotionReceived(ReceivedEmotionResponse, EmotionBlendshapesFrame, MultipleEmotions);
     }
 }
 
-void UConvaiSubsystem::OnFaceDataReceived(const FAnimationSequence& VisemeAnimationSequence) const
+void UConvaiSubsystem::OnFaceDataReceived(const FConvaiCharacterConnection& Connection, const FAnimationSequence& VisemeAnimationSequence) const
 {
-    if (!IsValid(CurrentCharacterSession))
-    {
-        return;
-    }
-     
-    // Forward to the current character session
-    if (const TScriptInterface<IConvaiConnectionInterface> Interface = CurrentCharacterSession->GetConnectionInterface(); Interface.GetObject())
+    // Forward to the session attached to this character
+    if (const TScriptInterface<IConvaiConnectionInterface> Interface = GetCharacterInterface(Connection); Interface.GetObject())
     {
         Interface->OnFaceDataReceived(VisemeAnimationSequence);
     }
 }
 
-void UConvaiSubsystem::OnActionsReceived(TArray<FString>& Actions) const
+void UConvaiSubsystem::OnActionsReceived(const FConvaiCharacterConnection& Connection, TArray<FString>& Actions) const
 {
-    if (!IsValid(CurrentCharacterSession))
-    {
-        return;
-    }
-    
-    // Forward to the current character session
-    if (const TScriptInterface<IConvaiConnectionInterface> Interface = CurrentCharacterSession->GetConnectionInterface(); Interface.GetObject())
+    // Forward to the session attached to this character
+    if (const TScriptInterface<IConvaiConnectionInterface> Interface = GetCharacterInterface(Connection); Interface.GetObject())
     {
         TArray<FConvaiResultAction> SequenceOfActions;
         for (const FString& s : Actions)
@@ -1310,60 +1871,38 @@ void UConvaiSubsystem::OnError(const FString& ErrorMessage) const
     CONVAI_LOG(ConvaiSubsystemLog, Error, TEXT("Error : '%s'."), *ErrorMessage);
 }
 
-void UConvaiSubsystem::OnUserTranscript(const char* text, const char* attendee_id, bool final, const char* timestamp) const
+void UConvaiSubsystem::OnUserTranscript(const FConvaiCharacterConnection& Connection, const FString& Transcript, const char* attendee_id, bool final, const FString& Timestamp) const
 {
-    if (!IsValid(CurrentPlayerSession))
-    {
-        return;
-    }
-
-    const FString Transcript = UTF8_TO_TCHAR(text);
-    
-    // Forward to the current player session
-    if (const TScriptInterface<IConvaiConnectionInterface> Interface = CurrentPlayerSession->GetConnectionInterface(); Interface.GetObject())
+    // Forward to the player session when it is talking to this character
+    if (const TScriptInterface<IConvaiConnectionInterface> Interface = GetPlayerInterface(Connection); Interface.GetObject())
     {
         Interface->OnTranscriptionReceived(Transcript, true, final);
     }
 }
 
-void UConvaiSubsystem::OnUserStartedSpeaking(const char* attendee_id) const
+void UConvaiSubsystem::OnUserStartedSpeaking(const FConvaiCharacterConnection& Connection, const char* attendee_id) const
 {
-    if (!IsValid(CurrentPlayerSession))
-    {
-        return;
-    }
-    
-    // Forward to the current player session
-    if (const TScriptInterface<IConvaiConnectionInterface> Interface = CurrentPlayerSession->GetConnectionInterface(); Interface.GetObject())
+    // Forward to the player session when it is talking to this character
+    if (const TScriptInterface<IConvaiConnectionInterface> Interface = GetPlayerInterface(Connection); Interface.GetObject())
     {
         Interface->OnStartedTalking();
     }
 }
 
-void UConvaiSubsystem::OnUserStoppedSpeaking(const char* attendee_id) const
+void UConvaiSubsystem::OnUserStoppedSpeaking(const FConvaiCharacterConnection& Connection, const char* attendee_id) const
 {
-    if (!IsValid(CurrentPlayerSession))
-    {
-        return;
-    }
-    
-    // Forward to the current player session
-    if (const TScriptInterface<IConvaiConnectionInterface> Interface = CurrentPlayerSession->GetConnectionInterface(); Interface.GetObject())
+    // Forward to the player session when it is talking to this character
+    if (const TScriptInterface<IConvaiConnectionInterface> Interface = GetPlayerInterface(Connection); Interface.GetObject())
     {
         Interface->OnFinishedTalking();
 		Interface->OnTranscriptionReceived("", true, true);
     }
 }
 
-void UConvaiSubsystem::OnBotLLMStopped(const char* attendee_id) const
+void UConvaiSubsystem::OnBotLLMStopped(const FConvaiCharacterConnection& Connection, const char* attendee_id) const
 {
-    if (!IsValid(CurrentCharacterSession))
-    {
-        return;
-    }
-
-    // Forward to the current character session
-    if (const TScriptInterface<IConvaiConnectionInterface> Interface = CurrentCharacterSession->GetConnectionInterface(); Interface.GetObject())
+    // Forward to the session attached to this character
+    if (const TScriptInterface<IConvaiConnectionInterface> Interface = GetCharacterInterface(Connection); Interface.GetObject())
     {
         Interface->OnTranscriptionReceived("", true, true);
     }
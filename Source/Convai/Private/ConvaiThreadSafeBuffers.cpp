@@ -0,0 +1,63 @@
+// Copyright 2022 Convai Inc. All Rights Reserved.
+
+#include "ConvaiThreadSafeBuffers.h"
+
+uint32 FConvaiAudioBlock::Release() const
+{
+	const int32 Remaining = RefCount.fetch_sub(1, std::memory_order_acq_rel) - 1;
+	if (Remaining == 0)
+	{
+		FConvaiAudioBlockPool::Get().Return(const_cast<FConvaiAudioBlock*>(this));
+	}
+	return static_cast<uint32>(Remaining);
+}
+
+FConvaiAudioBlockPool& FConvaiAudioBlockPool::Get()
+{
+	// Never destroyed, blocks may be released by components that outlive static destruction
+	static FConvaiAudioBlockPool* Pool = new FConvaiAudioBlockPool();
+	return *Pool;
+}
+
+FConvaiAudioBlockRef FConvaiAudioBlockPool::Acquire(const uint8* InData, uint32 Size, uint32 InSampleRate, uint32 InNumChannels)
+{
+	FConvaiAudioBlock* Block = FreeBlocks.Pop();
+	if (Block)
+	{
+		NumFree.fetch_sub(1, std::memory_order_relaxed);
+	}
+	else
+	{
+		Block = new FConvaiAudioBlock();
+		NumAllocated.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	// Pooled blocks keep their storage, so this only allocates while the pool warms up
+	if (Block->Data.Num() < static_cast<int32>(Size))
+	{
+		Block->Data.SetNumUninitialized(Size);
+	}
+	if (InData && Size > 0)
+	{
+		FMemory::Memcpy(Block->Data.GetData(), InData, Size);
+	}
+
+	Block->NumBytes = Size;
+	Block->SampleRate = InSampleRate;
+	Block->NumChannels = InNumChannels;
+	return FConvaiAudioBlockRef(Block);
+}
+
+void FConvaiAudioBlockPool::Return(FConvaiAudioBlock* Block)
+{
+	if (NumFree.load(std::memory_order_relaxed) >= MaxFreeBlocks || Block->Data.Num() > MaxPooledBlockBytes)
+	{
+		NumAllocated.fetch_sub(1, std::memory_order_relaxed);
+		delete Block;
+		return;
+	}
+
+	Block->NumBytes = 0;
+	NumFree.fetch_add(1, std::memory_order_relaxed);
+	FreeBlocks.Push(Block);
+}
@@ -8,6 +8,7 @@
 #include "Containers/Map.h"
 #include "Sound/SoundWave.h"
 #include "AudioDevice.h"
+#include "AudioThread.h"
 #include "Interfaces/IAudioFormat.h"
 #include "UObject/Object.h"
 #include "GameFramework/PlayerController.h"
@@ -190,6 +191,27 @@ bool UConvaiUtils::ReadStringFromFile(FString& OutString, const FString& FilePat
 	return FFileHelper::LoadFileToString(OutString, *ProcessedFilePath);
 }
 
+#if !(ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 4)
+void UConvaiUtils::UnregisterSubmixBufferListener(FAudioDevice* AudioDevice, ISubmixBufferListener* Listener, USoundSubmix* Submix)
+{
+	check(IsInGameThread());
+
+	if (!AudioDevice || !Listener)
+	{
+		return;
+	}
+
+	AudioDevice->UnregisterSubmixBufferListener(Listener, Submix);
+
+	// The removal runs on the audio thread under the lock the render thread holds while calling listeners.
+	// Wait for it, and for any render commands it queued, after which the listener is never called again.
+	FAudioCommandFence Fence;
+	Fence.BeginFence();
+	Fence.Wait();
+	AudioDevice->FlushAudioRenderingCommands();
+}
+#endif
+
 double UConvaiUtils::CalculateAudioDuration(uint32 AudioSize, uint8 Channels, uint32 SampleRate, uint8 SampleSize)
 {
 	if (Channels == 0 || SampleRate == 0 || SampleSize == 0)
@@ -1284,18 +1306,13 @@ bool UConvaiUtils::ContainsAudioContent(const int16_t* AudioData, const size_t N
 TMap<FName, float> UConvaiUtils::MapBlendshapes(const TMap<FName, float>& InputBlendshapes, const TMap<FName, FConvaiBlendshapeParameters>& BlendshapeMap, float GlobalMultiplier, float GlobalOffset)
 {
 	TMap<FName, float> OutputMap;
-
-	// Generate arrays for original blendshape names and values
-	TArray<FName> OriginalNames;
-	TArray<float> OriginalValues;
-	InputBlendshapes.GenerateKeyArray(OriginalNames);
-	InputBlendshapes.GenerateValueArray(OriginalValues);
+	OutputMap.Reserve(InputBlendshapes.Num());
 
 	// Loop through each original blendshape
-	for (int i = 0; i < OriginalNames.Num(); i++)
+	for (const TPair<FName, float>& Blendshape : InputBlendshapes)
 	{
-		FName OriginalName = OriginalNames[i];
-		float OriginalValue = OriginalValues[i];
+		const FName OriginalName = Blendshape.Key;
+		const float OriginalValue = Blendshape.Value;
 
 		// Check if the original name has a mapped parameter
 		const FConvaiBlendshapeParameters* MappedParameter = BlendshapeMap.Find(OriginalName);
@@ -1384,11 +1401,10 @@ TMap<FName, float> UConvaiUtils::MergeBlendshapeMaps(
 	const TMap<FName, float>& OverrideMap
 )
 {
-	// Start with a copy of the base map
-	TMap<FName, float> Result = BaseMap;
-
-	// Reserve additional space for potential new keys from override map
+	// Reserve for the worst case up front so the copy and the overrides allocate once
+	TMap<FName, float> Result;
 	Result.Reserve(BaseMap.Num() + OverrideMap.Num());
+	Result.Append(BaseMap);
 
 	// Add/override with values from the override map
 	for (const auto& Pair : OverrideMap)
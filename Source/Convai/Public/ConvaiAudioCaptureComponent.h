@@ -7,6 +7,8 @@
 #include "Components/SynthComponent.h"
 #include "AudioCaptureCore.h"
 #include "AudioCaptureDeviceInterface.h"
+#include "ConvaiThreadSafeBuffers.h"
+#include <atomic>
 #include "ConvaiAudioCaptureComponent.generated.h"
 
 DECLARE_LOG_CATEGORY_EXTERN(ConvaiAudioLog, Log, All);
@@ -55,17 +57,23 @@ namespace Audio
 		// This returns audio only if there was non-zero audio since this function was last called.
 		bool GetAudioData(TArray<float>& OutAudioData);
 
+		// Copies up to MaxSamples captured samples into OutAudio, returns the number copied (never blocks or allocates)
+		int32 ReadAudioData(float* OutAudio, int32 MaxSamples);
+
 		// Returns the number of samples enqueued in the capture synth
 		int32 GetNumSamplesEnqueued();
 
+		// Returns the number of captured samples dropped because the consumer fell behind and the buffer was full
+		uint64 GetNumOverflowSamples() const;
+
 		FAudioCapture* GetAudioCapture();
 
 	private:
 		/** Handles audio capture callback processing */
 		void OnAudioCaptured(const float* AudioData, int32 NumFrames, int32 NumChannels);
 
-		// Number of samples enqueued
-		int32 NumSamplesEnqueued;
+		// Consumer side: drops samples written before the last StartCapturing
+		void ApplyPendingDiscard();
 
 		// Information about the default capture device we're going to use
 		FCaptureDeviceInfo CaptureInfo;
@@ -73,17 +81,20 @@ namespace Audio
 		// Audio capture object dealing with getting audio callbacks
 		FAudioCapture AudioCapture;
 
-		// Critical section to prevent reading and writing from the captured buffer at the same time
-		FCriticalSection CaptureCriticalSection;
+		// Lock-free buffer of audio capture data, yet to be copied to the output (device callback -> audio render thread)
+		TConvaiSPSCRingBuffer<float> AudioCaptureData;
 
-		// Buffer of audio capture data, yet to be copied to the output 
-		TArray<float> AudioCaptureData;
+		// Samples dropped by the device callback because AudioCaptureData was full
+		std::atomic<uint64> NumOverflowSamples;
+
+		// Write position at the last StartCapturing, the consumer discards everything before it
+		std::atomic<uint64> DiscardUntilPosition;
 
 		// If the object has been initialized
 		bool bInitialized;
 
 		// If we're capturing data
-		bool bIsCapturing;
+		std::atomic<bool> bIsCapturing;
 	};
 
 };
@@ -131,11 +142,14 @@ public:
 
 	Audio::FConvaiAudioCaptureSynth* GetCaptureSynth();
 
+	/** Number of microphone samples dropped because the capture buffer was full */
+	UFUNCTION(BlueprintPure, Category = "Convai|Microphone")
+	int64 GetCaptureOverflowSamples() const;
+
 private:
 	int32 SelectedDeviceIndex;
 
 	Audio::FConvaiAudioCaptureSynth CaptureSynth;
-	TArray<float> CaptureAudioData;
 	int32 CapturedAudioDataSamples;
 
 	bool bSuccessfullyInitialized;
@@ -143,7 +157,6 @@ private:
 	bool bIsStreamOpen;
 	int32 CaptureChannels;
 	int32 FramesSinceStarting;
-	int32 ReadSampleIndex;
 	FThreadSafeBool bIsDestroying;
 	FThreadSafeBool bIsNotReadyForForFinishDestroy;
 };
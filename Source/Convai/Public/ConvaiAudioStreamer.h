@@ -13,6 +13,7 @@
 #include "Templates/UnrealTemplate.h"
 #include "HAL/PlatformAtomics.h"
 #include "HAL/PlatformMisc.h"
+#include "Containers/Ticker.h"
 
 #include "ConvaiAudioStreamer.generated.h"
 
@@ -26,300 +27,6 @@ class IConvaiLipSyncExtendedInterface;
 class IConvaiVisionInterface;
 
 
-/**
- * Template for queues.
- *
- * This template implements an unbounded non-intrusive queue using a lock-free linked
- * list that stores copies of the queued items. The template can operate in two modes:
- * Multiple-producers single-consumer (MPSC) and Single-producer single-consumer (SPSC).
- *
- * The queue is thread-safe in both modes. The Dequeue() method ensures thread-safety by
- * writing it in a way that does not depend on possible instruction reordering on the CPU.
- * The Enqueue() method uses an atomic compare-and-swap in multiple-producers scenarios.
- *
- * @param T The type of items stored in the queue.
- * @param Mode The queue mode (single-producer, single-consumer by default).
- * @todo gmp: Implement node pooling.
- */
-template<typename T, EQueueMode Mode = EQueueMode::Spsc>
-class TConvaiQueue
-{
-public:
-	using FElementType = T;
-
-	/** Default constructor. */
-	TConvaiQueue()
-	{
-		Head = Tail = new TNode();
-	}
-
-	/** Destructor. */
-	~TConvaiQueue()
-	{
-		while (Tail != nullptr)
-		{
-			TNode* Node = Tail;
-			Tail = Tail->NextNode;
-
-			delete Node;
-		}
-	}
-
-	/**
-	 * Removes and returns the item from the tail of the queue.
-	 *
-	 * @param OutValue Will hold the returned value.
-	 * @return true if a value was returned, false if the queue was empty.
-	 * @note To be called only from consumer thread.
-	 * @see Empty, Enqueue, IsEmpty, Peek, Pop
-	 */
-	bool Dequeue(FElementType& OutItem)
-	{
-		TNode* Popped = Tail->NextNode;
-
-		if (Popped == nullptr)
-		{
-			return false;
-		}
-
-		TSAN_AFTER(&Tail->NextNode);
-		OutItem = MoveTemp(Popped->Item);
-
-		TNode* OldTail = Tail;
-		Tail = Popped;
-		Tail->Item = FElementType();
-		delete OldTail;
-
-		return true;
-	}
-
-	/**
-	 * Empty the queue, discarding all items.
-	 *
-	 * @note To be called only from consumer thread.
-	 * @see Dequeue, IsEmpty, Peek, Pop
-	 */
-	void Empty()
-	{
-		while (Pop());
-	}
-
-	/**
-	 * Adds an item to the head of the queue.
-	 *
-	 * @param Item The item to add.
-	 * @return true if the item was added, false otherwise.
-	 * @note To be called only from producer thread(s).
-	 * @see Dequeue, Pop
-	 */
-	bool Enqueue(const FElementType& Item)
-	{
-		TNode* NewNode = new TNode(Item);
-
-		if (NewNode == nullptr)
-		{
-			return false;
-		}
-
-		TNode* OldHead;
-
-		if (Mode == EQueueMode::Mpsc)
-		{
-			OldHead = (TNode*)FPlatformAtomics::InterlockedExchangePtr((void**)&Head, NewNode);
-			TSAN_BEFORE(&OldHead->NextNode);
-			FPlatformAtomics::InterlockedExchangePtr((void**)&OldHead->NextNode, NewNode);
-		}
-		else
-		{
-			OldHead = Head;
-			Head = NewNode;
-			TSAN_BEFORE(&OldHead->NextNode);
-			FPlatformMisc::MemoryBarrier();
-			OldHead->NextNode = NewNode;
-		}
-
-		return true;
-	}
-
-	/**
-	 * Adds an item to the head of the queue.
-	 *
-	 * @param Item The item to add.
-	 * @return true if the item was added, false otherwise.
-	 * @note To be called only from producer thread(s).
-	 * @see Dequeue, Pop
-	 */
-	bool Enqueue(FElementType&& Item)
-	{
-		TNode* NewNode = new TNode(MoveTemp(Item));
-
-		if (NewNode == nullptr)
-		{
-			return false;
-		}
-
-		TNode* OldHead;
-
-		if (Mode == EQueueMode::Mpsc)
-		{
-			OldHead = (TNode*)FPlatformAtomics::InterlockedExchangePtr((void**)&Head, NewNode);
-			TSAN_BEFORE(&OldHead->NextNode);
-			FPlatformAtomics::InterlockedExchangePtr((void**)&OldHead->NextNode, NewNode);
-		}
-		else
-		{
-			OldHead = Head;
-			Head = NewNode;
-			TSAN_BEFORE(&OldHead->NextNode);
-			FPlatformMisc::MemoryBarrier();
-			OldHead->NextNode = NewNode;
-		}
-
-		return true;
-	}
-
-	/**
-	 * Checks whether the queue is empty.
-	 *
-	 * @return true if the queue is empty, false otherwise.
-	 * @note To be called only from consumer thread.
-	 * @see Dequeue, Empty, Peek, Pop
-	 */
-	bool IsEmpty() const
-	{
-		return (Tail->NextNode == nullptr);
-	}
-
-	/**
-	 * Peeks at the queue's tail item without removing it.
-	 *
-	 * @param OutItem Will hold the peeked at item.
-	 * @return true if an item was returned, false if the queue was empty.
-	 * @note To be called only from consumer thread.
-	 * @see Dequeue, Empty, IsEmpty, Pop
-	 */
-	bool Peek(FElementType& OutItem) const
-	{
-		if (Tail->NextNode == nullptr)
-		{
-			return false;
-		}
-
-		OutItem = Tail->NextNode->Item;
-
-		return true;
-	}
-
-	/**
-	 * Peek at the queue's tail item without removing it.
-	 *
-	 * This version of Peek allows peeking at a queue of items that do not allow
-	 * copying, such as TUniquePtr.
-	 *
-	 * @return Pointer to the item, or nullptr if queue is empty
-	 */
-	FElementType* Peek()
-	{
-		if (Tail->NextNode == nullptr)
-		{
-			return nullptr;
-		}
-
-		return &Tail->NextNode->Item;
-	}
-
-	/**
-	 * Peek at the queue's head item
-	 *
-	 *
-	 * @return Pointer to the item, or nullptr if queue is empty
-	 */
-	FElementType* PeekHead()
-	{
-		if (Tail->NextNode == nullptr)
-		{
-			return nullptr;
-		}
-
-		return &Head->Item;
-	}
-
-
-	FORCEINLINE const FElementType* Peek() const
-	{
-		return const_cast<TConvaiQueue*>(this)->Peek();
-	}
-
-	/**
-	 * Removes the item from the tail of the queue.
-	 *
-	 * @return true if a value was removed, false if the queue was empty.
-	 * @note To be called only from consumer thread.
-	 * @see Dequeue, Empty, Enqueue, IsEmpty, Peek
-	 */
-	bool Pop()
-	{
-		TNode* Popped = Tail->NextNode;
-
-		if (Popped == nullptr)
-		{
-			return false;
-		}
-
-		TSAN_AFTER(&Tail->NextNode);
-
-		TNode* OldTail = Tail;
-		Tail = Popped;
-		Tail->Item = FElementType();
-		delete OldTail;
-
-		return true;
-	}
-
-private:
-
-	/** Structure for the internal linked list. */
-	struct TNode
-	{
-		/** Holds a pointer to the next node in the list. */
-		TNode* volatile NextNode;
-
-		/** Holds the node's item. */
-		FElementType Item;
-
-		/** Default constructor. */
-		TNode()
-			: NextNode(nullptr)
-		{ }
-
-		/** Creates and initializes a new node. */
-		explicit TNode(const FElementType& InItem)
-			: NextNode(nullptr)
-			, Item(InItem)
-		{ }
-
-		/** Creates and initializes a new node. */
-		explicit TNode(FElementType&& InItem)
-			: NextNode(nullptr)
-			, Item(MoveTemp(InItem))
-		{ }
-	};
-
-	/** Holds a pointer to the head of the list. */
-	MS_ALIGN(16) TNode* volatile Head GCC_ALIGN(16);
-
-	/** Holds a pointer to the tail of the list. */
-	TNode* Tail;
-
-private:
-
-	/** Hidden copy constructor. */
-	TConvaiQueue(const TConvaiQueue&) = delete;
-
-	/** Hidden assignment operator. */
-	TConvaiQueue& operator=(const TConvaiQueue&) = delete;
-};
-
 UCLASS()
 class UConvaiAudioStreamer : public UAudioComponent
 {
@@ -387,6 +94,7 @@ public:
 public:
 	// UActorComponent interface
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
 	// UObject Interface.
@@ -450,16 +158,25 @@ bool bIsPlayingAudio;
 
 // Configuration parameters
 float MinBufferDuration;
+float MaxBufferDuration;
+
+// Adaptive playout delay for incoming audio
+FAudioJitterEstimator AudioJitter;
 
 // Thread-safe buffers for transport thread -> game thread communication
 FAudioRingBuffer AudioRingBuffer;      // For incoming audio from transport thread
 FLipSyncBuffer LipSyncBuffer;          // For accumulating lipsync frames
+FConvaiGameThreadTaskQueue GameThreadTasks; // For events and work posted from other threads
 
-// Track how many bytes we've sent to lipsync component (for non-precomputed lipsync)
-uint32 BytesSentToLipSync;
+// Posts work to run on the game thread from the core ticker, dropped if the component is gone by then (THREAD-SAFE)
+void EnqueueGameThreadTask(TUniqueFunction<void()>&& Task);
+
+// Runs the task right away on the game thread, otherwise posts it with EnqueueGameThreadTask (THREAD-SAFE)
+void RunOnGameThread(TUniqueFunction<void()>&& Task);
 
 // Audio handling functions (called from transport thread - lightweight)
 void HandleAudioReceived(uint8* AudioData, uint32 AudioDataSize, bool ContainsHeaderData, uint32 SampleRate, uint32 NumChannels);
+void HandleAudioBlockReceived(const FConvaiAudioBlockRef& AudioBlock);
 void HandleLipSyncReceived(FAnimationSequence& FaceSequence);
 
 // Processing functions (called from game thread - heavy logic)
@@ -467,11 +184,26 @@ void ProcessIncomingAudio(bool Force = false);
 void ProcessIncomingLipSync();
 void ForcePlayBufferedAudio();
 
-// Helper function to dequeue audio data if ready, returns number of bytes dequeued (0 if not ready)
-uint32 TryDequeueAudioChunk(TArray<uint8>& OutAudioData, uint32& OutSampleRate, uint32& OutNumChannels, bool Force = false);
+// Helper function to check whether enough audio is buffered to start or continue playback
+bool IsAudioReadyToPlay(uint32 SampleRate, uint32 NumChannels, bool Force = false);
+
+// Helper function to send audio the lipsync tap has not seen yet to non-precomputed lipsync component
+void SendNewAudioToLipSync(uint32 SampleRate, uint32 NumChannels);
 
-// Helper function to send new buffered audio to non-precomputed lipsync component
-void SendNewAudioToLipSync(uint32 AvailableBytes, uint32 SampleRate, uint32 NumChannels);
+// Playback ran out of audio while more was expected, grows the playout delay
+void NotifyPlaybackUnderrun();
+
+/** Number of times playback ran dry while more audio was expected */
+UFUNCTION(BlueprintPure, Category = "Convai|Audio")
+int32 GetAudioUnderrunCount() const;
+
+/** Number of incoming audio packets that arrived later than the playout delay could absorb */
+UFUNCTION(BlueprintPure, Category = "Convai|Audio")
+int32 GetLateAudioPacketCount() const;
+
+/** Target playout delay last used to hold incoming audio before playback starts, in seconds. Follows the measured arrival jitter and grows after underruns */
+UFUNCTION(BlueprintPure, Category = "Convai|Audio")
+float GetAudioPlayoutDelay() const;
 
 /**
  * Returns the duration of content (audio) that is
@@ -491,13 +223,25 @@ private:
 	// Buffer for pending audio data when lock is held
 	TArray<uint8> PendingAudioBuffer;
 
-	// Reusable buffer for processing audio chunks (avoids repeated allocations)
-	TArray<uint8> AudioChunkBuffer;
-	const uint32 MaxChunkSize = 1024 * 400; // 400KB chunks
-
-	// Reusable buffer for peeking audio to send to lipsync (avoids repeated allocations)
-	TArray<uint8> LipSyncPeekBuffer;
-
 	// Process any pending audio data
 	void ProcessPendingAudio();
+
+	// Runs GameThreadTasks from the core ticker, registered between BeginPlay and EndPlay
+#if ENGINE_MAJOR_VERSION >= 5
+	FTSTicker::FDelegateHandle GameThreadTasksTickerHandle;
+#else
+	FDelegateHandle GameThreadTasksTickerHandle;
+#endif
+	bool ProcessGameThreadTasks(float DeltaTime);
+	void RemoveGameThreadTasksTicker();
+
+	// Queues PCM into SoundWaveProcedural, configuring it for a new format, without touching the fade, timer or talking state.
+	// Returns false if the audio was only buffered or there is no sound wave
+	bool QueueVoiceData(uint8* VoiceData, uint32 VoiceDataSize, uint32 SampleRate, uint32 NumChannels);
+
+	// Fires onAudioStarted the first time audio is queued
+	void MarkTalking();
+
+	// Blocks ProcessIncomingAudio dequeued this tick, emptied after queuing but kept so its allocation is reused
+	TArray<FConvaiAudioBlockRef> ReadyAudioBlocks;
 };
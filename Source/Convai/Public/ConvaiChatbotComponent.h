@@ -6,6 +6,7 @@
 #include "ConvaiConversationComponent.h"
 #include "ConvaiDefinitions.h"
 #include "ConvaiConnectionInterface.h"
+#include "ConvaiFrameChangeDetector.h"
 #include "ConvaiChatbotComponent.generated.h"
 
 // Forward declarations
@@ -147,6 +148,27 @@ public:
 
 	UFUNCTION(BlueprintCallable, BlueprintInternalUseOnly, Category = "Convai")
 	void UpdateDynamicEnvironmentInfo(FString InDynamicEnvironmentInfo);
+
+	/**
+	 *    Vision frames whose largest regional brightness change from the last sent frame is below this value (0 to 1) are not sent.
+	 *    0 sends every frame.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Convai|Vision", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float VisionChangeThreshold = 0.03f;
+
+	/**
+	 *    Longest time in seconds between sent vision frames, even if the scene has not changed. 0 only sends changed frames.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Convai|Vision", meta = (ClampMin = "0.0"))
+	float VisionKeyframeInterval = 2.0f;
+
+	/** Number of vision frames sent since the component started */
+	UFUNCTION(BlueprintPure, BlueprintCallable, Category = "Convai|Vision")
+	int32 GetVisionFramesSent() const { return VisionFramesSent; }
+
+	/** Number of vision frames captured but not sent because the scene had not changed */
+	UFUNCTION(BlueprintPure, BlueprintCallable, Category = "Convai|Vision")
+	int32 GetVisionFramesSkipped() const { return VisionFramesSkipped; }
 	
 	/**
 	 *   Speaker ID used for long term memory (LTM)
@@ -367,7 +389,9 @@ private:
 	UConvaiChatBotGetDetailsProxy* ConvaiChatBotGetDetailsProxy;
 
 	TMap<FName, float> EmotionBlendshapes;
-	TArray<uint8> RecordedAudio;
+	// Blocks shared with playback, filled on the transport thread and flattened by FinishRecordingVoice
+	TArray<FConvaiAudioBlockRef> RecordedAudioBlocks;
+	FCriticalSection RecordedAudioLock;
 	uint32 RecordedAudioSampleRate;
 	bool IsRecordingAudio;
 
@@ -392,6 +416,15 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Convai|Session")
 	void StopSession();
 
+	/**
+	 * Opens a connection to this character before the session starts, e.g. when the player is predicted
+	 * to approach, so StartSession attaches without waiting for the connection handshake.
+	 * The connection stays warm for WarmConnectionTimeout seconds if no session attaches.
+	 * @return True if a connection is open or being opened
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Convai|Session")
+	bool PrewarmConnection();
+
 private:	
 	// IConvaiConnectionInterface implementation
 	virtual UConvaiEnvironment* GetConvaiEnvironment() override{ return Environment; }
@@ -436,4 +469,17 @@ private:
 
 	// Cache the last seen FPS to avoid recomputing every tick
 	int32 CachedVisionFPS = 15;
+
+	// Frame CaptureRaw writes into, kept between sends so it is only allocated when the resolution grows
+	TArray<uint8> VisionFrameBuffer;
+
+	// Suppresses vision frames that match the last one sent
+	FConvaiFrameChangeDetector VisionFrameChangeDetector;
+	double LastVisionFrameSentTime = 0.0;
+
+	// Set when the receiving end may not have the reference frame, e.g. a new connection. Connection callbacks can come from other threads
+	FThreadSafeBool bVisionReferenceStale = true;
+	bool bVisionWasCapturing = false;
+	int32 VisionFramesSent = 0;
+	int32 VisionFramesSkipped = 0;
 };
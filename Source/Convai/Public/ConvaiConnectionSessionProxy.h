@@ -55,7 +55,11 @@ public:
      */
     int32 SendAudio(const int16_t* AudioData, size_t NumFrames) const;
 
-    void SendImage(uint32 Width, uint32 Height, TArray<uint8> Data) const;
+    /**
+     * Send a raw RGBA8 frame through the session, Data is only read for the duration of the call
+     * @return True if the frame was sent, false if it was dropped or only started video publishing
+     */
+    bool SendImage(uint32 Width, uint32 Height, TArray<uint8>& Data) const;
     
     void SendTextMessage(const FString& Message) const;
     
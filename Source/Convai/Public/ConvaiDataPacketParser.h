@@ -0,0 +1,128 @@
+// Copyright 2022 Convai Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ConvaiDefinitions.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(ConvaiDataPacketLog, Log, All);
+
+/** Top-level "type" of a data packet received from the WebRTC client */
+enum class EConvaiDataPacketType : uint8
+{
+	UserStartedSpeaking,
+	UserStoppedSpeaking,
+	UserTranscription,
+	BotLLMStarted,
+	BotLLMStopped,
+	BotStartedSpeaking,
+	BotStoppedSpeaking,
+	BotTranscription,
+	ServerMessage,
+	BotReady,
+	BotLLMText,
+	UserLLMText,
+	BotTTSStarted,
+	BotTTSStopped,
+	BotTTSText,
+	Error,
+	Unknown
+};
+
+/** "data.type" of a server-message packet */
+enum class EConvaiServerPacketType : uint8
+{
+	BotEmotion,
+	ActionResponse,
+	BTResponse,
+	ModerationResponse,
+	Visemes,
+	PackedFrames,
+	Unknown
+};
+
+/**
+ * A decoded data packet. Only the fields belonging to Type / ServerType are filled in,
+ * and strings only allocate for fields that are present, so it is cheap to keep on the stack.
+ */
+struct CONVAI_API FConvaiDataPacket
+{
+	static constexpr int32 NumVisemes = 15;
+
+	EConvaiDataPacketType Type = EConvaiDataPacketType::Unknown;
+	EConvaiServerPacketType ServerType = EConvaiServerPacketType::Unknown;
+
+	// Type string as received, only kept for unknown types so they can be logged
+	FString UnknownTypeName;
+
+	// user-transcription, bot-transcription and error (the "error" field)
+	FString Text;
+	FString Timestamp;
+	bool bFinal = false;
+
+	// bot-emotion
+	FString Emotion;
+	int32 EmotionScale = 0;
+
+	// action-response
+	TArray<FString> Actions;
+
+	// behavior-tree-response
+	FString BTCode;
+	FString BTConstants;
+	FString NarrativeSectionID;
+
+	// visemes, weights in ConvaiConstants::VisemeNames order clamped to [0, 1], missing visemes are 0
+	float Visemes[NumVisemes] = {};
+	bool bHasVisemes = false;
+
+	// packed-frames, decoded straight from the "frames" field
+	FConvaiPackedFrames PackedFrames;
+	bool bHasPackedFrames = false;
+};
+
+/**
+ * Hand-rolled parser for the JSON data packets delivered by the WebRTC client.
+ * Works on the raw UTF-8 bytes: the packet type is matched on its length and a
+ * distinguishing character, and only the payload fields the handlers use are decoded,
+ * straight into FConvaiDataPacket. Replaces a full FJsonObject DOM plus FString
+ * comparisons per packet, which showed up at viseme rates (~100 packets/s per character).
+ * Stateless, callable from any thread.
+ */
+class CONVAI_API FConvaiDataPacketParser
+{
+public:
+	/**
+	 * Parses one packet.
+	 * @param Json - UTF-8 packet, need not be null-terminated
+	 * @param Length - Packet length in bytes
+	 * @param OutPacket - Receives the decoded packet, should be freshly constructed
+	 * @return False if the packet is not a JSON object with a string "type"
+	 */
+	static bool Parse(const char* Json, int32 Length, FConvaiDataPacket& OutPacket);
+
+	/** Parses a null-terminated packet */
+	static bool Parse(const char* Json, FConvaiDataPacket& OutPacket);
+
+	/**
+	 * Reads only the leading "type" member, cheap enough for the transport thread.
+	 * @return Unknown when the first member is not "type", Parse still handles such packets
+	 */
+	static EConvaiDataPacketType PeekType(const char* Json, int32 Length);
+
+	static EConvaiDataPacketType ToPacketType(const char* Str, int32 Len);
+	static EConvaiServerPacketType ToServerPacketType(const char* Str, int32 Len);
+
+	/** Index into ConvaiConstants::VisemeNames for a server viseme key ("sil", "pp", ...), INDEX_NONE if unknown */
+	static int32 ToVisemeIndex(const char* Str, int32 Len);
+
+	/**
+	 * Decodes the "frames" field of a packed-frames packet, requested with EConvaiFrameFormat.
+	 * The data channel only carries text, so the frames are base64 inside the usual JSON envelope.
+	 * Decoded layout, little endian:
+	 *   uint8 Version (1), uint8 EConvaiCurveSet, uint8 Quantization (0 = uint8 / 255, 1 = half float),
+	 *   uint8 FrameRate, uint16 NumFrames, then NumFrames * NumCurves values in curve-set order.
+	 * @return False if the payload is malformed, OutFrames is then left empty
+	 */
+	static bool DecodePackedFrames(const char* Base64, int32 Len, FConvaiPackedFrames& OutFrames);
+};
@@ -263,6 +263,59 @@ struct FConvaiBlendshapeParameters
 		float ClampMaxValue = 1;
 };
 
+struct FAnimationSequence;
+
+/** Fixed curve tables lipsync frames can be packed against */
+enum class EConvaiCurveSet : uint8
+{
+	Visemes,	// ConvaiConstants::VisemeNames order, 15 curves
+	ARKit		// ConvaiConstants::BlendShapesNames order, 52 curves
+};
+
+/**
+ * Lipsync frames of one curve set as a single contiguous float array, frame after frame.
+ * Curves are identified by their index in the curve set, no names are stored per frame,
+ * so a second of 60fps ARKit frames is one 12KB allocation instead of 60 hash maps.
+ */
+struct CONVAI_API FConvaiPackedFrames
+{
+	EConvaiCurveSet CurveSet = EConvaiCurveSet::Visemes;
+	int32 NumCurves = 0;
+	int32 NumFrames = 0;
+	int32 FrameRate = 0;
+	TArray<float> Values;
+
+	static int32 GetNumCurves(EConvaiCurveSet InCurveSet);
+
+	/** Curve names of a curve set, built once */
+	static const TArray<FName>& GetCurveNames(EConvaiCurveSet InCurveSet);
+
+	bool IsEmpty() const { return NumFrames == 0; }
+
+	const float* GetFrame(int32 FrameIndex) const { return Values.GetData() + FrameIndex * NumCurves; }
+	float* GetFrame(int32 FrameIndex) { return Values.GetData() + FrameIndex * NumCurves; }
+
+	/** Removes all frames, keeping the allocation, and binds the frames to InCurveSet */
+	void Reset(EConvaiCurveSet InCurveSet);
+
+	/** Appends a zeroed frame and returns its NumCurves weights */
+	float* AddFrame();
+
+	/** Appends the frames of Other, which must use the same curve set */
+	void Append(const FConvaiPackedFrames& Other);
+
+	void RemoveFrames(int32 FrameIndex, int32 Count);
+
+	/** Name-keyed view of one frame, for the Blueprint facing TMap APIs */
+	static void FrameToMap(EConvaiCurveSet InCurveSet, const float* Weights, TMap<FName, float>& OutBlendShapes);
+
+	/** Packs a name-keyed frame, curves missing from BlendShapes are 0 */
+	static void MapToFrame(const TMap<FName, float>& BlendShapes, EConvaiCurveSet InCurveSet, float* OutWeights);
+
+	/** Appends one frame of GetNumCurves(InCurveSet) weights, indexed in curve-set order */
+	static void AppendFrame(EConvaiCurveSet InCurveSet, const float* Weights, int32 FrameIndex, FAnimationSequence& OutSequence);
+};
+
 USTRUCT()
 struct FAnimationFrame
 {
@@ -309,9 +362,36 @@ public:
 	UPROPERTY()
 	int32 FrameRate = 0;
 
+	/**
+	 * The same frames packed against a fixed curve set, used by the lipsync pipeline instead of AnimationFrames.
+	 * A sequence holds either packed or name-keyed frames, never both. Not reflected, so sequences handed
+	 * to Blueprint go through ExpandPackedFrames first.
+	 */
+	FConvaiPackedFrames PackedFrames;
+
+	bool IsPacked() const { return !PackedFrames.IsEmpty(); }
+
+	int32 GetNumFrames() const { return IsPacked() ? PackedFrames.NumFrames : AnimationFrames.Num(); }
+
+	/** Appends the frames of Other (not Duration or FrameRate), they stay packed if both sides use the same curve set */
+	CONVAI_API void AppendFrames(const FAnimationSequence& Other);
+
+	/** Converts packed frames to AnimationFrames */
+	CONVAI_API void ExpandPackedFrames();
+
+	/** Converts the frames to packed frames of InCurveSet, does nothing if they already are */
+	CONVAI_API void PackFrames(EConvaiCurveSet InCurveSet);
+
 	// Serialize this struct to a JSON string
 	FString ToJson() const
 	{
+		if (IsPacked())
+		{
+			FAnimationSequence Expanded = *this;
+			Expanded.ExpandPackedFrames();
+			return Expanded.ToJson();
+		}
+
 		TSharedPtr<FJsonObject> JsonObject = MakeShareable(new FJsonObject);
 
 		// Convert AnimationFrames to a JSON array
@@ -348,6 +428,7 @@ public:
 	bool FromJson(const FString& JsonString)
 	{
 		AnimationFrames.Empty();
+		PackedFrames = FConvaiPackedFrames();
 		Duration = 0;
 		FrameRate = 0;
 		TSharedPtr<FJsonObject> JsonObject;
@@ -1110,6 +1191,14 @@ namespace convai {
 	class ConvaiClient;
 }
 
+/** Encoding the server uses for lipsync frames on the data channel, negotiated at connect time */
+enum class EConvaiFrameFormat : uint8
+{
+	Json,		// One JSON object per frame, always understood
+	PackedU8,	// FConvaiPackedFrames quantized to 8 bits per curve
+	PackedF16	// FConvaiPackedFrames as half floats
+};
+
 USTRUCT()
 struct CONVAI_API FConvaiConnectionParams
 {
@@ -1132,6 +1221,12 @@ public:
 
 	FString SpeakerID;
 
+	/** Lipsync frame encoding requested from the server, JSON frames are still accepted whatever is requested */
+	EConvaiFrameFormat FrameFormat;
+
+	/** Whether Client already ran Initialize, e.g. because it came from the client pool */
+	bool bIsClientInitialized;
+
 	FConvaiConnectionParams()
 		: Client(nullptr)
 		, CharacterID(TEXT(""))
@@ -1139,6 +1234,8 @@ public:
 		, ConnectionType(TEXT("audio"))
 		, BlendshapeProvider(TEXT("not_provided"))
 		, SpeakerID(TEXT(""))
+		, FrameFormat(EConvaiFrameFormat::Json)
+		, bIsClientInitialized(false)
 	{
 	}
 
@@ -1151,9 +1248,36 @@ public:
 		, ConnectionType(InConnectionType)
 		, BlendshapeProvider(InBlendshapeProvider)
 		, SpeakerID(InSpeakerID)
+		, FrameFormat(EConvaiFrameFormat::Json)
+		, bIsClientInitialized(false)
+	{
+	}
+
+	/** Whether a connection opened with these parameters can serve a session that needs Other */
+	bool IsCompatibleWith(const FConvaiConnectionParams& Other) const
 	{
+		return CharacterID == Other.CharacterID
+			&& LLMProvider == Other.LLMProvider
+			&& ConnectionType == Other.ConnectionType
+			&& BlendshapeProvider == Other.BlendshapeProvider
+			&& SpeakerID == Other.SpeakerID
+			&& FrameFormat == Other.FrameFormat;
 	}
 
+	/**
+	 * The blendshape_provider sent to the server. ConvaiConnectionConfig has no field for the frame
+	 * format, so a packed format is requested as a suffix, e.g. "ovr;frame_format=packed_u8".
+	 * Servers that do not understand the suffix are detected from their first face reply, see DisablePackedFrames.
+	 */
+	FString GetNegotiatedBlendshapeProvider() const;
+
+	/**
+	 * Stops requesting RequestedFormat for connections to the character created from now on (THREAD-SAFE).
+	 * Called when a connection that requested packed frames received JSON frames, i.e. the server ignored the suffix.
+	 * Holds until LipSyncFrameFormat asks for a different format.
+	 */
+	static void DisablePackedFrames(const FString& InCharacterID, EConvaiFrameFormat RequestedFormat);
+
 	/**
 	 * Creates connection parameters by determining the appropriate settings
 	 * @param InClient - The ConvaiClient instance
@@ -1162,6 +1286,15 @@ public:
 	 * @return Configured connection parameters
 	 */
 	static FConvaiConnectionParams Create(convai::ConvaiClient* InClient, const FString& InCharacterID, class UConvaiConnectionSessionProxy* SessionProxy);
+
+	/**
+	 * Creates connection parameters from the connection interface that will use them
+	 * @param InClient - The ConvaiClient instance
+	 * @param InCharacterID - The character ID to connect to
+	 * @param Interface - The interface to determine settings from, project defaults are used when null
+	 * @return Configured connection parameters
+	 */
+	static FConvaiConnectionParams Create(convai::ConvaiClient* InClient, const FString& InCharacterID, class IConvaiConnectionInterface* Interface);
 };
 
 UENUM(BlueprintType)
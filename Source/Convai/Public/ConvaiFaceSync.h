@@ -11,6 +11,41 @@
 
 DECLARE_LOG_CATEGORY_EXTERN(ConvaiFaceSyncLog, Log, All);
 
+/** A face sync component's latest evaluated frame */
+struct FConvaiLipSyncSnapshot
+{
+	EConvaiCurveSet CurveSet = EConvaiCurveSet::Visemes;
+
+	// Weights in CurveSet order, see FConvaiPackedFrames::GetCurveNames
+	TArray<float> Weights;
+
+	bool bIsPlaying = false;
+
+	// GFrameCounter of the evaluation
+	uint64 FrameNumber = 0;
+};
+
+/**
+ * Thread-safe holder of the latest frame of one face sync component.
+ * An anim instance keeps the shared reference in its proxy and reads it during the
+ * worker-thread update, without touching the component or waiting for OnFacialDataReady.
+ */
+class CONVAI_API FConvaiLipSyncFrameSource
+{
+public:
+	void Publish(EConvaiCurveSet CurveSet, const float* Weights, int32 NumCurves, bool bIsPlaying, uint64 FrameNumber);
+
+	/** Copies the latest frame, reusing the allocation of OutSnapshot */
+	void Read(FConvaiLipSyncSnapshot& OutSnapshot) const;
+
+	/** Name-keyed copy of the latest frame */
+	void ReadBlendshapes(TMap<FName, float>& OutBlendShapes) const;
+
+private:
+	mutable FCriticalSection Mutex;
+	FConvaiLipSyncSnapshot Snapshot;
+};
+
 UCLASS(meta = (BlueprintSpawnableComponent), DisplayName = "Convai Face Sync")
 class CONVAI_API UConvaiFaceSyncComponent : public USceneComponent, public IConvaiLipSyncInterface
 {
@@ -22,6 +57,7 @@ public:
 
 	// UActorComponent interface
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	// virtual void OnRegister() override;
 	// virtual void OnUnregister() override;
 	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType,
@@ -33,12 +69,7 @@ public:
 	virtual void ConvaiStopLipSync() override;
 	virtual void ConvaiPauseLipSync() override;
 	virtual void ConvaiResumeLipSync() override;
-	virtual TArray<float> ConvaiGetFacialData() override
-	{
-		TArray<float> FacialDataValues;
-		CurrentBlendShapesMap.GenerateValueArray(FacialDataValues);
-		return FacialDataValues;
-	}
+	virtual TArray<float> ConvaiGetFacialData() override { return CurrentFrame; }
 	virtual TArray<FString> ConvaiGetFacialDataNames() override { return ConvaiConstants::VisemeNames; }
 	// End IConvaiLipSyncInterface interface
 
@@ -47,10 +78,19 @@ public:
 	virtual void ConvaiApplyFacialFrame(FAnimationFrame FaceFrame, float Duration) override;
 	virtual bool RequiresPrecomputedFaceData() override { return true; }
 	virtual bool GeneratesFacialDataAsBlendshapes() override { return ToggleBlendshapeOrViseme; }
-	virtual TMap<FName, float> ConvaiGetFaceBlendshapes() override { return CurrentBlendShapesMap; }
+	virtual TMap<FName, float> ConvaiGetFaceBlendshapes() override;
+	virtual bool SupportsPackedFaceData() override { return true; }
 	// End IConvaiLipSyncExtendedInterface interface
 
-	virtual void Apply_StartEndFrames_PostProcessing(const int& CurrentFrameIndex, const int& NextFrameIndex, float& Alpha, TMap<FName, float>& StartFrame, TMap<FName, float>& EndFrame){}
+	// Frames are weights in GetCurveSet() order, see FConvaiPackedFrames.
+	// The base version forwards to the deprecated name-keyed overload while a subclass still overrides it.
+	// Called mid-interpolation, so with bParallelEvaluation both overloads run on a worker thread: only touch the frames and this component.
+	virtual void Apply_StartEndFrames_PostProcessing(const int& CurrentFrameIndex, const int& NextFrameIndex, float& Alpha, TArrayView<float> StartFrame, TArrayView<float> EndFrame);
+
+	UE_DEPRECATED(4.0, "Frames are packed per curve set, override the TArrayView overload of Apply_StartEndFrames_PostProcessing instead.")
+	virtual void Apply_StartEndFrames_PostProcessing(const int& CurrentFrameIndex, const int& NextFrameIndex, float& Alpha, TMap<FName, float>& StartFrame, TMap<FName, float>& EndFrame) { bForwardLegacyPostProcessing = false; }
+
+	// Runs on the game thread after CurrentFrame is updated, before the frame is published
 	virtual void ApplyPostProcessing() {}
 
 	// UFUNCTION(BlueprintCallable, Category = "Convai|LipSync")
@@ -64,6 +104,30 @@ public:
 
 	bool IsValidSequence(const FAnimationSequence &Sequence);
 
+	/**
+	 * Evaluates the frame at CurrentTime into CurrentFrame, against the layout of the last RefreshCurveLayout.
+	 * Runs on a worker thread when bParallelEvaluation is set, one evaluation per component at a time. The only
+	 * virtual it calls is Apply_StartEndFrames_PostProcessing, and through it the deprecated TMap overload.
+	 * @return True if a frame was produced, PublishEvaluatedFrame must follow on the game thread, otherwise PublishSequenceEnd
+	 */
+	bool EvaluateLipSync(double CurrentTime, double TimeOffset);
+
+	/** Runs ApplyPostProcessing on the evaluated frame and publishes it to the frame source (game thread) */
+	void PublishEvaluatedFrame();
+
+	/** Publishes a stopped rest frame once the playhead has passed the end of the sequence (game thread) */
+	void PublishSequenceEnd();
+
+	/** Latest frame for anim instances, safe to keep and read from any thread */
+	TSharedRef<FConvaiLipSyncFrameSource, ESPMode::ThreadSafe> GetLipSyncFrameSource() const { return FrameSource; }
+
+	/**
+	 * Latest published lipsync frame, keyed by curve name. Works with and without bParallelEvaluation,
+	 * and is safe to call from an animation blueprint's thread-safe update.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Convai|LipSync", meta = (BlueprintThreadSafe))
+	TMap<FName, float> GetLatestLipSyncFrame(bool& bIsLipSyncPlaying) const;
+
 	bool IsPlaying();
 
 	// Record the current time if this is the first LipSync sequence to be received after silence
@@ -73,28 +137,55 @@ public:
 
 	void ClearMainSequence();
 
+	/** Frames still buffered for playback, frames behind the playhead are released as it moves */
+	UFUNCTION(BlueprintPure, Category = "Convai|LipSync")
+	int32 GetBufferedLipSyncFrames();
+
+	/** Memory held by the buffered frames, in bytes */
+	UFUNCTION(BlueprintPure, Category = "Convai|LipSync")
+	int64 GetBufferedLipSyncBytes();
+
+	/** Largest number of frames buffered at once since the last stop */
+	UFUNCTION(BlueprintPure, Category = "Convai|LipSync")
+	int32 GetPeakBufferedLipSyncFrames();
+
 	TMap<FName, float> InterpolateFrames(const TMap<FName, float>& StartFrame, const TMap<FName, float>& EndFrame, float Alpha);
 
-	// Virtual function to get the curve names for interpolation - can be overridden by derived classes
+	// Same as above, reusing the allocation of OutFrame
+	void InterpolateFrames(const TMap<FName, float>& StartFrame, const TMap<FName, float>& EndFrame, float Alpha, TMap<FName, float>& OutFrame);
+
+	// Vectorized lerp of NumCurves packed weights into OutFrame, which may alias either input
+	static void InterpolateFrames(const float* StartFrame, const float* EndFrame, float Alpha, float* OutFrame, int32 NumCurves);
+
+	// Curve set the frames are packed against
+	EConvaiCurveSet GetCurveSet() { return GeneratesFacialDataAsBlendshapes() ? EConvaiCurveSet::ARKit : EConvaiCurveSet::Visemes; }
+
+	/**
+	 * Curves this component outputs. Curves of the curve set missing from the list are held at 0,
+	 * and ConvaiGetFaceBlendshapes is keyed by these names. Read on the game thread when the curve set changes.
+	 */
 	virtual const TArray<FString>& GetCurveNames()
 	{
 		return GeneratesFacialDataAsBlendshapes() ? ConvaiConstants::BlendShapesNames : ConvaiConstants::VisemeNames;
 	}
 
+	/** Rest pose played out after the last frame and on stop. Read on the game thread when the curve set changes */
 	virtual TMap<FName, float> GenerateZeroFrame() { return GeneratesFacialDataAsBlendshapes() ? ZeroBlendshapeFrame : ZeroVisemeFrame; }
 
-	virtual void SetCurrentFrametoZero()
-	{
-		if (GeneratesFacialDataAsBlendshapes())
-			CurrentBlendShapesMap = ZeroBlendshapeFrame;
-		else
-			CurrentBlendShapesMap = ZeroVisemeFrame;
-	}
+	/** GenerateZeroFrame packed against GetCurveSet() */
+	const TArray<float>& GetZeroFrame();
+
+	/** Re-reads GetCurveNames and GenerateZeroFrame if the curve set changed since the last call (game thread) */
+	void RefreshCurveLayout();
+
+	virtual void SetCurrentFrametoZero() { CurrentFrame = GetZeroFrame(); }
 
-	TMap<FName, float> GetCurrentFrame() { return CurrentBlendShapesMap; }
+	TMap<FName, float> GetCurrentFrame() { return ConvaiGetFaceBlendshapes(); }
 
 	const static TMap<FName, float> ZeroBlendshapeFrame;
 	const static TMap<FName, float> ZeroVisemeFrame;
+	const static TArray<float> ZeroBlendshapeWeights;
+	const static TArray<float> ZeroVisemeWeights;
 
 	//UPROPERTY(EditAnywhere, Category = "Convai|LipSync")
 	float AnchorValue = 0.5;
@@ -106,10 +197,56 @@ public:
 	UPROPERTY(EditAnywhere, Category = "Convai|LipSync")
 	bool ToggleBlendshapeOrViseme = false;
 
+	/**
+	 * Evaluate in a single ParallelFor pass with all other face sync components instead of ticking.
+	 * OnFacialDataReady is not fired: pull frames with GetLatestLipSyncFrame or GetLipSyncFrameSource.
+	 * ApplyPostProcessing still runs on the game thread, Apply_StartEndFrames_PostProcessing (including a subclass's
+	 * deprecated TMap override) runs on worker threads. Evaluation stops while the world is paused. Read at BeginPlay.
+	 */
+	UPROPERTY(EditAnywhere, Category = "Convai|LipSync")
+	bool bParallelEvaluation = false;
+
 protected:
 	float CurrentSequenceTimePassed;
-	TMap<FName, float> CurrentBlendShapesMap;
+
+	// Current weights in GetCurveSet() order
+	TArray<float> CurrentFrame;
+
+	// Frames being interpolated this tick, copied out of MainSequenceBuffer under the lock
+	TArray<float> StartFrameWeights;
+	TArray<float> EndFrameWeights;
+
+	// Packed against GetCurveSet(). A sliding window: frames behind the playhead are trimmed
+	// and StartTime moves forward by their duration, so the playhead stays where it was.
 	FAnimationSequence MainSequenceBuffer;
+	int32 PeakBufferedFrames = 0;
+	int32 NumTrimmedFrames = 0;
+	double TrimmedDuration = 0;
+
+	TSharedRef<FConvaiLipSyncFrameSource, ESPMode::ThreadSafe> FrameSource = MakeShared<FConvaiLipSyncFrameSource, ESPMode::ThreadSafe>();
+
+	// Built by RefreshCurveLayout for LayoutCurveSet: the packed zero frame, and a 0/1 weight per
+	// curve that GetCurveNames leaves out (empty when it lists the whole curve set)
+	EConvaiCurveSet LayoutCurveSet = EConvaiCurveSet::Visemes;
+	bool bHasCurveLayout = false;
+	bool bCustomCurveNames = false;
+	TArray<float> ZeroFrameWeights;
+	TArray<float> CurveMask;
+
+	// Cleared by the base deprecated Apply_StartEndFrames_PostProcessing, so frames stop being converted for it
+	bool bForwardLegacyPostProcessing = true;
+
+	// Set by EvaluateLipSync when the playhead is past MainSequenceBuffer.Duration
+	bool bPlayheadPastEnd = false;
+
+	// Whether the frame source last got a playing frame (game thread)
+	bool bPublishedPlaying = false;
+	TMap<FName, float> LegacyStartFrame;
+	TMap<FName, float> LegacyEndFrame;
+
+	// Drops the frames before FrameIndex, called with SequenceCriticalSection held
+	void TrimConsumedFrames(int32 FrameIndex, float FrameDuration);
+
 	FAnimationSequence RecordedSequenceBuffer;
 	FCriticalSection SequenceCriticalSection;
 	FCriticalSection RecordingCriticalSection;
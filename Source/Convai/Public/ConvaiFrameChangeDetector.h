@@ -0,0 +1,39 @@
+// Copyright 2022 Convai Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Cheap change check for RGBA8 vision frames.
+ * A frame is reduced to a GridSize x GridSize signature of average luma, sampling
+ * SamplesPerCell x SamplesPerCell pixels per cell (a few thousand reads, whatever the
+ * resolution), and compared with the signature of the last accepted frame. The score is
+ * the largest per-cell change, so a small object moving registers while a static scene does not.
+ */
+class CONVAI_API FConvaiFrameChangeDetector
+{
+public:
+	static constexpr int32 GridSize = 16;
+	static constexpr int32 SamplesPerCell = 4;
+
+	/**
+	 * Scores a frame against the last accepted one.
+	 * @return Largest per-cell luma change in [0, 1], 1 if nothing was accepted yet or the size changed
+	 */
+	float Compare(const uint8* RGBA, int32 Width, int32 Height);
+
+	/** Makes the last compared frame the reference for later comparisons */
+	void Accept();
+
+	void Reset();
+
+private:
+	static void ComputeSignature(const uint8* RGBA, int32 Width, int32 Height, uint8* OutSignature);
+
+	uint8 Reference[GridSize * GridSize] = {};
+	uint8 Pending[GridSize * GridSize] = {};
+	FIntPoint ReferenceSize = FIntPoint::ZeroValue;
+	FIntPoint PendingSize = FIntPoint::ZeroValue;
+	bool bHasReference = false;
+};
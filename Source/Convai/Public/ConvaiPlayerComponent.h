@@ -8,6 +8,9 @@
 #include "DSP/BufferVectorOperations.h"
 #include "ConvaiConnectionInterface.h"
 #include "ConvaiAudioProcessingInterface.h"
+#include "ConvaiResampler.h"
+#include "Containers/Ticker.h"
+#include "HAL/ThreadSafeBool.h"
 #include "ConvaiPlayerComponent.generated.h"
 
 #define TIME_BETWEEN_VOICE_UPDATES_SECS 0.01
@@ -17,6 +20,7 @@ DECLARE_LOG_CATEGORY_EXTERN(ConvaiPlayerLog, Log, All);
 
 class UConvaiAudioCaptureComponent;
 class UConvaiConnectionSessionProxy;
+class FConvaiMicCaptureListener;
 class IConvaiAudioProcessingInterface;
 
 USTRUCT(BlueprintType)
@@ -184,6 +188,18 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Convai|Session")
 	bool bAutoInitializeSession;
 
+	/**
+	 * Cut the microphone into fixed-size frames on the audio render thread and send them from there, independent of the game tick.
+	 * With audio processing attached, frames are processed and sent on the game thread instead, a hitch then delays them without losing any.
+	 * Applied the next time streaming starts.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Convai|Microphone")
+	bool bStreamFromAudioThread = true;
+
+	/** Size in milliseconds of the frames cut while streaming from the audio thread (10 or 20) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Convai|Microphone", meta = (ClampMin = "10", ClampMax = "20", EditCondition = "bStreamFromAudioThread"))
+	int32 StreamingFrameDurationMs = 10;
+
 private:
 	UPROPERTY()
 	USoundWaveProcedural* VoiceCaptureSoundWaveProcedural;
@@ -216,6 +232,27 @@ private:
 
 	void StartAudioCaptureComponent() const;
 	void StopAudioCaptureComponent() const;
+
+	// Streaming from the audio render thread through a listener on the capture submix. Frames are cut and
+	// sent on the render thread, or drained by the core ticker on the game thread when audio processing is attached
+	TSharedPtr<FConvaiMicCaptureListener, ESPMode::ThreadSafe> MicCaptureListener;
+#if ENGINE_MAJOR_VERSION >= 5
+	FTSTicker::FDelegateHandle MicCaptureTickerHandle;
+#else
+	FDelegateHandle MicCaptureTickerHandle;
+#endif
+	bool StartMicCaptureListener();
+	void StopMicCaptureListener();
+	bool DrainMicCapture(float DeltaTime);
+
+	// Points the listener at the session's connection, or at the game thread queue when audio processing is attached
+	void UpdateMicCaptureRouting();
+
+	// Set while streaming through the tick-driven chunk capture, read on the audio thread
+	FThreadSafeBool bStreamingByChunks = false;
+
+	// Sends a block of 16kHz mono mic audio to audio processing or the session (game thread)
+	void SendCapturedAudio(const int16* AudioData, int32 NumSamples);
 	
 	bool IsRecording = false;
 	bool IsStreaming = false;
@@ -223,6 +260,12 @@ private:
 
 	float RemainingTimeUntilNextUpdate = 0;
 
+	// Resamples mic chunks to VoiceCaptureSampleRate, keeps filter state between chunks (audio thread only)
+	FConvaiResampler VoiceCaptureResampler;
+
+	// Reusable output of VoiceCaptureResampler, keeps its slack between chunks (audio thread only)
+	TArray<int16> VoiceCaptureChunkBuffer;
+
 	USoundSubmixBase* _FoundSubmix;
 
 	// Override from UConvaiConversationComponent
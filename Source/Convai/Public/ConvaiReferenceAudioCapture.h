@@ -0,0 +1,69 @@
+// Copyright 2022 Convai Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AudioDevice.h"
+#include "HAL/ThreadSafeBool.h"
+#include "ConvaiResampler.h"
+#include "ConvaiThreadSafeBuffers.h"
+#include "ThirdParty/ConvaiWebRTC/include/convai/convai_client.h"
+#include <atomic>
+
+/**
+ * Captures reference audio (the rendered game output) for echo cancellation
+ * and sends it to convai_client.dll via the SendReferenceAudio method.
+ *
+ * Registered as a buffer listener on the main submix: the audio render thread
+ * resamples each rendered buffer and pushes it into a lock-free ring, and a
+ * background task is kicked only when at least one 10ms frame is waiting.
+ * Nothing polls, and the recorder is never torn down between frames.
+ */
+class CONVAI_API FConvaiReferenceAudioCapture : public ISubmixBufferListener, public TSharedFromThis<FConvaiReferenceAudioCapture, ESPMode::ThreadSafe>
+{
+public:
+    explicit FConvaiReferenceAudioCapture(convai::ConvaiClient* InConvaiClient, UWorld* InWorld);
+    virtual ~FConvaiReferenceAudioCapture();
+
+    // Control functions (game thread)
+    // StopCapture must run before the last reference is released, before 5.4 the audio device only holds a raw pointer.
+    void StartCapture();
+    void StopCapture();
+    bool IsCapturing() const { return bIsCapturing; }
+
+    // ISubmixBufferListener interface (audio render thread)
+    virtual void OnNewSubmixBuffer(const USoundSubmix* OwningSubmix, float* AudioData, int32 NumSamples, int32 NumChannels, const int32 SampleRate, double AudioClock) override;
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 4
+    virtual const FString& GetListenerName() const override;
+#endif
+
+private:
+    // ConvaiClient reference, only used by the send task under ClientMutex while bIsCapturing.
+    // StopCapture clears bIsCapturing under the same lock, so no send outlives it.
+    convai::ConvaiClient* ConvaiClient;
+    FCriticalSection ClientMutex;
+
+    // World reference for accessing the audio device
+    TWeakObjectPtr<UWorld> WorldPtr;
+    FAudioDeviceHandle AudioDeviceHandle;
+
+    FThreadSafeBool bIsCapturing;
+    std::atomic<bool> bSendTaskScheduled{ false };
+
+    // Render thread -> send task
+    TConvaiSPSCRingBuffer<int16> ReferenceRingBuffer;
+
+    // Render thread only
+    FConvaiResampler Resampler;
+    TArray<int16> ResampledBuffer;
+
+    // Send task only
+    TArray<int16> FrameBuffer;
+
+    int32 ProcessingChunkSize;
+    int32 TargetSampleRate;
+
+    void ScheduleSendTask();
+    void SendPendingFrames();
+    void SendAudioChunkToConvaiClient(const int16* AudioData, int32 NumSamples);
+};
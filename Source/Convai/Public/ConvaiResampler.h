@@ -0,0 +1,100 @@
+// Copyright 2022 Convai Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DSP/BufferVectorOperations.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(ConvaiResamplerLog, Log, All);
+
+/**
+ * Precomputed polyphase windowed-sinc filter bank for one (source, target) rate pair.
+ * Tables are immutable once built and shared between resamplers with the same rate pair.
+ */
+struct FConvaiPolyphaseFilterTable
+{
+	int32 SourceSampleRate = 0;
+	int32 TargetSampleRate = 0;
+
+	// Reduced rational ratio: every output sample advances the input by Step / Interpolation
+	int32 Interpolation = 1;
+	int32 Step = 1;
+
+	// Number of filter phases stored; equals Interpolation unless the ratio needs more than MaxPhases
+	int32 NumPhases = 1;
+
+	// Taps per phase (multiple of 4 so the inner loop is fully vectorized)
+	int32 NumTaps = 0;
+
+	// NumPhases * NumTaps coefficients, phase-major
+	TArray<float> Coefficients;
+
+	static constexpr int32 MaxPhases = 512;
+	static constexpr int32 ZeroCrossings = 8;
+
+	inline const float* GetPhase(int32 PhaseIndex) const
+	{
+		return Coefficients.GetData() + PhaseIndex * NumTaps;
+	}
+};
+
+/**
+ * Stateful streaming resampler for the capture paths (mic and reference audio).
+ * Downmixes interleaved input to mono, resamples it with a polyphase windowed-sinc
+ * filter, and writes int16. Filter history and phase carry over between chunks,
+ * so successive Process calls produce one continuous signal with no seams.
+ * Not thread-safe: each capture path owns its own instance.
+ */
+class CONVAI_API FConvaiResampler
+{
+public:
+	FConvaiResampler();
+
+	/** Configures the rate pair and channel count. History is kept when the configuration does not change. */
+	void Initialize(int32 InSourceSampleRate, int32 InTargetSampleRate, int32 InNumChannels);
+
+	/** Clears filter history and phase, e.g. when a capture session restarts */
+	void Reset();
+
+	bool IsInitialized() const { return Table.IsValid() || bPassthrough; }
+
+	int32 GetSourceSampleRate() const { return SourceSampleRate; }
+	int32 GetTargetSampleRate() const { return TargetSampleRate; }
+	int32 GetNumChannels() const { return NumChannels; }
+
+	/**
+	 * Downmixes and resamples interleaved input, appending mono int16 samples to OutSamples.
+	 * @return Number of samples appended
+	 */
+	int32 Process(const int16* InSamples, int32 NumFrames, TArray<int16>& OutSamples);
+	int32 Process(const float* InSamples, int32 NumFrames, TArray<int16>& OutSamples);
+
+	/**
+	 * Fused capture kernel: interleaved float mixer output -> mono -> resampled int16 in one pass,
+	 * appended to a caller-owned buffer so the audio thread does not allocate per chunk.
+	 * @return Number of samples appended
+	 */
+	int32 Process(const Audio::AlignedFloatBuffer& InBuffer, TArray<int16>& OutSamples);
+
+	/** Returns the shared filter table for a rate pair, building it on first use (THREAD-SAFE) */
+	static TSharedPtr<const FConvaiPolyphaseFilterTable, ESPMode::ThreadSafe> GetFilterTable(int32 InSourceSampleRate, int32 InTargetSampleRate);
+
+private:
+	template<typename SampleType>
+	int32 ProcessInternal(const SampleType* InSamples, int32 NumFrames, TArray<int16>& OutSamples);
+
+	int32 FilterHistory(TArray<int16>& OutSamples);
+
+	TSharedPtr<const FConvaiPolyphaseFilterTable, ESPMode::ThreadSafe> Table;
+
+	int32 SourceSampleRate;
+	int32 TargetSampleRate;
+	int32 NumChannels;
+	bool bPassthrough;
+
+	// Mono float input not yet fully consumed by the filter (starts with NumTaps / 2 - 1 zeros of priming)
+	TArray<float> History;
+
+	// Fractional input position of the next output sample, in units of 1 / Interpolation
+	int32 PhaseAccumulator;
+};
@@ -7,12 +7,15 @@
 #include "Subsystems/GameInstanceSubsystem.h"
 #include "HAL/Runnable.h"
 #include "HAL/ThreadSafeBool.h"
+#include "Containers/Ticker.h"
 #include "ConvaiConnectionInterface.h"
 #include "ConvaiConnectionSessionProxy.h"
 #include "ConvaiDefinitions.h"
-#include "ConvaiReferenceAudioThread.h"
+#include "ConvaiReferenceAudioCapture.h"
+#include "ConvaiDataPacketParser.h"
 
 #include <convai/convai_client.h>
+#include <atomic>
 
 #include "ConvaiSubsystem.generated.h"
 
@@ -22,6 +25,8 @@ namespace convai {
     class IConvaiClientListner;
 }
 
+class UConvaiSubsystem;
+
 #ifdef __APPLE__
 extern bool GetAppleMicPermission();
 #endif
@@ -29,6 +34,12 @@ extern bool GetAppleMicPermission();
 DECLARE_LOG_CATEGORY_EXTERN(ConvaiSubsystemLog, Log, All);
 DECLARE_LOG_CATEGORY_EXTERN(ConvaiClientLog, Log, All);
 
+#if ENGINE_MAJOR_VERSION >= 5
+using FConvaiTickerHandle = FTSTicker::FDelegateHandle;
+#else
+using FConvaiTickerHandle = FDelegateHandle;
+#endif
+
 // Connection state delegate
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnServerConnectionStateChangedSignature, EC_ConnectionState, ConnectionState);
 
@@ -54,8 +65,201 @@ private:
     FRunnableThread* Thread;
 };
 
+/**
+ * Pool of ConvaiClient instances that already ran Initialize, including the echo cancellation setup.
+ * Clients are initialized on background threads ahead of time and recycled when their connection is
+ * destroyed, so a connection only pays for the Connect handshake. (THREAD-SAFE)
+ */
+class FConvaiClientPool : public TSharedFromThis<FConvaiClientPool, ESPMode::ThreadSafe>
+{
+public:
+    explicit FConvaiClientPool(int32 InMaxIdleClients);
+    ~FConvaiClientPool();
+
+    /** Keeps NumClients initialized clients ready, initializing the missing ones in the background */
+    void Prewarm(int32 NumClients);
+
+    /** Returns an initialized client, or null when none is ready */
+    TUniquePtr<convai::ConvaiClient> Acquire();
+
+    /** Takes back a disconnected client for reuse, destroying it when the pool is full */
+    void Return(TUniquePtr<convai::ConvaiClient> Client);
+
+    /** Destroys the idle clients and stops accepting new ones */
+    void Empty();
+
+    /** Runs Initialize with the AEC configuration from the plugin settings */
+    static bool InitializeClient(convai::ConvaiClient& Client);
+
+    struct FStats
+    {
+        int32 NumIdle = 0;
+        int32 NumInitializing = 0;
+        int32 NumHits = 0;
+        int32 NumMisses = 0;
+        int32 NumRecycled = 0;
+    };
+    FStats GetStats() const;
+
+private:
+    void Refill();
+    void OnClientInitialized(TUniquePtr<convai::ConvaiClient> Client, bool bInitialized);
+
+    mutable FCriticalSection Mutex;
+    TArray<TUniquePtr<convai::ConvaiClient>> IdleClients;
+    int32 TargetIdleClients;
+    int32 MaxIdleClients;
+    bool bIsEmptied;
+    FStats Stats;
+};
+
+/** Time sessions waited for their character connection, game thread only */
+struct FConvaiConnectionMetrics
+{
+    int32 NumConnections = 0;
+    int32 NumWarmReuses = 0;
+    int32 NumPooledClients = 0;
+    double LastTimeToConnected = 0.0;
+    double MaxTimeToConnected = 0.0;
+    double TotalTimeToConnected = 0.0;
+
+    double GetAverageTimeToConnected() const { return NumConnections > 0 ? TotalTimeToConnected / NumConnections : 0.0; }
+};
+
+/**
+ * Cost of getting data packets to the sessions, game thread only.
+ * NumDecodeTasks against NumPacketsReceived is the task-graph pressure,
+ * the drain times are what the game thread pays per frame that had events.
+ */
+struct FConvaiPacketDeliveryStats
+{
+    int64 NumPacketsReceived = 0;
+    int64 NumDecodeTasks = 0;
+    int64 NumVisemePacketsCoalesced = 0;
+    int64 NumEventsDelivered = 0;
+    int64 NumDrains = 0;
+    double LastDrainTime = 0.0;
+    double MaxDrainTime = 0.0;
+    double TotalDrainTime = 0.0;
+
+    double GetAverageDrainTime() const { return NumDrains > 0 ? TotalDrainTime / NumDrains : 0.0; }
+};
+
+/** Raw data packet queued by the WebRTC thread for the decode stage */
+struct FConvaiRawDataPacket
+{
+    TArray<ANSICHAR> Json;
+
+    // Bot speaking state is applied on arrival so it stays ordered with the audio callbacks
+    bool bSpeakingStateDelivered = false;
+};
+
+/** A decoded data packet waiting for the game-thread drain */
+struct FConvaiDataPacketEvent
+{
+    FConvaiDataPacket Packet;
+    bool bSpeakingStateDelivered = false;
+
+    // Visemes as an animation sequence, consecutive viseme packets are merged into one event
+    FAnimationSequence FaceData;
+};
+
+/**
+ * One WebRTC connection to a single character.
+ * Owns its ConvaiClient and listens to it, handing every callback to the subsystem
+ * together with the connection so it reaches the session attached to that character.
+ * A connection outlives its session: once the session disconnects it stays warm until
+ * the same character is reused, the warm timeout expires or the concurrency cap evicts it.
+ */
+class FConvaiCharacterConnection : public convai::IConvaiClientListner, public TSharedFromThis<FConvaiCharacterConnection, ESPMode::ThreadSafe>
+{
+public:
+    FConvaiCharacterConnection(UConvaiSubsystem* InSubsystem, const FString& InCharacterID, const TSharedPtr<FConvaiClientPool, ESPMode::ThreadSafe>& InClientPool);
+    virtual ~FConvaiCharacterConnection() override;
+
+    /** Takes a pooled client when one is ready, otherwise creates one, and starts connecting on the connection thread */
+    bool Connect(const FConvaiConnectionParams& InConnectionParams);
+
+    /**
+     * Stops the connection thread and reference capture and disconnects the client (game thread).
+     * The client object itself lives until the connection is destroyed, so a send racing the shutdown stays safe.
+     */
+    void Shutdown();
+
+    const FString& GetCharacterID() const { return CharacterID; }
+    const FConvaiConnectionParams& GetConnectionParams() const { return ConnectionParams; }
+    convai::ConvaiClient* GetClient() const { return Client.Get(); }
+    bool IsConnected() const { return bIsConnected; }
+
+    // Client callbacks, forwarded to the subsystem
+    virtual void OnConnectedToServer() override;
+    virtual void OnDisconnectedFromServer() override;
+    virtual void OnAudioData(const char* attendee_id, const int16_t* audio_data, size_t num_frames,
+                             uint32_t sample_rate, uint32_t bits_per_sample, uint32_t num_channels) override;
+    virtual void OnAttendeeConnected(const char* attendee_id) override;
+    virtual void OnAttendeeDisconnected(const char* attendee_id) override;
+    virtual void OnActiveSpeakerChanged(const char* Speaker) override;
+    virtual void OnDataPacketReceived(const char *JsonData, const char *attendee_id) override;
+    virtual void OnLog(const char *log_message) override;
+
+    /** Hands a packet to the decode stage (WebRTC thread) */
+    void QueueDataPacket(const char* JsonData, int32 Length, bool bSpeakingStateDelivered);
+
+    /** Moves the decoded events, in arrival order, into OutEvents which should be empty (game thread) */
+    void TakeDecodedEvents(TArray<FConvaiDataPacketEvent>& OutEvents);
+
+private:
+    friend class UConvaiSubsystem;
+
+    void ScheduleDecodeTask();
+    void DecodePendingPackets();
+
+    // The subsystem shuts every connection down before it is destroyed
+    UConvaiSubsystem* Subsystem;
+    FString CharacterID;
+    FConvaiConnectionParams ConnectionParams;
+
+    // Clients that reached the connected state go back to the pool when the connection is destroyed
+    TSharedPtr<FConvaiClientPool, ESPMode::ThreadSafe> ClientPool;
+    TUniquePtr<convai::ConvaiClient> Client;
+    bool bUsedPooledClient;
+    FThreadSafeBool bCanRecycleClient;
+
+    TUniquePtr<FConvaiConnectionThread> ConnectionThread;
+    TSharedPtr<FConvaiReferenceAudioCapture, ESPMode::ThreadSafe> ReferenceAudioCapture;
+    FThreadSafeBool bIsConnected;
+    FThreadSafeBool bStartedPublishingVideo;
+    bool bIsShutdown;
+
+    // Whether a face packet confirmed ConnectionParams.FrameFormat, checked on the first one (game thread only)
+    bool bFrameFormatChecked = false;
+
+    // Guarded by the subsystem's SessionMutex
+    TWeakObjectPtr<UConvaiConnectionSessionProxy> Session;
+    TArray<FString> AttendeeIDs;
+    double LastUsedTime;
+
+    // When Connect started and when a session last attached, for the time-to-connected metrics
+    double ConnectStartTime;
+    double SessionAttachTime;
+
+    // Decode stage: the WebRTC thread queues raw packets, one background task at a time decodes them
+    // into DecodedEvents and the subsystem delivers those once per frame
+    TConvaiQueue<FConvaiRawDataPacket, EQueueMode::Mpsc> PacketInbox;
+    std::atomic<bool> bDecodeTaskScheduled{ false };
+    FCriticalSection DecodedEventsMutex;
+    TArray<FConvaiDataPacketEvent> DecodedEvents;
+
+    // Counted off the game thread, collected into the subsystem's stats by the drain
+    std::atomic<int32> NumPacketsReceived{ 0 };
+    std::atomic<int32> NumDecodeTasks{ 0 };
+    std::atomic<int32> NumVisemePacketsCoalesced{ 0 };
+};
+
+using FConvaiCharacterConnectionPtr = TSharedPtr<FConvaiCharacterConnection, ESPMode::ThreadSafe>;
+
 UCLASS(meta = (DisplayName = "Convai Subsystem"))
-class CONVAI_API UConvaiSubsystem : public UGameInstanceSubsystem, public convai::IConvaiClientListner
+class CONVAI_API UConvaiSubsystem : public UGameInstanceSubsystem
 {
     GENERATED_BODY()
 
@@ -75,7 +279,9 @@ public:
     static void GetAndroidMicPermission();
     
     /**
-     * Connect a session to the Convai service
+     * Connect a session to the Convai service.
+     * Each character gets its own connection; a warm connection to the same character is reused
+     * without reconnecting. The most recently connected character receives the player's audio.
      * @param SessionProxy - The session proxy to connect
      * @param CharacterID - The ID of the character to connect to (ignored for player sessions)
      * @return True if connection was initiated successfully
@@ -83,7 +289,8 @@ public:
     bool ConnectSession(UConvaiConnectionSessionProxy* SessionProxy, const FString& CharacterID);
     
     /**
-     * Disconnect a session from the Convai service
+     * Disconnect a session from the Convai service.
+     * The character connection is kept warm for WarmConnectionTimeout seconds so it can be reused.
      * @param SessionProxy - The session proxy to disconnect
      */
     void DisconnectSession(const UConvaiConnectionSessionProxy* SessionProxy);
@@ -96,12 +303,54 @@ public:
      * @return The number of bytes sent, or -1 on failure
      */
     int32 SendAudio(const UConvaiConnectionSessionProxy* SessionProxy, const int16_t* AudioData, size_t NumFrames) const;
-    void SendImage(const UConvaiConnectionSessionProxy* SessionProxy, uint32 Width, uint32 Height, TArray<uint8>& Data);
+
+    /**
+     * The connection a session currently sends through, for senders that run off the game thread.
+     * Holding it keeps the client alive, check IsConnected before each send and release it on the game thread.
+     */
+    FConvaiCharacterConnectionPtr GetSessionConnection(const UConvaiConnectionSessionProxy* SessionProxy) const;
+    bool SendImage(const UConvaiConnectionSessionProxy* SessionProxy, uint32 Width, uint32 Height, TArray<uint8>& Data);
     void SendTextMessage(const UConvaiConnectionSessionProxy* SessionProxy,const FString& Message) const;
     void SendTriggerMessage(const UConvaiConnectionSessionProxy* SessionProxy,const FString& Trigger_Name, const FString& Trigger_Message) const;
     void UpdateTemplateKeys(const UConvaiConnectionSessionProxy* SessionProxy,TMap<FString, FString> Template_Keys) const;
     void UpdateDynamicInfo(const UConvaiConnectionSessionProxy* SessionProxy,const FString& Context_Text) const;
-    static void OnConnectionFailed();
+    static void OnConnectionFailed(convai::ConvaiClient* Client);
+
+    /** Number of open character connections, including warm ones */
+    int32 GetNumCharacterConnections() const;
+
+    /** Whether a connection to the character is open, attached or warm */
+    bool HasCharacterConnection(const FString& CharacterID) const;
+
+    /**
+     * Initializes clients, including echo cancellation setup, in the background so later
+     * connections skip that step. Call at level load, well before players reach characters.
+     * @param NumClients - Number of initialized clients to keep ready
+     */
+    UFUNCTION(BlueprintCallable, Category = "Convai|Connection")
+    void PrewarmClients(int32 NumClients);
+
+    /**
+     * Opens a warm connection to a character before any session needs it, e.g. when the player is
+     * predicted to approach. A matching ConnectSession then attaches without waiting for the handshake.
+     * Never evicts connections that have a session attached.
+     * @param CharacterID - The character to connect to
+     * @param Interface - The interface that will later connect, used for the connection settings
+     * @return True if a connection to the character is open or being opened
+     */
+    bool PrewarmCharacterConnection(const FString& CharacterID, IConvaiConnectionInterface* Interface);
+
+    /** Seconds the most recent session waited for its character connection */
+    UFUNCTION(BlueprintPure, Category = "Convai|Connection")
+    float GetLastTimeToConnected() const;
+
+    /** Average seconds sessions waited for their character connection */
+    UFUNCTION(BlueprintPure, Category = "Convai|Connection")
+    float GetAverageTimeToConnected() const;
+
+    const FConvaiConnectionMetrics& GetConnectionMetrics() const { return ConnectionMetrics; }
+    const FConvaiPacketDeliveryStats& GetPacketDeliveryStats() const { return PacketDeliveryStats; }
+    FConvaiClientPool::FStats GetClientPoolStats() const;
     
     void RegisterChatbotComponent(class UConvaiChatbotComponent* ChatbotComponent);
     void UnregisterChatbotComponent(class UConvaiChatbotComponent* ChatbotComponent);
@@ -110,17 +359,35 @@ public:
     void UnregisterPlayerComponent(class UConvaiPlayerComponent* PlayerComponent);
     TArray<class UConvaiPlayerComponent*> GetAllPlayerComponents() const;
 
-private:    
-    TUniquePtr<convai::ConvaiClient> ConvaiClient;
-    TUniquePtr<FConvaiConnectionThread> ConnectionThread;
-    TSharedPtr<FConvaiReferenceAudioThread> ReferenceAudioThread;
-    FThreadSafeBool bIsConnected;
-    FThreadSafeBool bStartedPublishingVideo;
-    mutable FCriticalSection ConvaiClientMutex;  // Protects ConvaiClient access from multiple threads
+private:
+    friend class FConvaiCharacterConnection;
+
+    // Character connections keyed by character ID, guarded by SessionMutex
+    TMap<FString, FConvaiCharacterConnectionPtr> CharacterConnections;
+
+    // Connection that receives the player's audio and user events, guarded by SessionMutex
+    TWeakPtr<FConvaiCharacterConnection, ESPMode::ThreadSafe> ActiveConnection;
+
     mutable FCriticalSection SessionMutex;  // Protects session state
-    
-    UPROPERTY()
-    UConvaiConnectionSessionProxy* CurrentCharacterSession;
+
+    // Concurrency cap and warm-connection lifetime, read from the plugin settings
+    int32 MaxCharacterConnections;
+    float WarmConnectionTimeout;
+
+    TSharedPtr<FConvaiClientPool, ESPMode::ThreadSafe> ClientPool;
+    FConvaiConnectionMetrics ConnectionMetrics;
+
+    // Work posted from the WebRTC threads, drained on the game thread by the core ticker
+    FConvaiGameThreadTaskQueue GameThreadTasks;
+    FConvaiTickerHandle GameThreadTasksTickerHandle;
+    bool ProcessGameThreadTasks(float DeltaTime);
+
+    // Delivers every connection's decoded packets, once per frame from ProcessGameThreadTasks
+    void DeliverDataPacketEvents();
+    void DispatchDataPacketEvent(FConvaiCharacterConnection& Connection, FConvaiDataPacketEvent& Event) const;
+    FConvaiPacketDeliveryStats PacketDeliveryStats;
+    TArray<FConvaiCharacterConnectionPtr> DeliveryConnections;
+    TArray<FConvaiDataPacketEvent> DeliveryEvents;
     
     UPROPERTY()
     UConvaiConnectionSessionProxy* CurrentPlayerSession;
@@ -131,34 +398,44 @@ private:
     UPROPERTY()
     TArray<class UConvaiPlayerComponent*> RegisteredPlayerComponents;
     
-// Client callbacks
-    virtual void OnConnectedToServer() override ;
-    virtual void OnDisconnectedFromServer() override;
-    virtual void OnAudioData(const char* attendee_id, const int16_t* audio_data, size_t num_frames,
-                             uint32_t sample_rate, uint32_t bits_per_sample, uint32_t num_channels) override;
-    virtual void OnAttendeeConnected(const char* attendee_id) override;
-    virtual void OnAttendeeDisconnected(const char* attendee_id) override;
-    virtual void OnActiveSpeakerChanged(const char* Speaker) override;
-    virtual void OnDataPacketReceived(const char *JsonData, const char *attendee_id) override;
-    virtual void OnLog(const char *log_message) override;
-    
+// Client callbacks, tagged with the connection they arrived on
+    void OnConnectedToServer(FConvaiCharacterConnection& Connection);
+    void OnDisconnectedFromServer(FConvaiCharacterConnection& Connection);
+    void OnAudioData(const FConvaiCharacterConnection& Connection, const char* attendee_id, const int16_t* audio_data, size_t num_frames,
+                     uint32_t sample_rate, uint32_t bits_per_sample, uint32_t num_channels) const;
+    void OnAttendeeConnected(FConvaiCharacterConnection& Connection, const char* attendee_id);
+    void OnAttendeeDisconnected(FConvaiCharacterConnection& Connection, const char* attendee_id);
+    void OnDataPacketReceived(FConvaiCharacterConnection& Connection, const char *JsonData, const char *attendee_id) const;
+
+    // Connection table (game thread)
+    FConvaiCharacterConnectionPtr FindConnectionForSession(const UConvaiConnectionSessionProxy* SessionProxy) const;
+    FConvaiCharacterConnectionPtr FindConnectionForClient(const convai::ConvaiClient* Client) const;
+    void SetActiveConnection(const FConvaiCharacterConnectionPtr& Connection);
+    FConvaiCharacterConnectionPtr CreateConnection(const FString& CharacterID, const FConvaiConnectionParams& ConnectionParams, UConvaiConnectionSessionProxy* SessionProxy);
+    bool EvictConnectionsOverCap(bool bEvictAttached);
+    void EvictExpiredWarmConnections();
+    void ReleaseConnection(const FConvaiCharacterConnectionPtr& Connection, bool bNotifySession);
+    void ReleaseAllConnections();
+    void UpdateReferenceAudioCapture();
+    void NotifyConnectionEstablished(const FConvaiCharacterConnection& Connection, bool bReplayAttendees);
+    bool IsActiveConnection(const FConvaiCharacterConnection& Connection) const;
 
-    bool InitializeConvaiClient();
-    void CleanupConvaiClient();
-    void SetupClientCallbacks();
+    // Resolve the sessions a connection's callbacks are routed to (any thread)
+    TScriptInterface<IConvaiConnectionInterface> GetCharacterInterface(const FConvaiCharacterConnection& Connection) const;
+    TScriptInterface<IConvaiConnectionInterface> GetPlayerInterface(const FConvaiCharacterConnection& Connection) const;
     
     // Helper functions
-    void OnUserStartedSpeaking(const char* attendee_id) const;
-    void OnUserStoppedSpeaking(const char* attendee_id) const;
-    void OnUserTranscript(const char* text, const char* attendee_id, bool final, const char* timestamp) const;
-    void OnBotLLMStopped(const char* attendee_id) const;
-    void OnBotStartedSpeaking(const char* attendee_id) const;
-    void OnBotStoppedSpeaking(const char* attendee_id) const;
-    void OnBotTranscript(const char* text, const char* attendee_id) const;
-    void OnNarrativeSectionReceived(const FString& BT_Code, const FString& BT_Constants, const FString& ReceivedNarrativeSectionID) const;
-    void OnEmotionReceived(const FString& ReceivedEmotionResponse, const FAnimationFrame& EmotionBlendshapesFrame, bool MultipleEmotions) const;
-    void OnFaceDataReceived(const FAnimationSequence& VisemeAnimationSequence) const;
-    void OnActionsReceived(TArray<FString>& Actions) const;
+    void OnUserStartedSpeaking(const FConvaiCharacterConnection& Connection, const char* attendee_id) const;
+    void OnUserStoppedSpeaking(const FConvaiCharacterConnection& Connection, const char* attendee_id) const;
+    void OnUserTranscript(const FConvaiCharacterConnection& Connection, const FString& Transcript, const char* attendee_id, bool final, const FString& Timestamp) const;
+    void OnBotLLMStopped(const FConvaiCharacterConnection& Connection, const char* attendee_id) const;
+    void OnBotStartedSpeaking(const FConvaiCharacterConnection& Connection, const char* attendee_id) const;
+    void OnBotStoppedSpeaking(const FConvaiCharacterConnection& Connection, const char* attendee_id) const;
+    void OnBotTranscript(const FConvaiCharacterConnection& Connection, const FString& Text, const char* attendee_id) const;
+    void OnNarrativeSectionReceived(const FConvaiCharacterConnection& Connection, const FString& BT_Code, const FString& BT_Constants, const FString& ReceivedNarrativeSectionID) const;
+    void OnEmotionReceived(const FConvaiCharacterConnection& Connection, const FString& ReceivedEmotionResponse, const FAnimationFrame& EmotionBlendshapesFrame, bool MultipleEmotions) const;
+    void OnFaceDataReceived(const FConvaiCharacterConnection& Connection, const FAnimationSequence& VisemeAnimationSequence) const;
+    void OnActionsReceived(const FConvaiCharacterConnection& Connection, TArray<FString>& Actions) const;
     void OnError(const FString& ErrorMessage) const;
 
 };
@@ -3,134 +3,1035 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "RingBuffer.h"
 #include "ConvaiDefinitions.h"
+#include "Templates/RefCounting.h"
+#include "Containers/LockFreeList.h"
+#include "Containers/Queue.h"
+#include <atomic>
+#include <type_traits>
 
 DECLARE_LOG_CATEGORY_EXTERN(ConvaiThreadSafeBuffersLog, Log, All);
 
 // ============================================================================
-// Thread-Safe Audio Ring Buffer
-// Thread-safe ring buffer for audio data (transport thread → game thread)
-// Data and format operations are thread-safe, duration is not (game thread only)
+// Lock-Free SPSC Ring Buffer
+// Fixed-capacity single-producer/single-consumer ring of trivially copyable elements.
+// Push belongs to the producer, everything else to the consumer. Cursors are
+// monotonically increasing element counts on separate cache lines so the two
+// sides never take a lock or share a line. Init is not thread-safe.
+// ============================================================================
+template<typename ElementType>
+class TConvaiSPSCRingBuffer
+{
+	static_assert(std::is_trivially_copyable<ElementType>::value, "TConvaiSPSCRingBuffer requires trivially copyable elements");
+
+public:
+	explicit TConvaiSPSCRingBuffer(uint32 InCapacity = 0)
+	{
+		Init(InCapacity);
+	}
+
+	// Allocates storage, rounding the capacity up to a power of two (NOT THREAD-SAFE)
+	inline void Init(uint32 InCapacity)
+	{
+		const uint32 NewCapacity = InCapacity > 0 ? FMath::RoundUpToPowerOfTwo(InCapacity) : 0;
+		Data.SetNumUninitialized(NewCapacity);
+		IndexMask = NewCapacity > 0 ? NewCapacity - 1 : 0;
+		WriteIndex.store(0, std::memory_order_relaxed);
+		ReadIndex.store(0, std::memory_order_relaxed);
+	}
+
+	inline uint32 GetCapacity() const
+	{
+		return static_cast<uint32>(Data.Num());
+	}
+
+	// Producer: all-or-nothing write, fails if it would exceed capacity (LOCK-FREE)
+	inline bool Push(const ElementType* InData, uint32 Count)
+	{
+		if (!InData || Count == 0)
+		{
+			return false;
+		}
+
+		const uint64 Write = WriteIndex.load(std::memory_order_relaxed);
+		if ((Write - ReadIndex.load(std::memory_order_acquire)) + Count > GetCapacity())
+		{
+			return false;
+		}
+
+		CopyIn(Write, InData, Count);
+		WriteIndex.store(Write + Count, std::memory_order_release);
+		return true;
+	}
+
+	// Producer: writes as many elements as fit, returns the number written (LOCK-FREE)
+	inline uint32 PushUpTo(const ElementType* InData, uint32 Count)
+	{
+		const uint64 Write = WriteIndex.load(std::memory_order_relaxed);
+		const uint32 Free = GetCapacity() - static_cast<uint32>(Write - ReadIndex.load(std::memory_order_acquire));
+		const uint32 ToWrite = InData ? FMath::Min(Count, Free) : 0;
+		if (ToWrite > 0)
+		{
+			CopyIn(Write, InData, ToWrite);
+			WriteIndex.store(Write + ToWrite, std::memory_order_release);
+		}
+		return ToWrite;
+	}
+
+	// Consumer: reads up to MaxCount elements (LOCK-FREE)
+	inline uint32 Pop(ElementType* OutData, uint32 MaxCount)
+	{
+		const uint32 Count = Peek(OutData, MaxCount);
+		ReadIndex.store(ReadIndex.load(std::memory_order_relaxed) + Count, std::memory_order_release);
+		return Count;
+	}
+
+	// Consumer: copies up to MaxCount elements without consuming them (LOCK-FREE)
+	inline uint32 Peek(ElementType* OutData, uint32 MaxCount) const
+	{
+		const uint64 Read = ReadIndex.load(std::memory_order_relaxed);
+		const uint32 Count = FMath::Min(MaxCount, static_cast<uint32>(WriteIndex.load(std::memory_order_acquire) - Read));
+		if (OutData && Count > 0)
+		{
+			CopyOut(Read, OutData, Count);
+		}
+		return Count;
+	}
+
+	// Consumer: drops up to Count elements, returns the number dropped (LOCK-FREE)
+	inline uint32 Discard(uint32 Count)
+	{
+		const uint64 Read = ReadIndex.load(std::memory_order_relaxed);
+		const uint32 ToDiscard = FMath::Min(Count, static_cast<uint32>(WriteIndex.load(std::memory_order_acquire) - Read));
+		ReadIndex.store(Read + ToDiscard, std::memory_order_release);
+		return ToDiscard;
+	}
+
+	inline uint32 Num() const
+	{
+		return static_cast<uint32>(WriteIndex.load(std::memory_order_acquire) - ReadIndex.load(std::memory_order_acquire));
+	}
+
+	inline bool IsEmpty() const
+	{
+		return Num() == 0;
+	}
+
+	// Consumer: drops everything written so far
+	inline void Reset()
+	{
+		ReadIndex.store(WriteIndex.load(std::memory_order_acquire), std::memory_order_release);
+	}
+
+	// Absolute cursors, for consumers that keep extra read positions of their own
+	inline uint64 GetReadPosition() const
+	{
+		return ReadIndex.load(std::memory_order_relaxed);
+	}
+
+	inline uint64 GetWritePosition() const
+	{
+		return WriteIndex.load(std::memory_order_acquire);
+	}
+
+	// Consumer: copies Count elements starting at an absolute position in [ReadPosition, WritePosition)
+	inline void CopyOut(uint64 Position, ElementType* OutData, uint32 Count) const
+	{
+		const uint32 Offset = static_cast<uint32>(Position) & IndexMask;
+		const uint32 FirstPart = FMath::Min(Count, GetCapacity() - Offset);
+		FMemory::Memcpy(OutData, Data.GetData() + Offset, FirstPart * sizeof(ElementType));
+		if (FirstPart < Count)
+		{
+			FMemory::Memcpy(OutData + FirstPart, Data.GetData(), (Count - FirstPart) * sizeof(ElementType));
+		}
+	}
+
+private:
+	inline void CopyIn(uint64 Position, const ElementType* InData, uint32 Count)
+	{
+		const uint32 Offset = static_cast<uint32>(Position) & IndexMask;
+		const uint32 FirstPart = FMath::Min(Count, GetCapacity() - Offset);
+		FMemory::Memcpy(Data.GetData() + Offset, InData, FirstPart * sizeof(ElementType));
+		if (FirstPart < Count)
+		{
+			FMemory::Memcpy(Data.GetData(), InData + FirstPart, (Count - FirstPart) * sizeof(ElementType));
+		}
+	}
+
+	TArray<ElementType> Data;
+	uint32 IndexMask = 0;
+
+	// Written by the producer only
+	alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64> WriteIndex{ 0 };
+
+	// Written by the consumer only
+	alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64> ReadIndex{ 0 };
+};
+
+// ============================================================================
+// Lock-Free Node-Pooled Queue
+// Unbounded linked-list queue for cross-thread messages that don't fit a
+// fixed-size ring (THREAD-SAFE per EQueueMode)
+// ============================================================================
+/**
+ * Template for queues.
+ *
+ * This template implements an unbounded non-intrusive queue using a lock-free linked
+ * list that stores copies of the queued items. The template can operate in two modes:
+ * Multiple-producers single-consumer (MPSC) and Single-producer single-consumer (SPSC).
+ *
+ * The queue is thread-safe in both modes. The Dequeue() method ensures thread-safety by
+ * writing it in a way that does not depend on possible instruction reordering on the CPU.
+ * The Enqueue() method uses an atomic compare-and-swap in multiple-producers scenarios.
+ *
+ * Nodes are recycled through a lock-free free list instead of going back to the global
+ * allocator. The pool can be pre-warmed so steady-state traffic never allocates, and
+ * GetStats() reports the queue's high-water mark so the pre-warm size can be tuned.
+ *
+ * @param T The type of items stored in the queue.
+ * @param Mode The queue mode (single-producer, single-consumer by default).
+ */
+template<typename T, EQueueMode Mode = EQueueMode::Spsc>
+class TConvaiQueue
+{
+public:
+	using FElementType = T;
+
+	/** Queue and node pool statistics, safe to read from any thread. */
+	struct FStats
+	{
+		/** Items currently in the queue. */
+		int32 NumQueued = 0;
+
+		/** Most items ever queued at once. */
+		int32 HighWaterMark = 0;
+
+		/** Free nodes ready for reuse. */
+		int32 NumPooledNodes = 0;
+
+		/** Nodes alive, whether queued, pooled or the list sentinel. */
+		int32 NumAllocatedNodes = 0;
+
+		/** Enqueues that had to allocate because the pool was empty. */
+		int32 NumPoolMisses = 0;
+	};
+
+	/**
+	 * Constructor.
+	 *
+	 * @param InPrewarmNodes Nodes allocated up front so the first enqueues don't hit the allocator.
+	 * @param InMaxPooledNodes Free nodes kept for reuse, extra nodes go back to the allocator (0 = unbounded).
+	 */
+	explicit TConvaiQueue(int32 InPrewarmNodes = 0, int32 InMaxPooledNodes = 1024)
+		: MaxPooledNodes(InMaxPooledNodes)
+	{
+		Head = Tail = new TNode();
+		NumAllocatedNodes.store(1, std::memory_order_relaxed);
+		Prewarm(InPrewarmNodes);
+	}
+
+	/** Destructor. */
+	~TConvaiQueue()
+	{
+		while (Tail != nullptr)
+		{
+			TNode* Node = Tail;
+			Tail = Tail->NextNode;
+
+			delete Node;
+		}
+
+		while (TNode* Node = FreeNodes.Pop())
+		{
+			delete Node;
+		}
+	}
+
+	/**
+	 * Allocates nodes into the pool ahead of time.
+	 *
+	 * @param NumNodes Number of nodes to add.
+	 * @note Thread-safe, but meant to be called before the queue sees traffic.
+	 */
+	void Prewarm(int32 NumNodes)
+	{
+		for (int32 Index = 0; Index < NumNodes; ++Index)
+		{
+			FreeNodes.Push(new TNode());
+		}
+
+		if (NumNodes > 0)
+		{
+			NumPooledNodes.fetch_add(NumNodes, std::memory_order_relaxed);
+			NumAllocatedNodes.fetch_add(NumNodes, std::memory_order_relaxed);
+		}
+	}
+
+	/**
+	 * Gets the number of items in the queue.
+	 *
+	 * @return Item count, exact on the consumer thread and approximate elsewhere.
+	 */
+	int32 Num() const
+	{
+		return NumQueued.load(std::memory_order_relaxed);
+	}
+
+	/** Gets a snapshot of the queue and node pool statistics. */
+	FStats GetStats() const
+	{
+		FStats Stats;
+		Stats.NumQueued = NumQueued.load(std::memory_order_relaxed);
+		Stats.HighWaterMark = HighWaterMark.load(std::memory_order_relaxed);
+		Stats.NumPooledNodes = NumPooledNodes.load(std::memory_order_relaxed);
+		Stats.NumAllocatedNodes = NumAllocatedNodes.load(std::memory_order_relaxed);
+		Stats.NumPoolMisses = NumPoolMisses.load(std::memory_order_relaxed);
+		return Stats;
+	}
+
+	/**
+	 * Removes and returns the item from the tail of the queue.
+	 *
+	 * @param OutValue Will hold the returned value.
+	 * @return true if a value was returned, false if the queue was empty.
+	 * @note To be called only from consumer thread.
+	 * @see Empty, Enqueue, IsEmpty, Peek, Pop
+	 */
+	bool Dequeue(FElementType& OutItem)
+	{
+		TNode* Popped = Tail->NextNode;
+
+		if (Popped == nullptr)
+		{
+			return false;
+		}
+
+		TSAN_AFTER(&Tail->NextNode);
+		OutItem = MoveTemp(Popped->Item);
+
+		TNode* OldTail = Tail;
+		Tail = Popped;
+		Tail->Item = FElementType();
+		ReleaseNode(OldTail);
+
+		return true;
+	}
+
+	/**
+	 * Empty the queue, discarding all items.
+	 *
+	 * @note To be called only from consumer thread.
+	 * @see Dequeue, IsEmpty, Peek, Pop
+	 */
+	void Empty()
+	{
+		while (Pop());
+	}
+
+	/**
+	 * Adds an item to the head of the queue.
+	 *
+	 * @param Item The item to add.
+	 * @return true if the item was added, false otherwise.
+	 * @note To be called only from producer thread(s).
+	 * @see Dequeue, Pop
+	 */
+	bool Enqueue(const FElementType& Item)
+	{
+		TNode* NewNode = AcquireNode();
+
+		if (NewNode == nullptr)
+		{
+			return false;
+		}
+
+		NewNode->Item = Item;
+		LinkNode(NewNode);
+
+		return true;
+	}
+
+	/**
+	 * Adds an item to the head of the queue.
+	 *
+	 * @param Item The item to add.
+	 * @return true if the item was added, false otherwise.
+	 * @note To be called only from producer thread(s).
+	 * @see Dequeue, Pop
+	 */
+	bool Enqueue(FElementType&& Item)
+	{
+		TNode* NewNode = AcquireNode();
+
+		if (NewNode == nullptr)
+		{
+			return false;
+		}
+
+		NewNode->Item = MoveTemp(Item);
+		LinkNode(NewNode);
+
+		return true;
+	}
+
+	/**
+	 * Checks whether the queue is empty.
+	 *
+	 * @return true if the queue is empty, false otherwise.
+	 * @note To be called only from consumer thread.
+	 * @see Dequeue, Empty, Peek, Pop
+	 */
+	bool IsEmpty() const
+	{
+		return (Tail->NextNode == nullptr);
+	}
+
+	/**
+	 * Peeks at the queue's tail item without removing it.
+	 *
+	 * @param OutItem Will hold the peeked at item.
+	 * @return true if an item was returned, false if the queue was empty.
+	 * @note To be called only from consumer thread.
+	 * @see Dequeue, Empty, IsEmpty, Pop
+	 */
+	bool Peek(FElementType& OutItem) const
+	{
+		if (Tail->NextNode == nullptr)
+		{
+			return false;
+		}
+
+		OutItem = Tail->NextNode->Item;
+
+		return true;
+	}
+
+	/**
+	 * Peek at the queue's tail item without removing it.
+	 *
+	 * This version of Peek allows peeking at a queue of items that do not allow
+	 * copying, such as TUniquePtr.
+	 *
+	 * @return Pointer to the item, or nullptr if queue is empty
+	 */
+	FElementType* Peek()
+	{
+		if (Tail->NextNode == nullptr)
+		{
+			return nullptr;
+		}
+
+		return &Tail->NextNode->Item;
+	}
+
+	/**
+	 * Peek at the queue's head item
+	 *
+	 *
+	 * @return Pointer to the item, or nullptr if queue is empty
+	 */
+	FElementType* PeekHead()
+	{
+		if (Tail->NextNode == nullptr)
+		{
+			return nullptr;
+		}
+
+		return &Head->Item;
+	}
+
+
+	FORCEINLINE const FElementType* Peek() const
+	{
+		return const_cast<TConvaiQueue*>(this)->Peek();
+	}
+
+	/**
+	 * Removes the item from the tail of the queue.
+	 *
+	 * @return true if a value was removed, false if the queue was empty.
+	 * @note To be called only from consumer thread.
+	 * @see Dequeue, Empty, Enqueue, IsEmpty, Peek
+	 */
+	bool Pop()
+	{
+		TNode* Popped = Tail->NextNode;
+
+		if (Popped == nullptr)
+		{
+			return false;
+		}
+
+		TSAN_AFTER(&Tail->NextNode);
+
+		TNode* OldTail = Tail;
+		Tail = Popped;
+		Tail->Item = FElementType();
+		ReleaseNode(OldTail);
+
+		return true;
+	}
+
+private:
+
+	/** Structure for the internal linked list. */
+	struct TNode
+	{
+		/** Holds a pointer to the next node in the list. */
+		TNode* volatile NextNode;
+
+		/** Holds the node's item. */
+		FElementType Item;
+
+		/** Default constructor. */
+		TNode()
+			: NextNode(nullptr)
+		{ }
+
+		/** Creates and initializes a new node. */
+		explicit TNode(const FElementType& InItem)
+			: NextNode(nullptr)
+			, Item(InItem)
+		{ }
+
+		/** Creates and initializes a new node. */
+		explicit TNode(FElementType&& InItem)
+			: NextNode(nullptr)
+			, Item(MoveTemp(InItem))
+		{ }
+	};
+
+	/** Takes a node from the pool, or allocates one if the pool is empty. */
+	TNode* AcquireNode()
+	{
+		TNode* Node = FreeNodes.Pop();
+
+		if (Node != nullptr)
+		{
+			NumPooledNodes.fetch_sub(1, std::memory_order_relaxed);
+			Node->NextNode = nullptr;
+			return Node;
+		}
+
+		NumPoolMisses.fetch_add(1, std::memory_order_relaxed);
+		NumAllocatedNodes.fetch_add(1, std::memory_order_relaxed);
+		return new TNode();
+	}
+
+	/** Publishes a filled node at the head of the list. */
+	void LinkNode(TNode* NewNode)
+	{
+		const int32 NewNumQueued = NumQueued.fetch_add(1, std::memory_order_relaxed) + 1;
+		int32 CurrentHighWaterMark = HighWaterMark.load(std::memory_order_relaxed);
+		while (NewNumQueued > CurrentHighWaterMark && !HighWaterMark.compare_exchange_weak(CurrentHighWaterMark, NewNumQueued, std::memory_order_relaxed))
+		{
+		}
+
+		TNode* OldHead;
+
+		if (Mode == EQueueMode::Mpsc)
+		{
+			OldHead = (TNode*)FPlatformAtomics::InterlockedExchangePtr((void**)&Head, NewNode);
+			TSAN_BEFORE(&OldHead->NextNode);
+			FPlatformAtomics::InterlockedExchangePtr((void**)&OldHead->NextNode, NewNode);
+		}
+		else
+		{
+			OldHead = Head;
+			Head = NewNode;
+			TSAN_BEFORE(&OldHead->NextNode);
+			FPlatformMisc::MemoryBarrier();
+			OldHead->NextNode = NewNode;
+		}
+	}
+
+	/** Returns a retired node to the pool, its item has already been reset. */
+	void ReleaseNode(TNode* Node)
+	{
+		NumQueued.fetch_sub(1, std::memory_order_relaxed);
+
+		if (MaxPooledNodes > 0 && NumPooledNodes.load(std::memory_order_relaxed) >= MaxPooledNodes)
+		{
+			NumAllocatedNodes.fetch_sub(1, std::memory_order_relaxed);
+			delete Node;
+			return;
+		}
+
+		Node->NextNode = nullptr;
+		NumPooledNodes.fetch_add(1, std::memory_order_relaxed);
+		FreeNodes.Push(Node);
+	}
+
+	/** Holds a pointer to the head of the list. */
+	MS_ALIGN(16) TNode* volatile Head GCC_ALIGN(16);
+
+	/** Holds a pointer to the tail of the list. */
+	TNode* Tail;
+
+	/** Retired nodes waiting to be reused. */
+	TLockFreePointerListUnordered<TNode, PLATFORM_CACHE_LINE_SIZE> FreeNodes;
+
+	/** Free nodes kept beyond this count go back to the allocator (0 = unbounded). */
+	int32 MaxPooledNodes;
+
+	/** Statistics, see FStats. */
+	std::atomic<int32> NumQueued{ 0 };
+	std::atomic<int32> HighWaterMark{ 0 };
+	std::atomic<int32> NumPooledNodes{ 0 };
+	std::atomic<int32> NumAllocatedNodes{ 0 };
+	std::atomic<int32> NumPoolMisses{ 0 };
+
+private:
+
+	/** Hidden copy constructor. */
+	TConvaiQueue(const TConvaiQueue&) = delete;
+
+	/** Hidden assignment operator. */
+	TConvaiQueue& operator=(const TConvaiQueue&) = delete;
+};
+
+
+// ============================================================================
+// Game Thread Task Queue
+// MPSC mailbox for work posted to the game thread by the transport, audio and
+// worker threads. Enqueue is thread-safe; ProcessAll runs on the game thread
+// from the owner's core ticker, so queued work never outlives the object draining it.
+// ============================================================================
+class FConvaiGameThreadTaskQueue
+{
+public:
+	explicit FConvaiGameThreadTaskQueue(int32 InPrewarmNodes = 32)
+		: Tasks(InPrewarmNodes)
+	{
+	}
+
+	// Queues a task for the next ProcessAll (THREAD-SAFE)
+	inline void Enqueue(TUniqueFunction<void()>&& Task)
+	{
+		Tasks.Enqueue(MoveTemp(Task));
+	}
+
+	// Runs the tasks queued before this call, returns the number run (game thread only)
+	// Tasks queued while draining wait for the next call so a task can't starve the frame.
+	inline int32 ProcessAll()
+	{
+		check(IsInGameThread());
+
+		const int32 NumToProcess = Tasks.Num();
+		int32 NumProcessed = 0;
+		TUniqueFunction<void()> Task;
+		while (NumProcessed < NumToProcess && Tasks.Dequeue(Task))
+		{
+			Task();
+			++NumProcessed;
+		}
+		return NumProcessed;
+	}
+
+	// Drops everything queued without running it (game thread only)
+	inline void Empty()
+	{
+		Tasks.Empty();
+	}
+
+	inline TConvaiQueue<TUniqueFunction<void()>, EQueueMode::Mpsc>::FStats GetStats() const
+	{
+		return Tasks.GetStats();
+	}
+
+private:
+	TConvaiQueue<TUniqueFunction<void()>, EQueueMode::Mpsc> Tasks;
+};
+
+// ============================================================================
+// Pooled Audio Block
+// One PCM buffer filled once by the transport callback and then shared by
+// reference between playback, lipsync and recording. The reference count is
+// intrusive so TRefCountPtr can hold it (THREAD-SAFE); when the last reference
+// goes away the block returns to FConvaiAudioBlockPool instead of the allocator.
+// Contents must not be modified once the block has been shared.
+// ============================================================================
+class CONVAI_API FConvaiAudioBlock
+{
+public:
+	inline uint8* GetData() const
+	{
+		return const_cast<uint8*>(Data.GetData());
+	}
+
+	inline uint32 Num() const
+	{
+		return NumBytes;
+	}
+
+	inline uint32 GetSampleRate() const
+	{
+		return SampleRate;
+	}
+
+	inline uint32 GetNumChannels() const
+	{
+		return NumChannels;
+	}
+
+	// TRefCountPtr interface
+	inline uint32 AddRef() const
+	{
+		return static_cast<uint32>(RefCount.fetch_add(1, std::memory_order_relaxed) + 1);
+	}
+
+	uint32 Release() const;
+
+	inline uint32 GetRefCount() const
+	{
+		return static_cast<uint32>(RefCount.load(std::memory_order_relaxed));
+	}
+
+private:
+	friend class FConvaiAudioBlockPool;
+
+	FConvaiAudioBlock() = default;
+	~FConvaiAudioBlock() = default;
+
+	// Grows but never shrinks while pooled, NumBytes is the valid prefix
+	TArray<uint8> Data;
+	uint32 NumBytes = 0;
+	uint32 SampleRate = 0;
+	uint32 NumChannels = 0;
+
+	mutable std::atomic<int32> RefCount{ 0 };
+};
+
+using FConvaiAudioBlockRef = TRefCountPtr<FConvaiAudioBlock>;
+
+// ============================================================================
+// Audio Block Pool
+// Process-wide free list of audio blocks (LOCK-FREE). Acquire may be called from
+// any thread; blocks come back through FConvaiAudioBlock::Release.
+// ============================================================================
+class CONVAI_API FConvaiAudioBlockPool
+{
+public:
+	static FConvaiAudioBlockPool& Get();
+
+	// Returns a block holding a copy of InData, reusing a pooled block when one is free
+	FConvaiAudioBlockRef Acquire(const uint8* InData, uint32 Size, uint32 InSampleRate, uint32 InNumChannels);
+
+	// Blocks parked in the free list
+	inline int32 GetNumFree() const
+	{
+		return NumFree.load(std::memory_order_relaxed);
+	}
+
+	// Blocks alive, pooled or in use
+	inline int32 GetNumAllocated() const
+	{
+		return NumAllocated.load(std::memory_order_relaxed);
+	}
+
+private:
+	friend class FConvaiAudioBlock;
+
+	FConvaiAudioBlockPool() = default;
+
+	void Return(FConvaiAudioBlock* Block);
+
+	// Free blocks beyond this count, or larger than this size, go back to the allocator
+	static constexpr int32 MaxFreeBlocks = 1024;
+	static constexpr int32 MaxPooledBlockBytes = 64 * 1024;
+
+	TLockFreePointerListUnordered<FConvaiAudioBlock, PLATFORM_CACHE_LINE_SIZE> FreeBlocks;
+	std::atomic<int32> NumFree{ 0 };
+	std::atomic<int32> NumAllocated{ 0 };
+};
+
+// ============================================================================
+// Lock-Free Audio Ring Buffer
+// SPSC ring of pooled audio blocks (transport thread → game thread)
+// Enqueue and SetFormat belong to the producer, everything else to the consumer.
+// The ring owns one reference per queued block, so nothing is copied after the
+// transport callback fills a block. A second consumer-side cursor (the lipsync
+// tap) trails the writer so each block can be handed to lipsync exactly once
+// without consuming it for playback.
+// The format is published as one atomic word so it never tears.
+// Duration is not thread-safe (game thread only)
 // ============================================================================
 struct FAudioRingBuffer
 {
-	static constexpr uint32 BufferCapacity = 1024 * 1024 * 4; // 4MB
+	static constexpr uint32 BlockCapacity = 8192; // ~80 seconds of 10ms frames
 
-	TRingBuffer<uint8> Data;
-	uint32 SampleRate;
-	uint32 NumChannels;
-	double DurationSeconds;
-	mutable FCriticalSection DataMutex;
+	FAudioRingBuffer() : Blocks(BlockCapacity), DurationSeconds(0.0) {}
 
-	FAudioRingBuffer() : Data(BufferCapacity), SampleRate(0), NumChannels(0), DurationSeconds(0.0) {}
+	~FAudioRingBuffer()
+	{
+		Reset();
+	}
 
 	// Format operations (THREAD-SAFE)
 	inline void SetFormat(uint32 InSampleRate, uint32 InNumChannels)
 	{
-		FScopeLock Lock(&DataMutex);
-		SampleRate = InSampleRate;
-		NumChannels = InNumChannels;
+		const uint64 NewFormat = PackFormat(InSampleRate, InNumChannels);
+		if (Format.load(std::memory_order_relaxed) != NewFormat)
+		{
+			Format.store(NewFormat, std::memory_order_release);
+		}
 	}
 
 	inline uint32 GetSampleRate() const
 	{
-		FScopeLock Lock(&DataMutex);
-		return SampleRate;
+		return static_cast<uint32>(Format.load(std::memory_order_acquire) >> 32);
 	}
 
 	inline uint32 GetNumChannels() const
 	{
-		FScopeLock Lock(&DataMutex);
-		return NumChannels;
+		return static_cast<uint32>(Format.load(std::memory_order_acquire) & 0xFFFFFFFFull);
 	}
 
 	inline void GetFormat(uint32& OutSampleRate, uint32& OutNumChannels) const
 	{
-		FScopeLock Lock(&DataMutex);
-		OutSampleRate = SampleRate;
-		OutNumChannels = NumChannels;
+		const uint64 CurrentFormat = Format.load(std::memory_order_acquire);
+		OutSampleRate = static_cast<uint32>(CurrentFormat >> 32);
+		OutNumChannels = static_cast<uint32>(CurrentFormat & 0xFFFFFFFFull);
 	}
 
 	// Duration (no thread safety - accessed from game thread only)
 	inline void SetTotalDuration(double Seconds)
 	{
-		FScopeLock Lock(&DataMutex);
 		DurationSeconds = Seconds;
 	}
 
 	inline void AppendToTotalDuration(double Seconds)
 	{
-		FScopeLock Lock(&DataMutex);
 		DurationSeconds += Seconds;
 	}
 
 	inline double GetTotalDuration() const
 	{
-		FScopeLock Lock(&DataMutex);
 		return DurationSeconds;
 	}
 
-	// Data operations (THREAD-SAFE)
+	// Producer: copies raw PCM into a pooled block and queues it (LOCK-FREE)
 	inline bool Enqueue(const uint8* AudioData, uint32 Size)
 	{
 		if (!AudioData || Size == 0)
 		{
 			return false;
 		}
+		return EnqueueBlock(FConvaiAudioBlockPool::Get().Acquire(AudioData, Size, GetSampleRate(), GetNumChannels()));
+	}
+
+	// Producer: queues a reference to an already filled block (LOCK-FREE)
+	inline bool EnqueueBlock(const FConvaiAudioBlockRef& Block)
+	{
+		FConvaiAudioBlock* RawBlock = Block.GetReference();
+		if (!RawBlock || RawBlock->Num() == 0)
+		{
+			return false;
+		}
 
-		FScopeLock Lock(&DataMutex);
-		if (Data.RingDataUsage() + Size > BufferCapacity)
+		// Count the bytes before publishing the block so the consumer never sees more dequeued than enqueued
+		BytesEnqueued.fetch_add(RawBlock->Num(), std::memory_order_relaxed);
+		RawBlock->AddRef();
+		if (!Blocks.Push(&RawBlock, 1))
 		{
+			RawBlock->Release();
+			BytesEnqueued.fetch_sub(RawBlock->Num(), std::memory_order_relaxed);
 			return false;
 		}
-		Data.Enqueue(AudioData, Size);
 		return true;
 	}
 
-	inline uint32 Dequeue(uint8* OutData, uint32 MaxSize)
+	// Consumer: takes over the ring's reference to the oldest block (LOCK-FREE)
+	inline bool DequeueBlock(FConvaiAudioBlockRef& OutBlock)
 	{
-		FScopeLock Lock(&DataMutex);
-		return Data.Dequeue(OutData, MaxSize);
+		FConvaiAudioBlock* RawBlock = nullptr;
+		if (Blocks.Pop(&RawBlock, 1) == 0)
+		{
+			return false;
+		}
+		BytesDequeued += RawBlock->Num();
+		OutBlock = FConvaiAudioBlockRef(RawBlock, false);
+		return true;
 	}
 
-	inline void AppendData(const uint8* AudioData, uint32 Size)
+	// Consumer: returns the next block the tap has not seen yet, or null (LOCK-FREE)
+	// Blocks already dequeued for playback are skipped.
+	inline FConvaiAudioBlockRef ReadTap()
 	{
-		Enqueue(AudioData, Size);
-	}
+		const uint64 Start = FMath::Max(TapIndex, Blocks.GetReadPosition());
+		if (Start >= Blocks.GetWritePosition())
+		{
+			TapIndex = Start;
+			return FConvaiAudioBlockRef();
+		}
 
-	inline uint32 GetData(uint8* OutBuffer, uint32 Size) const
-	{
-		FScopeLock Lock(&DataMutex);
-		return Data.Peek(OutBuffer, Size);
+		FConvaiAudioBlock* RawBlock = nullptr;
+		Blocks.CopyOut(Start, &RawBlock, 1);
+		TapIndex = Start + 1;
+		return FConvaiAudioBlockRef(RawBlock);
 	}
 
-	inline void RemoveData(uint32 BytesToRemove)
+	inline bool HasUntappedBlocks() const
 	{
-		FScopeLock Lock(&DataMutex);
-		Data.Dequeue(nullptr, FMath::Min(BytesToRemove, Data.RingDataUsage()));
+		return FMath::Max(TapIndex, Blocks.GetReadPosition()) < Blocks.GetWritePosition();
 	}
 
 	inline uint32 GetAvailableBytes() const
 	{
-		FScopeLock Lock(&DataMutex);
-		return Data.RingDataUsage();
+		return static_cast<uint32>(BytesEnqueued.load(std::memory_order_acquire) - BytesDequeued);
 	}
 
 	inline bool IsEmpty() const
 	{
-		FScopeLock Lock(&DataMutex);
-		return Data.RingDataUsage() == 0;
+		return Blocks.IsEmpty();
 	}
 
+	// Consumer: releases everything written so far
+	// The format is left alone, it belongs to the producer, which publishes it again before its next block.
 	inline void Reset()
 	{
-		FScopeLock Lock(&DataMutex);
-		Data.Empty();
-		SampleRate = 0;
-		NumChannels = 0;
+		FConvaiAudioBlockRef Discarded;
+		while (DequeueBlock(Discarded))
+		{
+		}
+		TapIndex = Blocks.GetReadPosition();
 		DurationSeconds = 0.0;
 	}
+
+private:
+	static inline uint64 PackFormat(uint32 InSampleRate, uint32 InNumChannels)
+	{
+		return (static_cast<uint64>(InSampleRate) << 32) | static_cast<uint64>(InNumChannels);
+	}
+
+	// Each entry holds one reference, released by DequeueBlock/Reset
+	TConvaiSPSCRingBuffer<FConvaiAudioBlock*> Blocks;
+
+	// Byte totals for buffering decisions, enqueued is written by the producer only
+	std::atomic<uint64> BytesEnqueued{ 0 };
+
+	// Consumer thread only
+	uint64 BytesDequeued = 0;
+	uint64 TapIndex = 0;
+
+	// SampleRate in the high 32 bits, NumChannels in the low 32 bits
+	alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64> Format{ 0 };
+
+	double DurationSeconds;
+};
+
+// ============================================================================
+// Adaptive Playout Delay
+// Sizes the audio buffered before playback starts from how late incoming blocks
+// actually arrive (transport thread → game thread). OnArrival belongs to the
+// producer; delay decisions (GetTargetDelay, OnPlaybackStarted, OnUnderrun)
+// belong to the consumer. Counters and estimates are readable from any thread.
+// ============================================================================
+struct FAudioJitterEstimator
+{
+	// Arrival gaps longer than this (beyond the previous block's duration) start a new talkspurt
+	static constexpr double TalkspurtGapSeconds = 0.25;
+
+	// Delay added per underrun, decayed again each time playback starts cleanly
+	static constexpr double UnderrunStepSeconds = 0.02;
+	static constexpr double UnderrunDecay = 0.75;
+
+	// Consumer: bounds for the playout delay (NOT THREAD-SAFE, call before streaming)
+	inline void Configure(double InMinDelaySeconds, double InMaxDelaySeconds)
+	{
+		MinDelaySeconds = FMath::Max(0.0, InMinDelaySeconds);
+		MaxDelaySeconds = FMath::Max(MinDelaySeconds, InMaxDelaySeconds);
+		TargetDelaySeconds.store(MinDelaySeconds, std::memory_order_relaxed);
+	}
+
+	// Producer: a block of MediaSeconds of audio arrived at ArrivalSeconds
+	inline void OnArrival(double ArrivalSeconds, double MediaSeconds)
+	{
+		const bool bNewTalkspurt = LastArrivalSeconds < 0.0 || ArrivalSeconds - LastArrivalSeconds > LastMediaSeconds + TalkspurtGapSeconds;
+		if (bNewTalkspurt)
+		{
+			// Silence between responses is not jitter, restart the media clock
+			MediaClockSeconds = 0.0;
+			BaseTransitSeconds = ArrivalSeconds;
+		}
+
+		// How much later than the best-case path this block showed up
+		const double TransitSeconds = ArrivalSeconds - MediaClockSeconds;
+		BaseTransitSeconds = FMath::Min(BaseTransitSeconds, TransitSeconds);
+		const double LatenessSeconds = TransitSeconds - BaseTransitSeconds;
+
+		// Fast attack, slow decay: follows the recent worst case without chasing every spike down
+		double Jitter = JitterSeconds.load(std::memory_order_relaxed);
+		Jitter += (LatenessSeconds - Jitter) / (LatenessSeconds > Jitter ? 4.0 : 64.0);
+		JitterSeconds.store(Jitter, std::memory_order_relaxed);
+
+		if (!bNewTalkspurt && LatenessSeconds > TargetDelaySeconds.load(std::memory_order_relaxed))
+		{
+			LatePacketCount.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		MediaClockSeconds += MediaSeconds;
+		LastMediaSeconds = MediaSeconds;
+		LastArrivalSeconds = ArrivalSeconds;
+	}
+
+	// Consumer: audio to buffer before starting playback
+	inline double GetTargetDelay()
+	{
+		const double Target = FMath::Clamp(MinDelaySeconds + JitterSeconds.load(std::memory_order_relaxed) + UnderrunBoostSeconds, MinDelaySeconds, MaxDelaySeconds);
+		TargetDelaySeconds.store(Target, std::memory_order_relaxed);
+		return Target;
+	}
+
+	// Consumer: playback started after buffering the target delay
+	inline void OnPlaybackStarted()
+	{
+		UnderrunBoostSeconds *= UnderrunDecay;
+	}
+
+	// Consumer: playback ran dry while more audio was still expected
+	inline void OnUnderrun()
+	{
+		UnderrunCount.fetch_add(1, std::memory_order_relaxed);
+		UnderrunBoostSeconds = FMath::Min(UnderrunBoostSeconds + UnderrunStepSeconds, MaxDelaySeconds);
+	}
+
+	inline double GetJitter() const
+	{
+		return JitterSeconds.load(std::memory_order_relaxed);
+	}
+
+	inline double GetLastTargetDelay() const
+	{
+		return TargetDelaySeconds.load(std::memory_order_relaxed);
+	}
+
+	inline uint32 GetUnderrunCount() const
+	{
+		return UnderrunCount.load(std::memory_order_relaxed);
+	}
+
+	inline uint32 GetLatePacketCount() const
+	{
+		return LatePacketCount.load(std::memory_order_relaxed);
+	}
+
+private:
+	// Producer thread only
+	double LastArrivalSeconds = -1.0;
+	double LastMediaSeconds = 0.0;
+	double MediaClockSeconds = 0.0;
+	double BaseTransitSeconds = 0.0;
+
+	// Consumer thread only
+	double MinDelaySeconds = 0.0;
+	double MaxDelaySeconds = 0.0;
+	double UnderrunBoostSeconds = 0.0;
+
+	std::atomic<double> JitterSeconds{ 0.0 };
+	std::atomic<double> TargetDelaySeconds{ 0.0 };
+	std::atomic<uint32> UnderrunCount{ 0 };
+	std::atomic<uint32> LatePacketCount{ 0 };
 };
 
 // ============================================================================
@@ -168,8 +1069,8 @@ struct FLipSyncBuffer
 	{
 		FScopeLock Lock(&SequenceMutex);
 
-		// Append all frames from the new sequence
-		Sequence.AnimationFrames.Append(InSequence.AnimationFrames);
+		// Append all frames from the new sequence, packed frames are copied as one block
+		Sequence.AppendFrames(InSequence);
 		Sequence.Duration += InSequence.Duration;
 
 		// Update frame rate if not set
@@ -195,6 +1096,7 @@ struct FLipSyncBuffer
 		OutSequence = MoveTemp(Sequence);
 
 		Sequence.AnimationFrames.Reset();
+		Sequence.PackedFrames = FConvaiPackedFrames();
 
 		// Only reserve if capacity dropped below threshold (rare after move)
 		if (Sequence.AnimationFrames.Max() < 1024)
@@ -219,6 +1121,7 @@ struct FLipSyncBuffer
 	{
 		FScopeLock Lock(&SequenceMutex);
 		Sequence.AnimationFrames.Reset();
+		Sequence.PackedFrames = FConvaiPackedFrames();
 		Sequence.Duration = 0.0f;
 		FrameRate = 0;
 		bHasNewData = false;
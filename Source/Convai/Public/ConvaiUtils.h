@@ -15,6 +15,9 @@ class USoundWave;
 class APlayerController;
 class UObject;
 class UConvaiSubsystem;
+class FAudioDevice;
+class ISubmixBufferListener;
+class USoundSubmix;
 struct FAnimationFrame;
 
 UCLASS()
@@ -48,6 +51,14 @@ public:
 
 	static double CalculateAudioDuration(uint32 AudioSize, uint8 Channels, uint32 SampleRate, uint8 SampleSize = 2);
 
+#if !(ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 4)
+	/**
+	 * Unregisters a submix buffer listener and blocks until the audio render thread can no longer call it (game thread).
+	 * Before 5.4 the device only keeps a raw pointer, the caller may release the listener once this returns.
+	 */
+	static void UnregisterSubmixBufferListener(FAudioDevice* AudioDevice, ISubmixBufferListener* Listener, USoundSubmix* Submix);
+#endif
+
 	UFUNCTION(BlueprintPure, BlueprintCallable, Category = "Convai|Utilities", meta = (WorldContext = "WorldContextObject", AutoCreateRefTerm = "IncludedCharacters, ExcludedCharacters"))
 	static void ConvaiGetLookedAtCharacter(UObject* WorldContextObject, APlayerController* PlayerController, float Radius, bool PlaneView, TArray<UObject*> IncludedCharacters, TArray<UObject*> ExcludedCharacters, UConvaiChatbotComponent*& ConvaiCharacter, bool& Found);
 	
@@ -35,4 +35,7 @@ public:
 	virtual bool GeneratesFacialDataAsBlendshapes() = 0;
 	virtual TMap<FName, float> ConvaiGetFaceBlendshapes() = 0;
 	virtual void ForceRecalculateStartTime() = 0;
+
+	/** Whether ConvaiApplyPrecomputedFacialAnimation accepts FAnimationSequence::PackedFrames, otherwise sequences are expanded to AnimationFrames first */
+	virtual bool SupportsPackedFaceData() { return false; }
 };
\ No newline at end of file
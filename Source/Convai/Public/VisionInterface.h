@@ -114,7 +114,8 @@ public:
 	 * Captures the current frame in raw format (uncompressed).
 	 * @param width The width of the captured image, populated by the function.
 	 * @param height The height of the captured image, populated by the function.
-	 * @param data An array to store the raw image data, populated by the function.
+	 * @param data An array to store the raw RGBA8 image data, populated by the function.
+	 *             Callers reuse it between frames, resize it without shrinking rather than reassigning it.
 	 * @return True if capture succeeded, false otherwise.
 	 */
 	virtual bool CaptureRaw(int& width, int& height, TArray<uint8>& data) = 0;
@@ -0,0 +1,228 @@
+// Copyright 2022 Convai Inc. All Rights Reserved.
+
+#include "ConvaiRenderTargetReadback.h"
+#include "ConvaiVisionBaseUtils.h"
+#include "Engine/TextureRenderTarget2D.h"
+#include "RenderingThread.h"
+#include "RHIGPUReadback.h"
+#include "TextureResource.h"
+
+FConvaiRenderTargetReadback::FConvaiRenderTargetReadback()
+{
+	for (int32 Index = 0; Index < NumStagingBuffers; ++Index)
+	{
+		StagingBuffers[Index].Readback = MakeUnique<FRHIGPUTextureReadback>(*FString::Printf(TEXT("ConvaiVisionReadback_%d"), Index));
+	}
+}
+
+FConvaiRenderTargetReadback::~FConvaiRenderTargetReadback() = default;
+
+bool FConvaiRenderTargetReadback::SupportsRenderTarget(const UTextureRenderTarget2D* RenderTarget)
+{
+	return RenderTarget && RenderTarget->GetFormat() == PF_B8G8R8A8;
+}
+
+bool FConvaiRenderTargetReadback::EnqueueCapture(UTextureRenderTarget2D* RenderTarget)
+{
+	check(IsInGameThread());
+
+	if (!SupportsRenderTarget(RenderTarget))
+	{
+		return false;
+	}
+
+	FTextureRenderTargetResource* RTResource = RenderTarget->GameThread_GetRenderTargetResource();
+	if (!RTResource)
+	{
+		return false;
+	}
+
+	const FIntPoint Size(RenderTarget->SizeX, RenderTarget->SizeY);
+	const double EnqueueTime = FPlatformTime::Seconds();
+	TSharedRef<FConvaiRenderTargetReadback, ESPMode::ThreadSafe> SharedThis = AsShared();
+	ENQUEUE_RENDER_COMMAND(ConvaiEnqueueVisionReadback)(
+		[SharedThis, RTResource, Size, EnqueueTime](FRHICommandListImmediate& RHICmdList)
+		{
+			// Harvest first so a buffer that just completed can take this copy
+			SharedThis->Harvest_RenderThread(RHICmdList);
+
+			FRHITexture* Texture = RTResource->GetRenderTargetTexture();
+			if (Texture)
+			{
+				SharedThis->Enqueue_RenderThread(RHICmdList, Texture, Size, EnqueueTime);
+			}
+		});
+
+	return true;
+}
+
+void FConvaiRenderTargetReadback::Enqueue_RenderThread(FRHICommandListImmediate& RHICmdList, FRHITexture* Texture, FIntPoint Size, double EnqueueTime)
+{
+	check(IsInRenderingThread());
+
+	if (NumInFlight == NumStagingBuffers)
+	{
+		// The GPU is more than NumStagingBuffers captures behind, skip rather than wait
+		FScopeLock Lock(&Mutex);
+		++Stats.FramesDropped;
+		return;
+	}
+
+	FStagingBuffer& Buffer = StagingBuffers[(FirstInFlight + NumInFlight) % NumStagingBuffers];
+	Buffer.Readback->EnqueueCopy(RHICmdList, Texture);
+	Buffer.Size = Size;
+	Buffer.EnqueueTime = EnqueueTime;
+	++NumInFlight;
+
+	FScopeLock Lock(&Mutex);
+	++Stats.FramesEnqueued;
+}
+
+void FConvaiRenderTargetReadback::Harvest_RenderThread(FRHICommandListImmediate& RHICmdList)
+{
+	check(IsInRenderingThread());
+
+	// Copies complete in order, only the newest completed one is worth publishing
+	int32 NewestReady = INDEX_NONE;
+	int32 NumReady = 0;
+	while (NumReady < NumInFlight && StagingBuffers[(FirstInFlight + NumReady) % NumStagingBuffers].Readback->IsReady())
+	{
+		NewestReady = (FirstInFlight + NumReady) % NumStagingBuffers;
+		++NumReady;
+	}
+
+	if (NewestReady == INDEX_NONE)
+	{
+		return;
+	}
+
+	FStagingBuffer& Buffer = StagingBuffers[NewestReady];
+	const int32 Width = Buffer.Size.X;
+	const int32 Height = Buffer.Size.Y;
+
+	int32 RowPitchInPixels = 0;
+#if ENGINE_MAJOR_VERSION == 4 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION < 1)
+	void* LockedData = nullptr;
+	Buffer.Readback->LockTexture(RHICmdList, LockedData, RowPitchInPixels);
+	const FColor* Src = static_cast<const FColor*>(LockedData);
+#else
+	const FColor* Src = static_cast<const FColor*>(Buffer.Readback->Lock(RowPitchInPixels));
+#endif
+
+	if (Src && RowPitchInPixels >= Width)
+	{
+		// Staging rows are padded to the RHI's pitch, pack them
+#if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 5
+		HarvestPixels.SetNumUninitialized(Width * Height, EAllowShrinking::No);
+#else
+		HarvestPixels.SetNumUninitialized(Width * Height, false);
+#endif
+		if (RowPitchInPixels == Width)
+		{
+			FMemory::Memcpy(HarvestPixels.GetData(), Src, Width * Height * sizeof(FColor));
+		}
+		else
+		{
+			for (int32 Row = 0; Row < Height; ++Row)
+			{
+				FMemory::Memcpy(HarvestPixels.GetData() + Row * Width, Src + Row * RowPitchInPixels, Width * sizeof(FColor));
+			}
+		}
+	}
+	Buffer.Readback->Unlock();
+
+	const double EnqueueTime = Buffer.EnqueueTime;
+	FirstInFlight = (FirstInFlight + NumReady) % NumStagingBuffers;
+	NumInFlight -= NumReady;
+
+	if (!Src || RowPitchInPixels < Width)
+	{
+		return;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	FScopeLock Lock(&Mutex);
+	Swap(HarvestPixels, PublishedPixels);
+	PublishedSize = FIntPoint(Width, Height);
+	bHasPublishedFrame = true;
+	bHasNewFrame = true;
+
+	++Stats.FramesHarvested;
+	Stats.LastLatencySeconds = Now - EnqueueTime;
+	Stats.TotalLatencySeconds += Stats.LastLatencySeconds;
+	if (Stats.FirstHarvestTime == 0.0)
+	{
+		Stats.FirstHarvestTime = Now;
+	}
+	Stats.LastHarvestTime = Now;
+}
+
+bool FConvaiRenderTargetReadback::GetLatestFrame(TArray<uint8>& OutData, int32& OutWidth, int32& OutHeight, bool bApplyGammaCorrection)
+{
+	{
+		FScopeLock Lock(&Mutex);
+		if (!bHasPublishedFrame)
+		{
+			return false;
+		}
+
+		// Take the published frame, the render thread reuses our old one for its next harvest
+		if (bHasNewFrame)
+		{
+			Swap(PublishedPixels, ConsumerPixels);
+			ConsumerSize = PublishedSize;
+			bHasNewFrame = false;
+		}
+	}
+
+	// Convert outside the lock so a harvest never waits on it
+	OutWidth = ConsumerSize.X;
+	OutHeight = ConsumerSize.Y;
+	UConvaiVisionBaseUtils::ConvertPixelsToRGBA(ConsumerPixels, OutData, bApplyGammaCorrection);
+	return true;
+}
+
+bool FConvaiRenderTargetReadback::HasNewFrame() const
+{
+	FScopeLock Lock(&Mutex);
+	return bHasNewFrame;
+}
+
+void FConvaiRenderTargetReadback::Reset()
+{
+	{
+		FScopeLock Lock(&Mutex);
+		bHasPublishedFrame = false;
+		bHasNewFrame = false;
+		Stats = FConvaiReadbackStats();
+	}
+	ConsumerPixels.Reset();
+	ConsumerSize = FIntPoint::ZeroValue;
+
+	TSharedRef<FConvaiRenderTargetReadback, ESPMode::ThreadSafe> SharedThis = AsShared();
+	ENQUEUE_RENDER_COMMAND(ConvaiResetVisionReadback)(
+		[SharedThis](FRHICommandListImmediate& RHICmdList)
+		{
+			SharedThis->Reset_RenderThread();
+		});
+}
+
+void FConvaiRenderTargetReadback::Reset_RenderThread()
+{
+	check(IsInRenderingThread());
+
+	// In-flight copies finish into buffers nobody reads, the next enqueue overwrites them
+	FirstInFlight = 0;
+	NumInFlight = 0;
+
+	FScopeLock Lock(&Mutex);
+	bHasPublishedFrame = false;
+	bHasNewFrame = false;
+	Stats = FConvaiReadbackStats();
+}
+
+FConvaiReadbackStats FConvaiRenderTargetReadback::GetStats() const
+{
+	FScopeLock Lock(&Mutex);
+	return Stats;
+}
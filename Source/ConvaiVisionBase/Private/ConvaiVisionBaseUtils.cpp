@@ -14,9 +14,64 @@
 #include "RenderTargetPool.h"
 #include "Engine/Texture2DDynamic.h"
 #include "EngineLogs.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
 
 DEFINE_LOG_CATEGORY(ConvaiVisionBaseUtilsLog);
 
+namespace
+{
+    // 2.2 gamma curve (linear to sRGB) used to brighten captures, one entry per channel value
+    struct FConvaiGammaLUT
+    {
+        uint8 Values[256];
+
+        FConvaiGammaLUT()
+        {
+            for (int32 Index = 0; Index < 256; ++Index)
+            {
+                Values[Index] = static_cast<uint8>(FMath::Clamp(FMath::RoundToInt(FMath::Pow(Index / 255.0f, 1.0f / 2.2f) * 255.0f), 0, 255));
+            }
+        }
+    };
+
+    const uint8* GetGammaLUT()
+    {
+        static const FConvaiGammaLUT LUT;
+        return LUT.Values;
+    }
+
+    // Frames above this many pixels are split across worker threads, 720p is ~14 chunks
+    constexpr int32 ConvertChunkPixels = 64 * 1024;
+
+    /**
+     * BGRA8 to RGBA8 on whole pixels: swapping bytes 0 and 2 of each little endian word is
+     * three masks and two shifts, which the compiler vectorizes. GammaLUT may be null.
+     */
+    void ConvertPixelRange(const FColor* Src, uint8* Dst, int32 NumPixels, const uint8* GammaLUT)
+    {
+        static_assert(sizeof(FColor) == sizeof(uint32), "FColor must be one packed BGRA word");
+        const uint32* Src32 = reinterpret_cast<const uint32*>(Src);
+        uint32* Dst32 = reinterpret_cast<uint32*>(Dst);
+
+        if (!GammaLUT)
+        {
+            for (int32 Index = 0; Index < NumPixels; ++Index)
+            {
+                const uint32 Pixel = Src32[Index];
+                Dst32[Index] = (Pixel & 0xFF00FF00u) | ((Pixel >> 16) & 0xFFu) | ((Pixel & 0xFFu) << 16);
+            }
+            return;
+        }
+
+        for (int32 Index = 0; Index < NumPixels; ++Index)
+        {
+            const FColor& C = Src[Index];
+            Dst32[Index] = uint32(GammaLUT[C.R]) | (uint32(GammaLUT[C.G]) << 8) | (uint32(GammaLUT[C.B]) << 16) | (uint32(C.A) << 24);
+        }
+    }
+}
+
 bool UConvaiVisionBaseUtils::ConvertCompressedDataToTexture2D(const TArray<uint8>& CompressedData, UTexture2D*& Texture)
 {
     // Cache the ImageWrapperModule to avoid loading it every time
@@ -186,6 +241,13 @@ bool UConvaiVisionBaseUtils::GetRawImageData(UTexture2D* CapturedImage, TArray<u
 
 bool UConvaiVisionBaseUtils::GetRawImageDataFromRenderTarget(UTextureRenderTarget2D* RenderTarget,
     TArray<uint8>& OutData, int32& OutWidth, int32& OutHeight, bool bApplyGammaCorrection)
+{
+    TArray<FColor> Bitmap;
+    return GetRawImageDataFromRenderTarget(RenderTarget, OutData, OutWidth, OutHeight, Bitmap, bApplyGammaCorrection);
+}
+
+bool UConvaiVisionBaseUtils::GetRawImageDataFromRenderTarget(UTextureRenderTarget2D* RenderTarget,
+    TArray<uint8>& OutData, int32& OutWidth, int32& OutHeight, TArray<FColor>& ScratchPixels, bool bApplyGammaCorrection)
 {
     if (!RenderTarget)
     {
@@ -203,56 +265,53 @@ bool UConvaiVisionBaseUtils::GetRawImageDataFromRenderTarget(UTextureRenderTarge
     OutWidth = RenderTarget->SizeX;
     OutHeight = RenderTarget->SizeY;
 
-    TArray<FColor> Bitmap;   // Will store BGRA8 colors
+    // Will store BGRA8 colors
     FReadSurfaceDataFlags ReadFlags(RCM_UNorm, CubeFace_MAX);
     ReadFlags.SetLinearToGamma(false); // Keep raw values
-    if (!RTResource->ReadPixels(Bitmap, ReadFlags))
+    if (!RTResource->ReadPixels(ScratchPixels, ReadFlags))
     {
         UE_LOG(LogTemp, Error, TEXT("Failed to read pixels from render target"));
         return false;
     }
 
-    if (Bitmap.Num() != OutWidth * OutHeight)
+    if (ScratchPixels.Num() != OutWidth * OutHeight)
     {
         UE_LOG(LogTemp, Error, TEXT("Unexpected pixel count from render target"));
         return false;
     }
 
-    // If gamma correction is requested, manually brighten by applying power curve
-    if (bApplyGammaCorrection)
-    {
-        for (FColor& Pixel : Bitmap)
-        {
-            // Convert each channel to 0-1 range, apply gamma, convert back
-            float R = Pixel.R / 255.0f;
-            float G = Pixel.G / 255.0f;
-            float B = Pixel.B / 255.0f;
-
-            // Apply gamma 2.2 curve to brighten (linear to sRGB)
-            R = FMath::Pow(R, 1.0f / 2.2f);
-            G = FMath::Pow(G, 1.0f / 2.2f);
-            B = FMath::Pow(B, 1.0f / 2.2f);
-
-            // Convert back to 0-255 range
-            Pixel.R = FMath::Clamp(FMath::RoundToInt(R * 255.0f), 0, 255);
-            Pixel.G = FMath::Clamp(FMath::RoundToInt(G * 255.0f), 0, 255);
-            Pixel.B = FMath::Clamp(FMath::RoundToInt(B * 255.0f), 0, 255);
-        }
-    }
+    ConvertPixelsToRGBA(ScratchPixels, OutData, bApplyGammaCorrection);
+    return true;
+}
+
+void UConvaiVisionBaseUtils::ConvertPixelsToRGBA(const TArray<FColor>& Pixels, TArray<uint8>& OutData, bool bApplyGammaCorrection)
+{
+    const int32 NumPixels = Pixels.Num();
+
+    // Keep the caller's allocation when it is reused frame to frame
+#if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 5
+    OutData.SetNumUninitialized(NumPixels * 4, EAllowShrinking::No);
+#else
+    OutData.SetNumUninitialized(NumPixels * 4, false);
+#endif
+
+    const FColor* Src = Pixels.GetData();
+    uint8* Dst = OutData.GetData();
+    const uint8* GammaLUT = bApplyGammaCorrection ? GetGammaLUT() : nullptr;
 
-    // Convert FColor(BGRA) to RGBA byte array
-    OutData.SetNumUninitialized(OutWidth * OutHeight * 4);
-    uint8* Dest = OutData.GetData();
-    for (int32 i = 0; i < Bitmap.Num(); i++)
+    const int32 NumChunks = FMath::DivideAndRoundUp(NumPixels, ConvertChunkPixels);
+    if (NumChunks <= 1)
     {
-        const FColor& C = Bitmap[i];
-        *Dest++ = C.R;
-        *Dest++ = C.G;
-        *Dest++ = C.B;
-        *Dest++ = C.A;
+        ConvertPixelRange(Src, Dst, NumPixels, GammaLUT);
+        return;
     }
 
-    return true;
+    ParallelFor(NumChunks, [Src, Dst, NumPixels, GammaLUT](int32 ChunkIndex)
+    {
+        const int32 First = ChunkIndex * ConvertChunkPixels;
+        const int32 Count = FMath::Min(ConvertChunkPixels, NumPixels - First);
+        ConvertPixelRange(Src + First, Dst + First * 4, Count, GammaLUT);
+    });
 }
 
 bool UConvaiVisionBaseUtils::TextureRenderTarget2DToBytes(UTextureRenderTarget2D* TextureRenderTarget2D, const EImageFormat ImageFormat, TArray<uint8>& ByteArray, const int32 CompressionQuality, bool bApplyGammaCorrection)
@@ -284,25 +343,15 @@ bool UConvaiVisionBaseUtils::TextureRenderTarget2DToBytes(UTextureRenderTarget2D
         return false;
     }
 
-    // If gamma correction is requested, manually brighten by applying power curve
+    // If gamma correction is requested, manually brighten through the gamma curve table
     if (bApplyGammaCorrection)
     {
+        const uint8* GammaLUT = GetGammaLUT();
         for (FColor& Pixel : Pixels)
         {
-            // Convert each channel to 0-1 range, apply gamma, convert back
-            float R = Pixel.R / 255.0f;
-            float G = Pixel.G / 255.0f;
-            float B = Pixel.B / 255.0f;
-
-            // Apply gamma 2.2 curve to brighten (linear to sRGB)
-            R = FMath::Pow(R, 1.0f / 2.2f);
-            G = FMath::Pow(G, 1.0f / 2.2f);
-            B = FMath::Pow(B, 1.0f / 2.2f);
-
-            // Convert back to 0-255 range
-            Pixel.R = FMath::Clamp(FMath::RoundToInt(R * 255.0f), 0, 255);
-            Pixel.G = FMath::Clamp(FMath::RoundToInt(G * 255.0f), 0, 255);
-            Pixel.B = FMath::Clamp(FMath::RoundToInt(B * 255.0f), 0, 255);
+            Pixel.R = GammaLUT[Pixel.R];
+            Pixel.G = GammaLUT[Pixel.G];
+            Pixel.B = GammaLUT[Pixel.B];
             Pixel.A = 255;
         }
     }
@@ -383,3 +432,71 @@ bool UConvaiVisionBaseUtils::PixelsToBytes(const int32 Width, const int32 Height
 
     return true;
 }
+
+#if !UE_BUILD_SHIPPING
+static FAutoConsoleCommand ConvaiBenchmarkVisionConversionCommand(
+    TEXT("Convai.Vision.BenchmarkConversion"),
+    TEXT("Compares per-pixel pow gamma plus byte swizzle with the table kernel on a synthetic frame. Usage: Convai.Vision.BenchmarkConversion [Width] [Height] [Iterations]"),
+    FConsoleCommandWithArgsDelegate::CreateStatic([](const TArray<FString>& Args)
+    {
+        const int32 Width = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 1280;
+        const int32 Height = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 720;
+        const int32 Iterations = Args.Num() > 2 ? FCString::Atoi(*Args[2]) : 20;
+        if (Width <= 0 || Height <= 0 || Iterations <= 0)
+        {
+            return;
+        }
+
+        TArray<FColor> Pixels;
+        Pixels.SetNumUninitialized(Width * Height);
+        for (int32 Index = 0; Index < Pixels.Num(); ++Index)
+        {
+            Pixels[Index] = FColor(static_cast<uint8>(Index * 7), static_cast<uint8>(Index * 13), static_cast<uint8>(Index * 29), 255);
+        }
+
+        // Gamma through three FMath::Pow calls per pixel and a byte-wise swizzle, as frames were converted before the table
+        TArray<uint8> Data;
+        uint32 Checksum = 0;
+        const double PowStart = FPlatformTime::Seconds();
+        for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+        {
+            TArray<FColor> Bitmap = Pixels;
+            for (FColor& Pixel : Bitmap)
+            {
+                Pixel.R = FMath::Clamp(FMath::RoundToInt(FMath::Pow(Pixel.R / 255.0f, 1.0f / 2.2f) * 255.0f), 0, 255);
+                Pixel.G = FMath::Clamp(FMath::RoundToInt(FMath::Pow(Pixel.G / 255.0f, 1.0f / 2.2f) * 255.0f), 0, 255);
+                Pixel.B = FMath::Clamp(FMath::RoundToInt(FMath::Pow(Pixel.B / 255.0f, 1.0f / 2.2f) * 255.0f), 0, 255);
+            }
+            Data.SetNumUninitialized(Bitmap.Num() * 4);
+            uint8* Dest = Data.GetData();
+            for (const FColor& C : Bitmap)
+            {
+                *Dest++ = C.R;
+                *Dest++ = C.G;
+                *Dest++ = C.B;
+                *Dest++ = C.A;
+            }
+            Checksum += Data[Iteration % Data.Num()];
+        }
+        const double PowSeconds = FPlatformTime::Seconds() - PowStart;
+
+        const double TableStart = FPlatformTime::Seconds();
+        for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+        {
+            UConvaiVisionBaseUtils::ConvertPixelsToRGBA(Pixels, Data, true);
+            Checksum += Data[Iteration % Data.Num()];
+        }
+        const double TableSeconds = FPlatformTime::Seconds() - TableStart;
+
+        const double SwizzleStart = FPlatformTime::Seconds();
+        for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+        {
+            UConvaiVisionBaseUtils::ConvertPixelsToRGBA(Pixels, Data, false);
+            Checksum += Data[Iteration % Data.Num()];
+        }
+        const double SwizzleSeconds = FPlatformTime::Seconds() - SwizzleStart;
+
+        UE_LOG(ConvaiVisionBaseUtilsLog, Display, TEXT("Conversion benchmark, %dx%d: pow gamma %.3f ms/frame, table gamma %.3f ms/frame, swizzle only %.3f ms/frame (checksum %u)"),
+            Width, Height, PowSeconds * 1e3 / Iterations, TableSeconds * 1e3 / Iterations, SwizzleSeconds * 1e3 / Iterations, Checksum);
+    }));
+#endif
@@ -8,6 +8,10 @@
 #include "EngineUtils.h"               
 #include "Engine/PostProcessVolume.h"   
 #include "Engine/World.h" 
+#include "HAL/IConsoleManager.h"
+#include "Kismet/KismetRenderingLibrary.h"
+#include "Engine/Canvas.h"
+#include "UObject/UObjectIterator.h"
 
 UEnvironmentWebcam::UEnvironmentWebcam(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
@@ -27,12 +31,92 @@ void UEnvironmentWebcam::TickComponent(float DeltaTime, ELevelTick TickType, FAc
 {
     Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
-    if (GetState() == EVisionState::Capturing && OnFrameReady.IsBound())
+    if (GetState() == EVisionState::Capturing)
     {
-        OnFrameReady.Broadcast();        
+        if (bAsyncReadback)
+        {
+            EnqueueReadback(DeltaTime);
+        }
+
+        if (OnFrameReady.IsBound())
+        {
+            OnFrameReady.Broadcast();
+        }
     } 
 }
 
+void UEnvironmentWebcam::EnqueueReadback(float DeltaTime)
+{
+    if (!Readback.IsValid())
+    {
+        return;
+    }
+
+    // Copy at the advertised FPS, the consumer never needs frames faster than that
+    TimeSinceReadback += DeltaTime;
+    const float ReadbackInterval = m_MaxFPS > 0 ? 1.0f / m_MaxFPS : 0.0f;
+    if (TimeSinceReadback < ReadbackInterval)
+    {
+        return;
+    }
+    TimeSinceReadback = 0.0f;
+
+    Readback->EnqueueCapture(UpdateCaptureTarget());
+}
+
+void UEnvironmentWebcam::PrepareScaledRenderTarget()
+{
+    const bool bScale = CaptureResolution.X > 0 && CaptureResolution.Y > 0
+        && (CaptureResolution.X != ConvaiRenderTarget->SizeX || CaptureResolution.Y != ConvaiRenderTarget->SizeY);
+    if (!bScale)
+    {
+        ScaledRenderTarget = nullptr;
+        return;
+    }
+
+    if (!ScaledRenderTarget)
+    {
+        ScaledRenderTarget = NewObject<UTextureRenderTarget2D>(this);
+    }
+
+    // Always RGBA8 so the scaled frame can use the async readback whatever the source format is
+    if (ScaledRenderTarget->SizeX != CaptureResolution.X || ScaledRenderTarget->SizeY != CaptureResolution.Y
+        || ScaledRenderTarget->bForceLinearGamma != ConvaiRenderTarget->bForceLinearGamma)
+    {
+        ScaledRenderTarget->ClearColor = FLinearColor::Black;
+        ScaledRenderTarget->InitCustomFormat(CaptureResolution.X, CaptureResolution.Y, PF_B8G8R8A8, ConvaiRenderTarget->bForceLinearGamma);
+    }
+
+    UE_LOG(ConvaiWebcamLog, Log, TEXT("UEnvironmentWebcam::Start - Scaling %dx%d captures to %dx%d"),
+        ConvaiRenderTarget->SizeX, ConvaiRenderTarget->SizeY, CaptureResolution.X, CaptureResolution.Y);
+}
+
+UTextureRenderTarget2D* UEnvironmentWebcam::UpdateCaptureTarget()
+{
+    if (!ScaledRenderTarget)
+    {
+        return ConvaiRenderTarget;
+    }
+
+    // Bilinear draw on the GPU, only the scaled frame is read back
+    UCanvas* Canvas = nullptr;
+    FVector2D CanvasSize;
+    FDrawToRenderTargetContext Context;
+    UKismetRenderingLibrary::BeginDrawCanvasToRenderTarget(this, ScaledRenderTarget, Canvas, CanvasSize, Context);
+    if (Canvas)
+    {
+        Canvas->K2_DrawTexture(ConvaiRenderTarget, FVector2D::ZeroVector, CanvasSize, FVector2D::ZeroVector, FVector2D::UnitVector, FLinearColor::White, BLEND_Opaque);
+    }
+    UKismetRenderingLibrary::EndDrawCanvasToRenderTarget(this, Context);
+
+    return ScaledRenderTarget;
+}
+
+UTextureRenderTarget2D* UEnvironmentWebcam::GetCaptureTarget() const
+{
+    return ScaledRenderTarget ? ScaledRenderTarget : ConvaiRenderTarget;
+}
+
 void UEnvironmentWebcam::BeginPlay()
 {
     Super::BeginPlay();
@@ -56,6 +140,23 @@ void UEnvironmentWebcam::Start()
 
     CaptureComponent->bCaptureEveryFrame = true;
 
+    PrepareScaledRenderTarget();
+
+    if (bAsyncReadback)
+    {
+        if (!FConvaiRenderTargetReadback::SupportsRenderTarget(GetCaptureTarget()))
+        {
+            UE_LOG(ConvaiWebcamLog, Warning, TEXT("UEnvironmentWebcam::Start - Async readback needs an RTF RGBA8 render target, falling back to ReadPixels"));
+        }
+        else if (!Readback.IsValid())
+        {
+            Readback = MakeShared<FConvaiRenderTargetReadback, ESPMode::ThreadSafe>();
+        }
+
+        // Copy on the first tick
+        TimeSinceReadback = TNumericLimits<float>::Max();
+    }
+
     OnFirstFrameCaptured.ExecuteIfBound();
 }
 
@@ -71,21 +172,34 @@ void UEnvironmentWebcam::Stop()
         CaptureComponent->bCaptureEveryFrame = false;
         OnFramesStopped.ExecuteIfBound();
     }
+
+    if (Readback.IsValid())
+    {
+        Readback->Reset();
+    }
 }
 
 bool UEnvironmentWebcam::CaptureCompressed(int& width, int& height, TArray<uint8>& data, float ForceCompressionRatio)
 {
-    width = ConvaiRenderTarget->SizeX;
-    height = ConvaiRenderTarget->SizeY;
+    UTextureRenderTarget2D* CaptureTarget = UpdateCaptureTarget();
+    width = CaptureTarget->SizeX;
+    height = CaptureTarget->SizeY;
     // Apply gamma correction to brighten the image for web display
-    return UConvaiVisionBaseUtils::TextureRenderTarget2DToBytes(ConvaiRenderTarget, EImageFormat::JPEG, data, ForceCompressionRatio, true);
+    return UConvaiVisionBaseUtils::TextureRenderTarget2DToBytes(CaptureTarget, EImageFormat::JPEG, data, ForceCompressionRatio, true);
 }
 
 bool UEnvironmentWebcam::CaptureRaw(int& width, int& height, TArray<uint8>& data)
 {
-    width = ConvaiRenderTarget->SizeX;
-    height = ConvaiRenderTarget->SizeY;
-    return UConvaiVisionBaseUtils::GetRawImageDataFromRenderTarget(ConvaiRenderTarget, data, width, height);
+    if (bAsyncReadback && Readback.IsValid() && FConvaiRenderTargetReadback::SupportsRenderTarget(GetCaptureTarget()))
+    {
+        // Never waits on the GPU, fails until the first copy lands a couple of frames after Start
+        return Readback->GetLatestFrame(data, width, height);
+    }
+
+    UTextureRenderTarget2D* CaptureTarget = UpdateCaptureTarget();
+    width = CaptureTarget->SizeX;
+    height = CaptureTarget->SizeY;
+    return UConvaiVisionBaseUtils::GetRawImageDataFromRenderTarget(CaptureTarget, data, width, height, ReadPixelsScratch);
 }
 
 UTexture* UEnvironmentWebcam::GetImageTexture(ETextureSourceType& TextureSourceType)
@@ -94,6 +208,11 @@ UTexture* UEnvironmentWebcam::GetImageTexture(ETextureSourceType& TextureSourceT
     return ConvaiRenderTarget;
 }
 
+FConvaiReadbackStats UEnvironmentWebcam::GetReadbackStats() const
+{
+    return Readback.IsValid() ? Readback->GetStats() : FConvaiReadbackStats();
+}
+
 bool UEnvironmentWebcam::CanStart()
 {
     if (!Super::CanStart())
@@ -153,4 +272,63 @@ void UEnvironmentWebcam::CopyPostProcessPropertiesFromVolume()
     CaptureComponent->PostProcessSettings = PostProcessVolume->Settings;
 
     UE_LOG(LogTemp, Log, TEXT("UEnvironmentWebcam::CopyPostProcessPropertiesFromVolume - Successfully copied post-process properties from PostProcessVolume"));
-}
\ No newline at end of file
+}
+
+#if !UE_BUILD_SHIPPING
+static FAutoConsoleCommand ConvaiBenchmarkVisionReadbackCommand(
+    TEXT("Convai.Vision.BenchmarkReadback"),
+    TEXT("Compares ReadPixels with the async readback on every capturing environment webcam. Usage: Convai.Vision.BenchmarkReadback [Iterations]"),
+    FConsoleCommandWithArgsDelegate::CreateStatic([](const TArray<FString>& Args)
+    {
+        const int32 Iterations = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 30;
+        if (Iterations <= 0)
+        {
+            return;
+        }
+
+        for (TObjectIterator<UEnvironmentWebcam> It; It; ++It)
+        {
+            UEnvironmentWebcam* Webcam = *It;
+            UTextureRenderTarget2D* RenderTarget = Webcam->GetCaptureTarget();
+            if (Webcam->IsTemplate() || Webcam->GetState() != EVisionState::Capturing || !RenderTarget)
+            {
+                continue;
+            }
+
+            TArray<uint8> Data;
+            TArray<FColor> Pixels;
+            int32 Width = 0;
+            int32 Height = 0;
+
+            // Flushes the render thread and waits on the GPU every call, as CaptureRaw did before the async readback
+            const double SyncStart = FPlatformTime::Seconds();
+            for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+            {
+                UConvaiVisionBaseUtils::GetRawImageDataFromRenderTarget(RenderTarget, Data, Width, Height, Pixels);
+            }
+            const double SyncSeconds = (FPlatformTime::Seconds() - SyncStart) / Iterations;
+
+            UE_LOG(ConvaiWebcamLog, Display, TEXT("Readback benchmark, %s %dx%d: ReadPixels %.3f ms/frame on the game thread (%.1f fps max)"),
+                *Webcam->GetName(), RenderTarget->SizeX, RenderTarget->SizeY, SyncSeconds * 1e3, SyncSeconds > 0.0 ? 1.0 / SyncSeconds : 0.0);
+
+            int32 AsyncFrames = 0;
+            const double AsyncStart = FPlatformTime::Seconds();
+            for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+            {
+                AsyncFrames += Webcam->CaptureRaw(Width, Height, Data) ? 1 : 0;
+            }
+            const double AsyncSeconds = (FPlatformTime::Seconds() - AsyncStart) / Iterations;
+
+            const FConvaiReadbackStats Stats = Webcam->GetReadbackStats();
+            if (AsyncFrames == 0 || Stats.FramesHarvested == 0)
+            {
+                UE_LOG(ConvaiWebcamLog, Display, TEXT("Readback benchmark, %s: no async frames yet, check bAsyncReadback and the render target format"), *Webcam->GetName());
+                continue;
+            }
+
+            UE_LOG(ConvaiWebcamLog, Display, TEXT("Readback benchmark, %s: async %.3f ms/frame on the game thread, GPU to CPU latency %.2f ms (last %.2f ms), %d frames harvested at %.1f fps, %d dropped"),
+                *Webcam->GetName(), AsyncSeconds * 1e3, Stats.GetAverageLatencySeconds() * 1e3, Stats.LastLatencySeconds * 1e3,
+                Stats.FramesHarvested, Stats.GetHarvestedFPS(), Stats.FramesDropped);
+        }
+    }));
+#endif
@@ -0,0 +1,111 @@
+// Copyright 2022 Convai Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "Templates/UniquePtr.h"
+
+class FRHIGPUTextureReadback;
+class FRHICommandListImmediate;
+class FRHITexture;
+class UTextureRenderTarget2D;
+
+/** Counters for an FConvaiRenderTargetReadback, reset by Reset() */
+struct CONVAIVISIONBASE_API FConvaiReadbackStats
+{
+	// Copies queued on the GPU
+	int32 FramesEnqueued = 0;
+
+	// Copies that landed in CPU memory and were published, older copies completing alongside are skipped
+	int32 FramesHarvested = 0;
+
+	// Captures skipped because every staging buffer was still in flight
+	int32 FramesDropped = 0;
+
+	// Time from queuing a copy to publishing its pixels
+	double LastLatencySeconds = 0.0;
+	double TotalLatencySeconds = 0.0;
+
+	// Span between the first and the last harvested frame
+	double FirstHarvestTime = 0.0;
+	double LastHarvestTime = 0.0;
+
+	double GetAverageLatencySeconds() const { return FramesHarvested > 0 ? TotalLatencySeconds / FramesHarvested : 0.0; }
+	double GetHarvestedFPS() const { return FramesHarvested > 1 && LastHarvestTime > FirstHarvestTime ? (FramesHarvested - 1) / (LastHarvestTime - FirstHarvestTime) : 0.0; }
+};
+
+/**
+ * Reads a render target back to the CPU without stalling the game thread.
+ *
+ * EnqueueCapture queues a GPU copy of the render target into one of NumStagingBuffers
+ * staging textures. Later render commands poll the copies in order and publish the
+ * newest completed one, so a frame arrives a couple of frames after it was rendered
+ * instead of ReadPixels flushing the render thread and waiting on the GPU.
+ * GetLatestFrame hands the newest published frame to the game thread.
+ *
+ * Only PF_B8G8R8A8 render targets are supported, see SupportsRenderTarget.
+ */
+class CONVAIVISIONBASE_API FConvaiRenderTargetReadback : public TSharedFromThis<FConvaiRenderTargetReadback, ESPMode::ThreadSafe>
+{
+public:
+	static constexpr int32 NumStagingBuffers = 3;
+
+	FConvaiRenderTargetReadback();
+	~FConvaiRenderTargetReadback();
+
+	static bool SupportsRenderTarget(const UTextureRenderTarget2D* RenderTarget);
+
+	/**
+	 * Queues a copy of the render target's current contents (game thread).
+	 * Completed copies are harvested by this and later calls, keep calling it while capturing.
+	 * @return False if the render target is unsupported or has no resource yet
+	 */
+	bool EnqueueCapture(UTextureRenderTarget2D* RenderTarget);
+
+	/**
+	 * Converts the newest harvested frame to RGBA8 (game thread), never waits on the GPU.
+	 * The same frame is returned again until a newer one is harvested.
+	 * @return False if no frame has been harvested since the last Reset
+	 */
+	bool GetLatestFrame(TArray<uint8>& OutData, int32& OutWidth, int32& OutHeight, bool bApplyGammaCorrection = true);
+
+	/** True once a frame newer than the one last returned by GetLatestFrame has been harvested */
+	bool HasNewFrame() const;
+
+	/** Drops in-flight copies and published frames, and clears the stats */
+	void Reset();
+
+	FConvaiReadbackStats GetStats() const;
+
+private:
+	struct FStagingBuffer
+	{
+		TUniquePtr<FRHIGPUTextureReadback> Readback;
+		FIntPoint Size = FIntPoint::ZeroValue;
+		double EnqueueTime = 0.0;
+	};
+
+	// Render thread only
+	void Harvest_RenderThread(FRHICommandListImmediate& RHICmdList);
+	void Enqueue_RenderThread(FRHICommandListImmediate& RHICmdList, FRHITexture* Texture, FIntPoint Size, double EnqueueTime);
+	void Reset_RenderThread();
+
+	// Render thread only, a ring of staging buffers with NumInFlight copies starting at FirstInFlight
+	FStagingBuffer StagingBuffers[NumStagingBuffers];
+	int32 FirstInFlight = 0;
+	int32 NumInFlight = 0;
+	TArray<FColor> HarvestPixels;
+
+	// Render thread -> game thread, swapped under Mutex
+	mutable FCriticalSection Mutex;
+	TArray<FColor> PublishedPixels;
+	FIntPoint PublishedSize = FIntPoint::ZeroValue;
+	bool bHasPublishedFrame = false;
+	bool bHasNewFrame = false;
+	FConvaiReadbackStats Stats;
+
+	// Game thread only
+	TArray<FColor> ConsumerPixels;
+	FIntPoint ConsumerSize = FIntPoint::ZeroValue;
+};
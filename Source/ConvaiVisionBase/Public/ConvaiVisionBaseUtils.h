@@ -25,6 +25,13 @@ public:
 
 	static bool GetRawImageDataFromRenderTarget(UTextureRenderTarget2D* RenderTarget, TArray<uint8>& OutData, int32& OutWidth, int32& OutHeight, bool bApplyGammaCorrection = true);
 
+	// As above, reading back into the caller's ScratchPixels so a capture reused every frame keeps its allocation
+	static bool GetRawImageDataFromRenderTarget(UTextureRenderTarget2D* RenderTarget, TArray<uint8>& OutData, int32& OutWidth, int32& OutHeight, TArray<FColor>& ScratchPixels, bool bApplyGammaCorrection = true);
+
+	// Converts BGRA8 pixels read back from a render target to RGBA8 bytes in one pass, optionally brightened with a 2.2 gamma table.
+	// OutData keeps its allocation, large frames are split across worker threads.
+	static void ConvertPixelsToRGBA(const TArray<FColor>& Pixels, TArray<uint8>& OutData, bool bApplyGammaCorrection = true);
+
 	static bool TextureRenderTarget2DToBytes(UTextureRenderTarget2D* TextureRenderTarget2D, const EImageFormat ImageFormat, TArray<uint8>& ByteArray, const int32 CompressionQuality = 0, bool bApplyGammaCorrection = true);
 
 	static bool PixelsToBytes(const int32 Width, const int32 Height, const TArray<FColor>& Pixels, const EImageFormat ImageFormat, TArray<uint8>& ByteArray, const int32 CompressionQuality = 0);
@@ -84,6 +84,13 @@ public:
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, category = "Convai|Vision")
 	bool bUpdateOnFetch;
+
+	/**
+	 * Resolution frames are scaled to before they are read back and sent, (0, 0) keeps the source resolution.
+	 * Implementations that can, scale on the GPU. Applied on Start.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, category = "Convai|Vision")
+	FIntPoint CaptureResolution = FIntPoint::ZeroValue;
 	//-----------END Variables-----------
 
 protected:
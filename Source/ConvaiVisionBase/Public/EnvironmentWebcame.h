@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "ConvaiWebcamBase.h"
+#include "ConvaiRenderTargetReadback.h"
 
 #include "EnvironmentWebcame.generated.h"
 
@@ -29,6 +30,12 @@ public:
 	virtual UTexture* GetImageTexture(ETextureSourceType& TextureSourceType) override;
 	// VisionInterface functions END
 
+	/** Latency and throughput of the async readback since the last Start */
+	FConvaiReadbackStats GetReadbackStats() const;
+
+	/** Render target frames are read from, ConvaiRenderTarget scaled to CaptureResolution when that is set */
+	UTextureRenderTarget2D* GetCaptureTarget() const;
+
 protected:
 	// WebcamBase functions start
 	virtual bool CanStart() override;
@@ -46,5 +53,28 @@ protected:
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Convai|Vision")
 	bool bAutoStartVision = false;
+
+	/**
+	 * Reads the render target back through GPU staging buffers instead of ReadPixels, so CaptureRaw never stalls the game thread.
+	 * Frames arrive a couple of frames late. Render targets other than RTF RGBA8 always use ReadPixels.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Convai|Vision")
+	bool bAsyncReadback = true;
+
 	void CopyPostProcessPropertiesFromVolume();
+
+private:
+	void EnqueueReadback(float DeltaTime);
+	void PrepareScaledRenderTarget();
+	UTextureRenderTarget2D* UpdateCaptureTarget();
+
+	// ConvaiRenderTarget downscaled on the GPU, only set while CaptureResolution differs from it
+	UPROPERTY(Transient)
+	UTextureRenderTarget2D* ScaledRenderTarget = nullptr;
+
+	TSharedPtr<FConvaiRenderTargetReadback, ESPMode::ThreadSafe> Readback;
+	float TimeSinceReadback = 0.0f;
+
+	// ReadPixels target of the synchronous CaptureRaw path, kept between captures
+	TArray<FColor> ReadPixelsScratch;
 };